@@ -436,11 +436,7 @@ function setMqttPill(el, enabled, connected) {
 async function ls() {
   try {
     var r = await (await fetch('/api/storage')).json();
-    document.getElementById('sU').textContent = fmt(r.used);
-    document.getElementById('sT').textContent = fmt(r.total);
-    var p = r.total ? ((r.used / r.total) * 100).toFixed(1) : '0';
-    document.getElementById('sP').textContent = p;
-    document.getElementById('sF').style.width  = p + '%';
+    applyStorage(r.used, r.total);
   } catch (e) { /* ignore */ }
 }
 
@@ -519,12 +515,43 @@ async function uf1(file) {
   return { ok: r.ok, name: file.name, error: d.error || 'Upload failed' };
 }
 
-// Upload multiple files sequentially
+// Batch path: pack the files into a store-only ZIP client-side and stream
+// it in one POST -- per-file HTTP overhead dominates sequential uploads.
+async function ufBatch(files) {
+  var zip = new JSZip();
+  for (var i = 0; i < files.length; i++) zip.file(files[i].name, files[i]);
+  var blob = await zip.generateAsync({ type: 'blob', compression: 'STORE' });
+  var r = await fetch('/api/upload_batch', { method: 'POST', body: blob });
+  return { ok: r.ok, d: await r.json() };
+}
+
+// Upload multiple files (one ZIP POST when possible, sequential fallback)
 async function uf(files) {
   var m = document.getElementById('msg');
   m.className = 'msg';
   m.style.display = 'none';
 
+  if (files.length > 1 && typeof JSZip !== 'undefined') {
+    m.className   = 'msg ok';
+    m.textContent = 'Uploading ' + files.length + ' files...';
+    m.style.display = 'block';
+    try {
+      var b = await ufBatch(files);
+      if (b.ok) {
+        m.textContent = 'Uploaded ' + b.d.files + ' file' + (b.d.files > 1 ? 's' : '') +
+          (b.d.skipped ? ' (' + b.d.skipped + ' skipped)' : '') + '.';
+      } else {
+        m.className   = 'msg error';
+        m.textContent = b.d.error || 'Batch upload failed';
+      }
+      lf();
+      ls();
+      return;
+    } catch (e) {
+      // fall through to sequential uploads
+    }
+  }
+
   var ok = 0, fail = 0, errs = [];
 
   for (var i = 0; i < files.length; i++) {
@@ -955,25 +982,66 @@ document.getElementById('btnBackupAll').addEventListener('click', backupAllQgif)
 // Track currently playing file and sync highlighting
 var _currentFile = '';
 
-// Poll current playing file every 3 seconds
+function applyCurrent(name) {
+  if (name === _currentFile) return;
+  _currentFile = name;
+  // Update file list highlighting
+  document.querySelectorAll('.file-name').forEach(function (el) {
+    if (el.textContent === _currentFile) {
+      el.classList.add('playing');
+    } else {
+      el.classList.remove('playing');
+    }
+  });
+  // Trigger preview update
+  if (typeof startPreview === 'function') startPreview(_currentFile);
+}
+
+function applyStorage(used, total) {
+  document.getElementById('sU').textContent = fmt(used);
+  document.getElementById('sT').textContent = fmt(total);
+  var p = total ? ((used / total) * 100).toFixed(1) : '0';
+  document.getElementById('sP').textContent = p;
+  document.getElementById('sF').style.width  = p + '%';
+}
+
+// One-shot fetch of the current file (initial paint + WS-down fallback)
 function pollCurrent() {
   fetch('/api/current').then(function (r) { return r.json(); }).then(function (d) {
-    if (d.name !== _currentFile) {
-      _currentFile = d.name;
-      // Update file list highlighting
-      document.querySelectorAll('.file-name').forEach(function (el) {
-        if (el.textContent === _currentFile) {
-          el.classList.add('playing');
-        } else {
-          el.classList.remove('playing');
-        }
-      });
-      // Trigger preview update
-      if (typeof startPreview === 'function') startPreview(_currentFile);
-    }
+    applyCurrent(d.name);
   }).catch(function () {});
 }
-setInterval(pollCurrent, 3000);
+
+// Push channel: the device broadcasts {name, total, used, free} on /ws_state
+// whenever playback or storage changes, so there is no steady-state polling.
+// While the socket is down we fall back to a slow poll and keep reconnecting.
+var _stateWsPollTimer = null;
+function connectStateWs() {
+  var ws;
+  try {
+    ws = new WebSocket((location.protocol === 'https:' ? 'wss://' : 'ws://') + location.host + '/ws_state');
+  } catch (e) {
+    scheduleStateWsRetry();
+    return;
+  }
+  ws.onopen = function () {
+    if (_stateWsPollTimer) { clearInterval(_stateWsPollTimer); _stateWsPollTimer = null; }
+  };
+  ws.onmessage = function (ev) {
+    try {
+      var d = JSON.parse(ev.data);
+      if (typeof d.name === 'string') applyCurrent(d.name);
+      if (typeof d.used === 'number' && typeof d.total === 'number') applyStorage(d.used, d.total);
+    } catch (e) { /* ignore */ }
+  };
+  ws.onclose = scheduleStateWsRetry;
+  ws.onerror = function () { ws.close(); };
+}
+function scheduleStateWsRetry() {
+  if (!_stateWsPollTimer) _stateWsPollTimer = setInterval(pollCurrent, 5000);
+  setTimeout(connectStateWs, 5000);
+}
+connectStateWs();
 
 // Card collapse toggle -- click card-title to expand/collapse (only collapsible cards)
 (function () {
@@ -1030,6 +1098,7 @@ pollCurrent();
   var _paused    = false;
   var _starting  = false;
   var _timerId   = null;
+  var _lastSent  = null;   // previous packed frame, for delta encoding
 
   // Mode + parameters (live-tunable)
   var MODES = [
@@ -1212,10 +1281,44 @@ pollCurrent();
     else if (mode === 'noise') frame = packNoise();
     else frame = packThresholdFromLuma();
     renderPreview(frame);
-    _ws.send(frame.buffer);
+    var payload = encodeDelta(frame);
+    _lastSent = frame;
+    if (payload) _ws.send(payload.buffer);
     _timerId = setTimeout(sendFrame, FRAME_INTERVAL_MS);
   }
 
+  // Delta wire format: [0x01][8-byte dirty mask over 64 16-byte blocks][dirty
+  // blocks in order].  Returns the full frame when there is no previous frame
+  // or nearly everything changed, and null when nothing changed (skip send).
+  var DELTA_BLOCK = 16;
+  var DELTA_BLOCKS = (W * H >> 3) / DELTA_BLOCK;  // 64
+
+  function encodeDelta(frame) {
+    if (!_lastSent) return frame;
+    var mask = new Uint8Array(DELTA_BLOCKS >> 3);
+    var dirty = [];
+    for (var b = 0; b < DELTA_BLOCKS; b++) {
+      var off = b * DELTA_BLOCK;
+      for (var k = 0; k < DELTA_BLOCK; k++) {
+        if (frame[off + k] !== _lastSent[off + k]) {
+          mask[b >> 3] |= (1 << (7 - (b & 7)));
+          dirty.push(off);
+          break;
+        }
+      }
+    }
+    if (dirty.length === 0) return null;
+    // Near-full frames: the delta overhead is not worth it
+    if (dirty.length > DELTA_BLOCKS - 4) return frame;
+    var out = new Uint8Array(1 + mask.length + dirty.length * DELTA_BLOCK);
+    out[0] = 0x01;
+    out.set(mask, 1);
+    for (var d = 0; d < dirty.length; d++) {
+      out.set(frame.subarray(dirty[d], dirty[d] + DELTA_BLOCK), 1 + mask.length + d * DELTA_BLOCK);
+    }
+    return out;
+  }
+
   function setControlsEnabled(on) {
     btnModePrev.disabled = !on;
     btnModeNext.disabled = !on;
@@ -1250,6 +1353,7 @@ pollCurrent();
     _running  = false;
     _paused   = false;
     if (_timerId)  { clearTimeout(_timerId); _timerId = null; }
+    _lastSent = null;
     if (_ws)       { _ws.close(); _ws = null; }
     if (_stream)   { _stream.getTracks().forEach(function (t) { t.stop(); }); _stream = null; }
     _video = null;
@@ -1297,6 +1401,7 @@ pollCurrent();
       _running = true;
       _paused = false;
       _starting = false;
+      _lastSent = null;   // first message must be a full frame
 
       // Enable mode + params once streaming starts
       setControlsEnabled(true);
@@ -35,4 +35,32 @@ typedef struct {
 #define QGIF_FRAME_HEIGHT  64
 #define QGIF_FRAME_SIZE    ((QGIF_FRAME_WIDTH / 8) * QGIF_FRAME_HEIGHT)  // 1024
 
+// ---------------------------------------------------------------------------
+// .qgif v2 (compressed) format constants
+// ---------------------------------------------------------------------------
+// Layout:
+//   [0..1]    magic 'Q','2'  (unambiguous: in a valid v1 file byte 1 is the
+//                             width low byte, always 0x80)
+//   [2]       uint8_t   frame_count
+//   [3..4]    uint16_t  width   (LE)
+//   [5..6]    uint16_t  height  (LE)
+//   [..]      uint16_t  delays[frame_count]  (LE)
+//   then per frame:
+//   [0]       uint8_t   flags  (QGIF2_FLAG_*)
+//   [1..2]    uint16_t  payload_len  (LE)
+//   [3..]     payload
+//
+// The payload decodes to QGIF_FRAME_SIZE bytes.  With QGIF2_FLAG_DELTA the
+// decoded bytes are XORed onto the previous frame instead of replacing it;
+// frame 0 is always a keyframe.  QGIF2_FLAG_RAW marks an uncompressed
+// payload (used when RLE would expand).  RLE scheme (PackBits-like):
+//   control c in 0x00..0x7F : copy the next c+1 bytes literally
+//   control c in 0x80..0xFF : repeat the next byte (c & 0x7F) + 2 times
+#define QGIF2_MAGIC0         'Q'
+#define QGIF2_MAGIC1         '2'
+#define QGIF2_HEADER_SIZE    7
+#define QGIF2_FRAME_HDR_SIZE 3
+#define QGIF2_FLAG_DELTA     0x01
+#define QGIF2_FLAG_RAW       0x02
+
 #endif // GIF_TYPES_H
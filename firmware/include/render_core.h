@@ -0,0 +1,182 @@
+#ifndef RENDER_CORE_H
+#define RENDER_CORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "gif_types.h"
+
+// ---------------------------------------------------------------------------
+// Pure render core -- no Arduino / U8G2 / FreeRTOS dependencies
+// ---------------------------------------------------------------------------
+// The hot pixel-pushing inner loops shared by gif_player (frame transpose,
+// v2 RLE decode) and display_helpers (180 deg rotate).  Kept header-only
+// and dependency-free so the native test environment (pio test -e native)
+// can build and benchmark them on a developer machine; the firmware
+// wrappers add the U8G2 buffer lookup, settings reads and flush calls.
+//
+// On the firmware build these loops (and the bit-reverse table) are placed
+// in IRAM/DRAM: LittleFS writes and NVS commits disable the flash cache,
+// and the first render after each write window otherwise pays a burst of
+// cache-refill misses right through its inner loops.  RAM residence keeps
+// the frame cadence steady while the dashboard streams an upload.  On the
+// native build the attributes expand to nothing.
+
+#ifndef RENDER_CORE_RAM
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+#include "esp_attr.h"
+#define RENDER_CORE_RAM    IRAM_ATTR
+#define RENDER_CORE_RODATA DRAM_ATTR
+#else
+#define RENDER_CORE_RAM
+#define RENDER_CORE_RODATA
+#endif
+#endif
+
+// ---------------------------------------------------------------------------
+// Frame transpose -- qgif row layout to SSD1306 page layout
+// ---------------------------------------------------------------------------
+// qgif frames are row-major, MSB-first (byte = y*16 + x/8, bit 7-(x&7));
+// the SSD1306 buffer is page-major (byte = (y/8)*128 + x, bit y&7).  The
+// conversion is an 8x8 bit transpose per tile, done straight into the page
+// buffer with polarity inversion ('inv' = 0xFF for normal polarity, 0x00
+// for negative) and the 180 deg flip folded into the same pass.  'frame'
+// is left untouched and may be reused across frames.
+static inline RENDER_CORE_RAM void renderCoreFrameToPages(
+    const uint8_t *frame, uint8_t *pageBuf, uint8_t inv, bool flip) {
+  for (uint8_t page = 0; page < 8; page++) {
+    const uint8_t *row = frame + (uint16_t)page * 8 * 16;
+    for (uint8_t gx = 0; gx < 16; gx++) {
+      // Gather the 8x8 tile: one row byte from each of the 8 scanlines
+      uint8_t s0 = row[gx]       ^ inv;
+      uint8_t s1 = row[gx + 16]  ^ inv;
+      uint8_t s2 = row[gx + 32]  ^ inv;
+      uint8_t s3 = row[gx + 48]  ^ inv;
+      uint8_t s4 = row[gx + 64]  ^ inv;
+      uint8_t s5 = row[gx + 80]  ^ inv;
+      uint8_t s6 = row[gx + 96]  ^ inv;
+      uint8_t s7 = row[gx + 112] ^ inv;
+      uint16_t base = (uint16_t)page * 128 + (uint16_t)gx * 8;
+      for (uint8_t j = 0; j < 8; j++) {
+        const uint8_t m = (uint8_t)(0x80 >> j);
+        uint8_t out = 0;
+        if (s0 & m) out |= 0x01;
+        if (s1 & m) out |= 0x02;
+        if (s2 & m) out |= 0x04;
+        if (s3 & m) out |= 0x08;
+        if (s4 & m) out |= 0x10;
+        if (s5 & m) out |= 0x20;
+        if (s6 & m) out |= 0x40;
+        if (s7 & m) out |= 0x80;
+        if (flip) {
+          // 180 deg: mirrored byte position, reversed bit order
+          out = (uint8_t)(((out & 0xF0) >> 4) | ((out & 0x0F) << 4));
+          out = (uint8_t)(((out & 0xCC) >> 2) | ((out & 0x33) << 2));
+          out = (uint8_t)(((out & 0xAA) >> 1) | ((out & 0x55) << 1));
+          pageBuf[(QGIF_FRAME_SIZE - 1) - (base + j)] = out;
+        } else {
+          pageBuf[base + j] = out;
+        }
+      }
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 180 deg rotate of a page-packed buffer
+// ---------------------------------------------------------------------------
+// buf'[i] = bitrev(buf[len-1-i]): pages swap top-for-bottom, columns
+// mirror, bits within a byte reverse.  Done word-wise over mirrored 4-byte
+// pairs with a 256-entry bit-reverse table; reversing the table-substituted
+// bytes' order within the word handles the column mirror for free.
+
+// kRenderBitrev[b] = b with its bit order reversed
+#define R2(n) n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define R4(n) R2(n), R2(n + 2 * 16), R2(n + 1 * 16), R2(n + 3 * 16)
+#define R6(n) R4(n), R4(n + 2 * 4), R4(n + 1 * 4), R4(n + 3 * 4)
+static RENDER_CORE_RODATA const uint8_t kRenderBitrev[256] = { R6(0), R6(2), R6(1), R6(3) };
+#undef R2
+#undef R4
+#undef R6
+
+// Bit-reverse each byte and swap byte order (mirrors 32 columns at once)
+static inline RENDER_CORE_RAM uint32_t renderCoreBitrevWord(uint32_t w) {
+  return ((uint32_t)kRenderBitrev[w & 0xFF] << 24) |
+         ((uint32_t)kRenderBitrev[(w >> 8) & 0xFF] << 16) |
+         ((uint32_t)kRenderBitrev[(w >> 16) & 0xFF] << 8) |
+         (uint32_t)kRenderBitrev[w >> 24];
+}
+
+static inline RENDER_CORE_RAM void renderCoreRotate180(uint8_t *buf, uint16_t len) {
+  if (((uintptr_t)buf & 3) == 0 && (len & 7) == 0) {
+    uint32_t *head = (uint32_t *)buf;
+    uint32_t *tail = (uint32_t *)(buf + len) - 1;
+    while (head < tail) {
+      uint32_t a = renderCoreBitrevWord(*head);
+      uint32_t b = renderCoreBitrevWord(*tail);
+      *head++ = b;
+      *tail-- = a;
+    }
+    return;
+  }
+
+  // Unaligned buffer (shouldn't happen): byte-wise fallback
+  for (uint16_t i = 0; i < len / 2; i++) {
+    uint8_t a        = kRenderBitrev[buf[i]];
+    buf[i]           = kRenderBitrev[buf[len - 1 - i]];
+    buf[len - 1 - i] = a;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// .qgif v2 RLE payload decode (incremental)
+// ---------------------------------------------------------------------------
+// PackBits-like state machine (scheme documented in gif_types.h), written
+// as a chunk consumer so the firmware can stream payloads from flash
+// through a small buffer while the host harness feeds whole payloads.
+// With 'delta' the decoded bytes XOR onto 'frame' (previous frame in
+// place); otherwise they replace it.
+
+typedef struct {
+  uint16_t out;     // bytes produced so far
+  uint16_t litRun;  // literal bytes still expected
+  uint16_t repRun;  // pending repeat count (next byte is the value)
+} QgifRleState;
+
+static inline void qgifRleInit(QgifRleState *st) {
+  st->out    = 0;
+  st->litRun = 0;
+  st->repRun = 0;
+}
+
+// Consume 'n' payload bytes.  Returns false on overrun (corrupt stream).
+static inline RENDER_CORE_RAM bool qgifRleChunk(QgifRleState *st, const uint8_t *chunk,
+                                                uint16_t n, uint8_t *frame, bool delta) {
+  for (uint16_t i = 0; i < n; i++) {
+    uint8_t b = chunk[i];
+    if (st->litRun > 0) {
+      if (st->out >= QGIF_FRAME_SIZE) return false;
+      if (delta) frame[st->out++] ^= b;
+      else       frame[st->out++]  = b;
+      st->litRun--;
+    } else if (st->repRun > 0) {
+      if (st->out + st->repRun > QGIF_FRAME_SIZE) return false;
+      while (st->repRun--) {
+        if (delta) frame[st->out++] ^= b;
+        else       frame[st->out++]  = b;
+      }
+      st->repRun = 0;
+    } else if (b < 0x80) {
+      st->litRun = (uint16_t)b + 1;
+    } else {
+      st->repRun = (uint16_t)(b & 0x7F) + 2;
+    }
+  }
+  return true;
+}
+
+// True once the payload decoded to exactly one full frame.
+static inline bool qgifRleComplete(const QgifRleState *st) {
+  return st->out == QGIF_FRAME_SIZE && st->litRun == 0 && st->repRun == 0;
+}
+
+#endif // RENDER_CORE_H
@@ -1,12 +1,28 @@
 #include "gif_player.h"
+#include "render_core.h"
+#include "../../src/qlog.h"
+#include "../../src/qheap.h"
+#include "../../src/qtrace.h"
 #include <LittleFS.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include <atomic>
 
 // Forward declarations -- defined in settings.cpp
 extern bool getFlipMode();
 extern bool getNegativeGif();
 
+// Forward declaration -- defined in display_helpers.cpp.  Sends only the
+// display pages that changed since the last flush (operates on the global
+// u8g2 instance, which is the display this player renders to).
+extern void displayFlushDirty();
+
+// Forward declarations -- defined in perf_stats.cpp (telemetry only).
+// Dropped: a frame rendered past its deadline budget; skipped: a frame
+// the governor dropped to keep the animation wall-clock accurate.
+extern void perfStatsCountDroppedFrame();
+extern void perfStatsCountSkippedFrame();
+
 extern SemaphoreHandle_t gifPlayerMutex;
 
 // ---------------------------------------------------------------------------
@@ -19,17 +35,104 @@ static uint8_t       _frameCount    = 0;
 static uint16_t      _width         = 0;
 static uint16_t      _height        = 0;
 static uint16_t      _delays[QGIF_MAX_FRAMES];
-static uint8_t       _frameBuf[QGIF_FRAME_SIZE];
+static uint8_t       _frameBufs[2][QGIF_FRAME_SIZE];  // double buffer: draw + read-ahead
+static uint8_t       _drawBuf       = 0;   // index into _frameBufs being rendered
+static int16_t       _prefetchedFrame = -1;  // frame idx held in the other buffer, -1 = none
 static uint8_t       _currentFrame  = 0;
-static unsigned long _lastFrameMs   = 0;
+// Absolute frame schedule: deadlines accumulate from _delays[] instead of
+// re-anchoring at each render, so one late frame cannot slide the whole
+// animation.  0 = anchor on the next tick (fresh file).  A backlog larger
+// than GIF_CATCHUP_MAX_MS re-anchors instead of fast-forwarding.
+#define GIF_CATCHUP_MAX_MS 1000
+static unsigned long _nextDueMs     = 0;
 static uint32_t      _dataOffset    = 0;   // byte offset to first frame in file
 static String        _currentFile;
-static String        _requestedFile;
+static String        _requestedFile;         // tick-internal (auto-advance)
 static bool          _fileChanged   = false;
-static uint16_t      _speedDivisor  = 1;
+static volatile uint16_t _speedDivisor = 1;  // aligned 16-bit store is atomic here
+
+// --- Command mailbox (cross-task file requests) ---
+// handlePlay (async_tcp task), MQTT handling (network task) and touch
+// (display task) used to assign String _requestedFile under
+// gifPlayerMutex -- a heap allocation on a cross-task path, and a block
+// on the render loop whenever a dashboard click collided with the tick.
+// Single-slot seqlock instead: a producer claims the counter (even ->
+// odd), copies the name into the fixed slot and releases (odd -> next
+// even); the tick applies the slot only when it reads the same even
+// counter on both sides of the copy.  Last writer wins, producers spin
+// only against each other (never against the consumer), and the steady
+// state costs the tick one atomic load.
+static std::atomic<uint32_t> _cmdSeq{0};
+static char                  _cmdFile[44];   // GIF_INDEX_NAME_LEN; asserted below
+static uint32_t              _cmdApplied = 0;  // tick-local: last seq consumed
+
+// --- .qgif v2 (compressed) decode state ---
+static bool          _v2            = false;
+static int16_t       _v2NextFrame   = 0;   // frame index the stream cursor points at
+static uint32_t      _v2NextOffset  = 0;   // file offset of that frame's header
+static uint8_t       _v2PrevFrame[QGIF_FRAME_SIZE];  // last decoded frame (delta base)
+
+// --- Whole-file playback cache ---
+// The hottest loop in the product used to pay a LittleFS seek+read per
+// frame, forever.  Files that fit the cap are copied into one heap buffer
+// at open time and played from RAM: v1 frames are handed to the renderer
+// as pointers into the cache (zero-copy, seek-free), v2 decodes straight
+// from RAM.  Larger files keep the original streaming path.  The buffer
+// is allocated once and reused across file changes so it cannot fragment
+// the heap.
+//
+// (A raw mmap'd flash store, like the 'anim' partition sys_anim.cpp uses
+// for the packed boot/idle animations, was considered -- but user GIFs
+// are uploaded and deleted at runtime, which would need a flash extent
+// allocator plus another repartition on an already-full 4MB map.  The
+// RAM cache removes the filesystem from the per-frame path without
+// either.)
+#define GIF_CACHE_MAX_BYTES  (40 * 1024)
+#define GIF_CACHE_FILL_CHUNK 4096   // per-tick copy while the cache builds
+
+static uint8_t      *_cacheBuf      = nullptr;
+static uint32_t      _cacheLen      = 0;      // bytes of the cached file
+static bool          _cacheValid    = false;  // cache holds the open file
+static uint32_t      _cacheFillLen  = 0;      // build progress
+static bool          _cacheBuilding = false;
+
+// --- Cross-file prefetch (standby slot) ---
+// Auto-advance used to resolve the next shuffle name, open the file,
+// parse the header + delay table and read the first frame all inside the
+// boundary tick -- a visible hitch at every GIF switch.  When the final
+// loop of the current GIF starts, the next selection is drawn from the
+// bag early and staged here during the inter-frame waits; the switchover
+// then adopts the open handle and the pre-decoded first frame instead of
+// touching the filesystem.
+static File     _standbyFile;
+static String   _standbyName;
+static bool     _standbyReady      = false;  // staged and adoptable
+static bool     _standbyPending    = false;  // name chosen, staging still due
+static bool     _standbyV2         = false;
+static uint8_t  _standbyFrameCount = 0;
+static uint16_t _standbyDelays[QGIF_MAX_FRAMES];
+static uint32_t _standbyDataOffset = 0;
+static uint32_t _standbyNextOffset = 0;      // v2: frame 1's header offset
+static uint8_t  _standbyFirstFrame[QGIF_FRAME_SIZE];
+
+// --- On-flash file index ---
+// Fixed-slot list of .qgif basenames, persisted at GIF_INDEX_PATH so the
+// playback path never walks the LittleFS directory.  Rebuilt by a full
+// scan only when the index file is missing or corrupt; uploads and
+// deletes keep it current via gifPlayerIndexAdd()/gifPlayerIndexRemove().
+#define GIF_INDEX_PATH     "/.qgif.idx"
+// GIF_INDEX_MAX lives in gif_player.h (callers size snapshot buffers by it)
+#define GIF_INDEX_SLOT_LEN 48   // name (NUL-padded) + 4-byte content hash
+#define GIF_INDEX_NAME_LEN 44   // name portion incl. NUL (LittleFS caps names well below this)
+static_assert(sizeof(_cmdFile) == GIF_INDEX_NAME_LEN,
+              "command mailbox slot must hold a full index name");
+
+static char          _fileIndex[GIF_INDEX_MAX][GIF_INDEX_SLOT_LEN];
+static uint8_t       _indexCount   = 0;
+static bool          _indexLoaded  = false;
 
 // --- Shuffle bag (fair random) ---
-static String        _shuffleBag[QGIF_MAX_FRAMES];
+static uint8_t       _shuffleOrder[GIF_INDEX_MAX];  // indices into _fileIndex
 static uint8_t       _shuffleTotal  = 0;   // number of files in the bag
 static uint8_t       _shufflePos    = 0;   // next index to hand out
 
@@ -50,33 +153,116 @@ static uint8_t            _idleLoopTarget  = 1;
 // Private helpers
 // ---------------------------------------------------------------------------
 
+// Read len bytes at absolute file offset off, from the RAM cache when the
+// current file is cached, from LittleFS otherwise.
+static bool _srcRead(uint32_t off, uint8_t *dst, uint32_t len) {
+  if (_cacheValid) {
+    if (off > _cacheLen || len > _cacheLen - off) return false;
+    memcpy(dst, _cacheBuf + off, len);
+    return true;
+  }
+  if (!_file.seek(off)) return false;
+  return _file.read(dst, len) == len;
+}
+
+// v1 frames in the RAM cache need no copy at all: hand back a pointer.
+// Returns nullptr when the current file is v2 or not cached.
+static const uint8_t *_cachedFramePtr(uint8_t idx) {
+  if (!_cacheValid || _v2) return nullptr;
+  return _cacheBuf + _dataOffset + (uint32_t)idx * QGIF_FRAME_SIZE;
+}
+
+// Start (or skip) the RAM-cache build for the freshly opened file.  The
+// copy used to happen synchronously inside _openFile; reading up to 40KB
+// of flash in the boundary tick is exactly the hitch the standby slot
+// exists to remove, so the build now proceeds one chunk per tick from
+// the inter-frame window (_cacheFillTick) and playback streams from the
+// file until it completes.
+static void _cacheBeginFill() {
+  _cacheValid    = false;
+  _cacheBuilding = false;
+  uint32_t fsize = _file.size();
+  if (fsize < QGIF_HEADER_SIZE || fsize > GIF_CACHE_MAX_BYTES) return;
+  if (!_cacheBuf) {
+    _cacheBuf = (uint8_t *)qheapAlloc(QHEAP_GIF, GIF_CACHE_MAX_BYTES);
+    if (!_cacheBuf) {
+      static bool warned = false;
+      if (!warned) {
+        qlogWarn("gifPlayer: no RAM for playback cache, streaming");
+        warned = true;
+      }
+      return;
+    }
+  }
+  _cacheLen      = fsize;
+  _cacheFillLen  = 0;
+  _cacheBuilding = true;
+}
+
+static void _cacheFillTick() {
+  if (!_cacheBuilding) return;
+  if (!_file) {
+    _cacheBuilding = false;
+    return;
+  }
+  uint32_t want = _cacheLen - _cacheFillLen;
+  if (want > GIF_CACHE_FILL_CHUNK) want = GIF_CACHE_FILL_CHUNK;
+  if (!_file.seek(_cacheFillLen) ||
+      (uint32_t)_file.read(_cacheBuf + _cacheFillLen, want) != want) {
+    _cacheBuilding = false;   // keep streaming from the file
+    return;
+  }
+  _cacheFillLen += want;
+  if (_cacheFillLen >= _cacheLen) {
+    _cacheBuilding = false;
+    _cacheValid    = true;
+    _file.close();  // playback never touches the filesystem again
+  }
+}
+
 // Open a .qgif file, parse header + delays, prepare for frame streaming.
 static bool _openFile(const String &filename) {
   if (_file) _file.close();
-  _playing = false;
+  _playing    = false;
+  _cacheValid = false;
 
   String path = "/" + filename;
   _file = LittleFS.open(path, "r");
   if (!_file) {
-    Serial.println("gifPlayer: cannot open " + path);
+    qlogError("gifPlayer: cannot open %s", path.c_str());
     return false;
   }
 
-  // --- Read 5-byte header ---
-  uint8_t hdr[QGIF_HEADER_SIZE];
-  if (_file.read(hdr, QGIF_HEADER_SIZE) != QGIF_HEADER_SIZE) {
+  // --- Read header (v1: 5 bytes, v2: 7 bytes after 'Q2' magic) ---
+  uint8_t hdr[QGIF2_HEADER_SIZE];
+  if (_file.read(hdr, 2) != 2) {
     _file.close();
     return false;
   }
+  _v2 = (hdr[0] == QGIF2_MAGIC0 && hdr[1] == QGIF2_MAGIC1);
 
-  _frameCount = hdr[0];
-  _width      = hdr[1] | ((uint16_t)hdr[2] << 8);
-  _height     = hdr[3] | ((uint16_t)hdr[4] << 8);
+  if (_v2) {
+    if (_file.read(hdr + 2, QGIF2_HEADER_SIZE - 2) != QGIF2_HEADER_SIZE - 2) {
+      _file.close();
+      return false;
+    }
+    _frameCount = hdr[2];
+    _width      = hdr[3] | ((uint16_t)hdr[4] << 8);
+    _height     = hdr[5] | ((uint16_t)hdr[6] << 8);
+  } else {
+    if (_file.read(hdr + 2, QGIF_HEADER_SIZE - 2) != QGIF_HEADER_SIZE - 2) {
+      _file.close();
+      return false;
+    }
+    _frameCount = hdr[0];
+    _width      = hdr[1] | ((uint16_t)hdr[2] << 8);
+    _height     = hdr[3] | ((uint16_t)hdr[4] << 8);
+  }
 
   if (_frameCount == 0 || _width != QGIF_FRAME_WIDTH ||
       _height != QGIF_FRAME_HEIGHT) {
-    Serial.printf("gifPlayer: bad header fc=%u w=%u h=%u\n",
-                  _frameCount, _width, _height);
+    qlogError("gifPlayer: bad header fc=%u w=%u h=%u",
+               _frameCount, _width, _height);
     _file.close();
     return false;
   }
@@ -92,20 +278,328 @@ static bool _openFile(const String &filename) {
     _delays[i] = delayBuf[i * 2] | ((uint16_t)delayBuf[i * 2 + 1] << 8);
   }
 
-  _dataOffset   = QGIF_HEADER_SIZE + delayBytes;
+  // Kick off the incremental RAM-cache build when the file fits
+  _cacheBeginFill();
+
+  _dataOffset      = (_v2 ? QGIF2_HEADER_SIZE : QGIF_HEADER_SIZE) + delayBytes;
+  _v2NextFrame     = 0;
+  _v2NextOffset    = _dataOffset;
+  _currentFrame    = 0;
+  _prefetchedFrame = -1;  // read-ahead buffer belongs to the previous file
+  _nextDueMs       = 0;   // render first frame immediately, anchor there
+  _loopCount       = 0;
+  _currentFile     = filename;
+  _playing         = true;
+  return true;
+}
+
+// --- Standby slot helpers ---
+
+static void _standbyDiscard() {
+  if (_standbyFile) _standbyFile.close();
+  _standbyReady   = false;
+  _standbyPending = false;
+  _standbyName    = "";
+}
+
+// Stage _standbyName: open the file, parse header + delays, decode frame
+// 0 into _standbyFirstFrame.  Runs once, from the inter-frame window of
+// the current GIF's final loop -- a couple of KB of reads, well inside a
+// frame budget.  Any failure just falls back to the synchronous open at
+// the boundary.
+static void _standbyPrep() {
+  _standbyPending = false;
+
+  String path  = "/" + _standbyName;
+  _standbyFile = LittleFS.open(path, "r");
+  if (!_standbyFile) { _standbyDiscard(); return; }
+
+  uint8_t hdr[QGIF2_HEADER_SIZE];
+  if (_standbyFile.read(hdr, 2) != 2) { _standbyDiscard(); return; }
+  _standbyV2 = (hdr[0] == QGIF2_MAGIC0 && hdr[1] == QGIF2_MAGIC1);
+
+  uint16_t w, h;
+  if (_standbyV2) {
+    if (_standbyFile.read(hdr + 2, QGIF2_HEADER_SIZE - 2) !=
+        QGIF2_HEADER_SIZE - 2) { _standbyDiscard(); return; }
+    _standbyFrameCount = hdr[2];
+    w = hdr[3] | ((uint16_t)hdr[4] << 8);
+    h = hdr[5] | ((uint16_t)hdr[6] << 8);
+  } else {
+    if (_standbyFile.read(hdr + 2, QGIF_HEADER_SIZE - 2) !=
+        QGIF_HEADER_SIZE - 2) { _standbyDiscard(); return; }
+    _standbyFrameCount = hdr[0];
+    w = hdr[1] | ((uint16_t)hdr[2] << 8);
+    h = hdr[3] | ((uint16_t)hdr[4] << 8);
+  }
+  if (_standbyFrameCount == 0 || w != QGIF_FRAME_WIDTH ||
+      h != QGIF_FRAME_HEIGHT) { _standbyDiscard(); return; }
+
+  uint16_t delayBytes = (uint16_t)_standbyFrameCount * 2;
+  uint8_t  delayBuf[QGIF_MAX_FRAMES * 2];
+  if (_standbyFile.read(delayBuf, delayBytes) != delayBytes) {
+    _standbyDiscard();
+    return;
+  }
+  for (uint8_t i = 0; i < _standbyFrameCount; i++) {
+    _standbyDelays[i] = delayBuf[i * 2] | ((uint16_t)delayBuf[i * 2 + 1] << 8);
+  }
+  _standbyDataOffset =
+      (_standbyV2 ? QGIF2_HEADER_SIZE : QGIF_HEADER_SIZE) + delayBytes;
+  _standbyNextOffset = 0;
+
+  if (!_standbyV2) {
+    if (_standbyFile.read(_standbyFirstFrame, QGIF_FRAME_SIZE) !=
+        QGIF_FRAME_SIZE) { _standbyDiscard(); return; }
+  } else {
+    // Frame 0 is always a keyframe (gif_types.h), so no delta base needed
+    uint8_t fh[QGIF2_FRAME_HDR_SIZE];
+    if (_standbyFile.read(fh, QGIF2_FRAME_HDR_SIZE) != QGIF2_FRAME_HDR_SIZE) {
+      _standbyDiscard();
+      return;
+    }
+    uint8_t  flags = fh[0];
+    uint16_t plen  = fh[1] | ((uint16_t)fh[2] << 8);
+    if (flags & QGIF2_FLAG_DELTA) { _standbyDiscard(); return; }  // corrupt
+    if (flags & QGIF2_FLAG_RAW) {
+      if (plen != QGIF_FRAME_SIZE ||
+          _standbyFile.read(_standbyFirstFrame, QGIF_FRAME_SIZE) !=
+              QGIF_FRAME_SIZE) { _standbyDiscard(); return; }
+    } else {
+      uint8_t      chunk[128];
+      uint16_t     remain = plen;
+      QgifRleState st;
+      qgifRleInit(&st);
+      while (remain > 0) {
+        uint16_t want = (remain < sizeof(chunk)) ? remain : (uint16_t)sizeof(chunk);
+        if (_standbyFile.read(chunk, want) != want) { _standbyDiscard(); return; }
+        remain -= want;
+        if (!qgifRleChunk(&st, chunk, want, _standbyFirstFrame, false)) {
+          _standbyDiscard();
+          return;
+        }
+      }
+      if (!qgifRleComplete(&st)) { _standbyDiscard(); return; }
+    }
+    _standbyNextOffset = _standbyDataOffset + QGIF2_FRAME_HDR_SIZE + plen;
+  }
+  _standbyReady = true;
+}
+
+// Adopt the staged standby for 'filename': the boundary becomes a handle
+// move plus buffer copies -- no filesystem access.  Returns false on
+// mismatch or when staging never finished (caller falls back to the
+// synchronous open).
+static bool _openFromStandby(const String &filename) {
+  if (!_standbyReady || filename != _standbyName) return false;
+
+  if (_file) _file.close();
+  _file        = _standbyFile;
+  _standbyFile = File();
+
+  _v2         = _standbyV2;
+  _frameCount = _standbyFrameCount;
+  _width      = QGIF_FRAME_WIDTH;
+  _height     = QGIF_FRAME_HEIGHT;
+  memcpy(_delays, _standbyDelays, (size_t)_frameCount * 2);
+  _dataOffset   = _standbyDataOffset;
+  _v2NextFrame  = _v2 ? 1 : 0;
+  _v2NextOffset = _v2 ? _standbyNextOffset : _standbyDataOffset;
+  if (_v2) memcpy(_v2PrevFrame, _standbyFirstFrame, QGIF_FRAME_SIZE);
+
+  // Hand the pre-decoded first frame to the render path as a prefetch hit
+  memcpy(_frameBufs[_drawBuf ^ 1], _standbyFirstFrame, QGIF_FRAME_SIZE);
+  _prefetchedFrame = 0;
+
+  _cacheBeginFill();
+
   _currentFrame = 0;
-  _lastFrameMs  = 0;  // render first frame immediately
+  _nextDueMs    = 0;
   _loopCount    = 0;
   _currentFile  = filename;
   _playing      = true;
+
+  _standbyReady = false;
+  _standbyName  = "";
   return true;
 }
 
-// Read one frame into _frameBuf by seeking to its offset.
-static bool _readFrame(uint8_t idx) {
-  uint32_t off = _dataOffset + (uint32_t)idx * QGIF_FRAME_SIZE;
-  if (!_file.seek(off)) return false;
-  return _file.read(_frameBuf, QGIF_FRAME_SIZE) == QGIF_FRAME_SIZE;
+// Decode the v2 frame at the stream cursor into _v2PrevFrame.  Cached
+// files decode directly out of the RAM cache; streamed files run the RLE
+// payload through a small chunk buffer (the _srcRead of the frame header
+// leaves the file cursor at the payload, so the sequential reads below
+// pick up right after it).  Delta frames XOR onto the previous frame;
+// keyframes replace it.
+static bool _decodeNextV2() {
+  uint8_t fh[QGIF2_FRAME_HDR_SIZE];
+  if (!_srcRead(_v2NextOffset, fh, QGIF2_FRAME_HDR_SIZE)) return false;
+
+  uint8_t  flags = fh[0];
+  uint16_t plen  = fh[1] | ((uint16_t)fh[2] << 8);
+  bool     delta = (flags & QGIF2_FLAG_DELTA) != 0;
+  uint32_t payloadOff = _v2NextOffset + QGIF2_FRAME_HDR_SIZE;
+
+  if (_cacheValid &&
+      (payloadOff > _cacheLen || plen > _cacheLen - payloadOff)) return false;
+
+  if (flags & QGIF2_FLAG_RAW) {
+    if (plen != QGIF_FRAME_SIZE) return false;
+    if (_cacheValid) {
+      const uint8_t *src = _cacheBuf + payloadOff;
+      if (delta) {
+        for (uint16_t i = 0; i < QGIF_FRAME_SIZE; i++) _v2PrevFrame[i] ^= src[i];
+      } else {
+        memcpy(_v2PrevFrame, src, QGIF_FRAME_SIZE);
+      }
+    } else if (delta) {
+      uint8_t  chunk[128];
+      uint16_t out = 0;
+      while (out < QGIF_FRAME_SIZE) {
+        size_t n = _file.read(chunk, sizeof(chunk));
+        if (n == 0) return false;
+        for (size_t i = 0; i < n && out < QGIF_FRAME_SIZE; i++)
+          _v2PrevFrame[out++] ^= chunk[i];
+      }
+    } else {
+      if (_file.read(_v2PrevFrame, QGIF_FRAME_SIZE) != QGIF_FRAME_SIZE)
+        return false;
+    }
+  } else if (_cacheValid) {
+    QgifRleState st;
+    qgifRleInit(&st);
+    if (!qgifRleChunk(&st, _cacheBuf + payloadOff, plen, _v2PrevFrame, delta))
+      return false;
+    if (!qgifRleComplete(&st)) return false;
+  } else {
+    uint8_t      chunk[128];
+    uint16_t     remain = plen;
+    QgifRleState st;
+    qgifRleInit(&st);
+    while (remain > 0) {
+      uint16_t want = (remain < sizeof(chunk)) ? remain : (uint16_t)sizeof(chunk);
+      if (_file.read(chunk, want) != want) return false;
+      remain -= want;
+      if (!qgifRleChunk(&st, chunk, want, _v2PrevFrame, delta)) return false;
+    }
+    if (!qgifRleComplete(&st)) return false;
+  }
+
+  _v2NextOffset += QGIF2_FRAME_HDR_SIZE + plen;
+  _v2NextFrame++;
+  return true;
+}
+
+// Read one frame into dst.  v1 frames are fixed-size and seekable; v2 is a
+// sequential delta stream, so backwards requests (the wrap to frame 0)
+// rewind to the data start and decode forward.
+static bool _readFrame(uint8_t idx, uint8_t *dst) {
+  if (!_v2) {
+    uint32_t off = _dataOffset + (uint32_t)idx * QGIF_FRAME_SIZE;
+    return _srcRead(off, dst, QGIF_FRAME_SIZE);
+  }
+
+  if ((int16_t)idx == _v2NextFrame - 1) {
+    // Re-request of the last decoded frame (prefetch miss after a replay)
+    memcpy(dst, _v2PrevFrame, QGIF_FRAME_SIZE);
+    return true;
+  }
+  if ((int16_t)idx < _v2NextFrame) {
+    _v2NextFrame  = 0;
+    _v2NextOffset = _dataOffset;
+  }
+  while (_v2NextFrame <= (int16_t)idx) {
+    if (!_decodeNextV2()) return false;
+  }
+  memcpy(dst, _v2PrevFrame, QGIF_FRAME_SIZE);
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// File index -- internal helpers (caller must hold gifPlayerMutex)
+// ---------------------------------------------------------------------------
+
+// Slow path: walk the LittleFS root and collect .qgif basenames.
+static void _indexScan() {
+  _indexCount = 0;
+  File root = LittleFS.open("/");
+  if (!root || !root.isDirectory()) return;
+
+  File f = root.openNextFile();
+  while (f && _indexCount < GIF_INDEX_MAX) {
+    String name = String(f.name());
+    f.close();
+    if (name.startsWith("/")) name = name.substring(1);
+    if (name.endsWith(".qgif") && name.length() < GIF_INDEX_NAME_LEN) {
+      memset(_fileIndex[_indexCount], 0, GIF_INDEX_SLOT_LEN);
+      strncpy(_fileIndex[_indexCount], name.c_str(), GIF_INDEX_NAME_LEN - 1);
+      _indexCount++;
+    }
+    f = root.openNextFile();
+  }
+  root.close();
+}
+
+static void _indexSave() {
+  File f = LittleFS.open(GIF_INDEX_PATH, "w");
+  if (!f) {
+    Serial.println("gifPlayer: cannot write " GIF_INDEX_PATH);
+    return;
+  }
+  f.write((const uint8_t *)_fileIndex, (size_t)_indexCount * GIF_INDEX_SLOT_LEN);
+  f.close();
+}
+
+// Load the index in one read; fall back to a directory scan (and persist
+// the result) when the file is missing or does not look like slot data.
+static void _indexEnsureLoaded() {
+  if (_indexLoaded) return;
+
+  File f = LittleFS.open(GIF_INDEX_PATH, "r");
+  if (f) {
+    size_t sz = f.size();
+    if (sz % GIF_INDEX_SLOT_LEN == 0 && sz <= sizeof(_fileIndex)) {
+      bool ok = ((size_t)f.read((uint8_t *)_fileIndex, sz) == sz);
+      f.close();
+      if (ok) {
+        _indexCount = sz / GIF_INDEX_SLOT_LEN;
+        for (uint8_t i = 0; i < _indexCount && ok; i++) {
+          _fileIndex[i][GIF_INDEX_NAME_LEN - 1] = '\0';
+          if (_fileIndex[i][0] == '\0') ok = false;  // empty slot = corrupt
+        }
+        if (ok) {
+          _indexLoaded = true;
+          return;
+        }
+      }
+    } else {
+      f.close();
+    }
+  }
+
+  _indexScan();
+  _indexSave();
+  _indexLoaded = true;
+}
+
+static int _indexFind(const char *name) {
+  for (uint8_t i = 0; i < _indexCount; i++) {
+    if (strcmp(_fileIndex[i], name) == 0) return i;
+  }
+  return -1;
+}
+
+// Rebuild the shuffle order from the current index (Fisher-Yates).
+static void _bagRebuild() {
+  _indexEnsureLoaded();
+  _shuffleTotal = _indexCount;
+  for (uint8_t i = 0; i < _shuffleTotal; i++) _shuffleOrder[i] = i;
+  for (int i = (int)_shuffleTotal - 1; i > 0; i--) {
+    uint8_t j = random(i + 1);
+    uint8_t tmp      = _shuffleOrder[i];
+    _shuffleOrder[i] = _shuffleOrder[j];
+    _shuffleOrder[j] = tmp;
+  }
+  _shufflePos = 0;
 }
 
 // ---------------------------------------------------------------------------
@@ -123,66 +617,124 @@ bool gifPlayerInit(U8G2 *display) {
 }
 
 bool gifPlayerHasFiles() {
-  File root = LittleFS.open("/");
-  if (!root || !root.isDirectory()) return false;
-  File f = root.openNextFile();
-  while (f) {
-    String name = String(f.name());
-    f.close();
-    if (name.endsWith(".qgif")) { root.close(); return true; }
-    f = root.openNextFile();
-  }
-  root.close();
-  return false;
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  bool any = (_indexCount > 0);
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return any;
 }
 
 String gifPlayerGetFirstFile() {
-  File root = LittleFS.open("/");
-  if (!root || !root.isDirectory()) return "";
-  File f = root.openNextFile();
-  while (f) {
-    String name = String(f.name());
-    f.close();
-    if (name.endsWith(".qgif")) {
-      if (name.startsWith("/")) name = name.substring(1);
-      root.close();
-      return name;
-    }
-    f = root.openNextFile();
-  }
-  root.close();
-  return "";
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  String first = (_indexCount > 0) ? String(_fileIndex[0]) : "";
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return first;
 }
 
 String gifPlayerGetNextFile(const String &current) {
-  File root = LittleFS.open("/");
-  if (!root || !root.isDirectory()) return "";
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
 
-  // Collect all .qgif filenames
-  String files[QGIF_MAX_FRAMES];  // reuse max as upper bound
-  uint8_t count = 0;
-  File f = root.openNextFile();
-  while (f && count < QGIF_MAX_FRAMES) {
-    String name = String(f.name());
-    f.close();
-    if (name.endsWith(".qgif")) {
-      if (name.startsWith("/")) name = name.substring(1);
-      files[count++] = name;
-    }
-    f = root.openNextFile();
+  String next = "";
+  if (_indexCount > 0) {
+    int i = _indexFind(current.c_str());
+    next  = (i >= 0) ? String(_fileIndex[(i + 1) % _indexCount])
+                     : String(_fileIndex[0]);
   }
-  root.close();
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return next;
+}
+
+// ---------------------------------------------------------------------------
+// File index -- upload/delete hooks
+// ---------------------------------------------------------------------------
 
-  if (count == 0) return "";
-  if (count == 1) return files[0];
+void gifPlayerIndexAdd(const String &filename) {
+  if (filename.length() == 0 || filename.length() >= GIF_INDEX_NAME_LEN) return;
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  if (_indexFind(filename.c_str()) < 0 && _indexCount < GIF_INDEX_MAX) {
+    memset(_fileIndex[_indexCount], 0, GIF_INDEX_SLOT_LEN);
+    strncpy(_fileIndex[_indexCount], filename.c_str(), GIF_INDEX_NAME_LEN - 1);
+    _indexCount++;
+    _indexSave();
+    _bagRebuild();
+  }
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+}
 
-  // Find current index, return next (wrap around)
-  for (uint8_t i = 0; i < count; i++) {
-    if (files[i] == current) {
-      return files[(i + 1) % count];
+void gifPlayerIndexRemove(const String &filename) {
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  int i = _indexFind(filename.c_str());
+  if (i >= 0) {
+    if (i < (int)_indexCount - 1) {
+      memmove(_fileIndex[i], _fileIndex[i + 1],
+              (size_t)(_indexCount - 1 - i) * GIF_INDEX_SLOT_LEN);
     }
+    _indexCount--;
+    _indexSave();
+    _bagRebuild();
+  }
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+}
+
+uint8_t gifPlayerIndexCount() {
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  uint8_t n = _indexCount;
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return n;
+}
+
+bool gifPlayerIndexEntry(uint8_t i, char *out, size_t outLen) {
+  if (!out || outLen == 0) return false;
+  bool ok = false;
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  if (i < _indexCount) {
+    strlcpy(out, _fileIndex[i], outLen);
+    ok = true;
+  }
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return ok;
+}
+
+// Content hash lives in each slot's last 4 bytes.  Slots written before the
+// hash existed (and freshly scanned entries) carry 0 = "unknown"; readers
+// treat that as never-matching.
+
+uint32_t gifPlayerIndexHashAt(uint8_t i) {
+  uint32_t h = 0;
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  if (i < _indexCount)
+    memcpy(&h, _fileIndex[i] + GIF_INDEX_NAME_LEN, sizeof(h));
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return h;
+}
+
+uint32_t gifPlayerIndexHash(const String &filename) {
+  uint32_t h = 0;
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  int i = _indexFind(filename.c_str());
+  if (i >= 0)
+    memcpy(&h, _fileIndex[i] + GIF_INDEX_NAME_LEN, sizeof(h));
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return h;
+}
+
+void gifPlayerIndexSetHash(const String &filename, uint32_t hash) {
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  int i = _indexFind(filename.c_str());
+  if (i >= 0) {
+    memcpy(_fileIndex[i] + GIF_INDEX_NAME_LEN, &hash, sizeof(hash));
+    _indexSave();
   }
-  return files[0];  // current not found, return first
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
 }
 
 // ---------------------------------------------------------------------------
@@ -190,54 +742,78 @@ String gifPlayerGetNextFile(const String &current) {
 // ---------------------------------------------------------------------------
 
 void gifPlayerBuildShuffleBag() {
-  File root = LittleFS.open("/");
-  if (!root || !root.isDirectory()) { _shuffleTotal = 0; return; }
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _bagRebuild();
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+}
 
-  _shuffleTotal = 0;
-  File f = root.openNextFile();
-  while (f && _shuffleTotal < QGIF_MAX_FRAMES) {
-    String name = String(f.name());
-    f.close();
-    if (name.endsWith(".qgif")) {
-      if (name.startsWith("/")) name = name.substring(1);
-      _shuffleBag[_shuffleTotal++] = name;
+String gifPlayerNextShuffle() {
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+
+  if (_shuffleTotal == 0) _bagRebuild();   // lazy first build
+
+  String out = "";
+  if (_shuffleTotal == 1) {
+    out = String(_fileIndex[_shuffleOrder[0]]);
+  } else if (_shuffleTotal > 1) {
+    if (_shufflePos >= _shuffleTotal) {
+      // Remember the last file handed out so we can avoid repeating it
+      // at the boundary between two shuffles.
+      uint8_t last = _shuffleOrder[_shuffleTotal - 1];
+
+      _bagRebuild();
+
+      // If the new bag starts with the same file that ended the old bag,
+      // swap it to a random other position.
+      if (_shuffleTotal > 1 && _shuffleOrder[0] == last) {
+        uint8_t sw = 1 + random(_shuffleTotal - 1);
+        _shuffleOrder[0]  = _shuffleOrder[sw];
+        _shuffleOrder[sw] = last;
+      }
     }
-    f = root.openNextFile();
+    if (_shufflePos < _shuffleTotal)
+      out = String(_fileIndex[_shuffleOrder[_shufflePos++]]);
   }
-  root.close();
 
-  // Fisher-Yates shuffle
-  for (int i = (int)_shuffleTotal - 1; i > 0; i--) {
-    uint8_t j = random(i + 1);
-    String tmp      = _shuffleBag[i];
-    _shuffleBag[i]  = _shuffleBag[j];
-    _shuffleBag[j]  = tmp;
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return out;
+}
+
+uint8_t gifPlayerShuffleSnapshot(uint8_t *orderOut, uint8_t *posOut) {
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  uint8_t total = _shuffleTotal;
+  if (total > 0) {
+    memcpy(orderOut, _shuffleOrder, total);
+    *posOut = _shufflePos;
   }
-  _shufflePos = 0;
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return total;
 }
 
-String gifPlayerNextShuffle() {
-  if (_shuffleTotal == 0) return "";
-  if (_shuffleTotal == 1) return _shuffleBag[0];
-
-  if (_shufflePos >= _shuffleTotal) {
-    // Remember the last file handed out so we can avoid repeating it
-    // at the boundary between two shuffles.
-    String last = _shuffleBag[_shuffleTotal - 1];
-
-    gifPlayerBuildShuffleBag();
-    if (_shuffleTotal == 0) return "";
-
-    // If the new bag starts with the same file that ended the old bag,
-    // swap it to a random other position.
-    if (_shuffleBag[0] == last && _shuffleTotal > 1) {
-      uint8_t sw = 1 + random(_shuffleTotal - 1);
-      _shuffleBag[0]  = _shuffleBag[sw];
-      _shuffleBag[sw] = last;
+bool gifPlayerShuffleRestore(const uint8_t *order, uint8_t total, uint8_t pos) {
+  bool ok = false;
+  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
+  _indexEnsureLoaded();
+  if (total > 0 && total == _indexCount && pos <= total) {
+    // Accept only a permutation of the current index; a stale snapshot
+    // would otherwise skip some files and replay others.
+    bool seen[GIF_INDEX_MAX] = {false};
+    ok = true;
+    for (uint8_t i = 0; i < total; i++) {
+      if (order[i] >= total || seen[order[i]]) {
+        ok = false;
+        break;
+      }
+      seen[order[i]] = true;
+    }
+    if (ok) {
+      memcpy(_shuffleOrder, order, total);
+      _shuffleTotal = total;
+      _shufflePos   = pos;
     }
   }
-
-  return _shuffleBag[_shufflePos++];
+  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  return ok;
 }
 
 void gifPlayerSetAutoAdvance(uint8_t loopsPerGif) {
@@ -259,6 +835,7 @@ void gifPlayerStartIdleIfNoUserGifs() {
   _playing         = false;
   _fileChanged     = false;
   _requestedFile   = "";
+  _cmdApplied      = _cmdSeq.load(std::memory_order_acquire);  // drop queued commands
   _currentFile     = "";
   _idlePlaying     = true;
   _idleFrame       = 0;
@@ -269,10 +846,18 @@ void gifPlayerStartIdleIfNoUserGifs() {
 }
 
 void gifPlayerSetFile(const String &filename) {
-  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
-  _requestedFile = filename;
-  _fileChanged   = true;
-  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
+  // Claim the mailbox from an even (idle) counter; a failed CAS means
+  // another producer is mid-publish -- retry and overwrite its command
+  // (last writer wins, same as the old assignment).  Never blocks on the
+  // render loop and allocates nothing.
+  uint32_t s = _cmdSeq.load(std::memory_order_relaxed);
+  do {
+    s &= ~1u;
+  } while (!_cmdSeq.compare_exchange_weak(s, s + 1,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed));
+  strlcpy(_cmdFile, filename.c_str(), sizeof(_cmdFile));
+  _cmdSeq.store(s + 2, std::memory_order_release);
 }
 
 String gifPlayerGetCurrentFile() {
@@ -282,22 +867,85 @@ String gifPlayerGetCurrentFile() {
   return f;
 }
 
+// Speed is a single aligned 16-bit value; plain volatile load/store is
+// atomic on this core, so neither side needs the mutex.
+
 void gifPlayerSetSpeed(uint16_t divisor) {
-  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
   _speedDivisor = (divisor > 0) ? divisor : 1;
-  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
 }
 
 uint16_t gifPlayerGetSpeed() {
-  if (gifPlayerMutex) xSemaphoreTake(gifPlayerMutex, portMAX_DELAY);
-  uint16_t s = _speedDivisor;
-  if (gifPlayerMutex) xSemaphoreGive(gifPlayerMutex);
-  return s;
+  return _speedDivisor;
+}
+
+// Next file at a boundary: prefer the selection already staged (or being
+// staged) in the standby slot -- the bag was consumed when it was chosen.
+static String _nextSelection() {
+  if (_standbyReady || _standbyPending) return _standbyName;
+  return gifPlayerNextShuffle();
+}
+
+// Advance to the next frame, handling loop wrap and the auto-advance /
+// idle-animation hand-off.  Shared by the render path and the skip
+// governor in gifPlayerTick().
+static void _advanceFrame() {
+  _currentFrame++;
+  if (_currentFrame >= _frameCount) {
+    _currentFrame = 0;
+    _loopCount++;
+
+    // Entering the final loop: draw the next selection from the bag now
+    // so it can be staged in the standby slot during the coming
+    // inter-frame waits, making the boundary below a pointer swap.
+    if (_loopsPerGif > 1 && _loopCount == _loopsPerGif - 1 &&
+        !_standbyReady && !_standbyPending) {
+      String next = gifPlayerNextShuffle();
+      if (next.length() > 0) {
+        _standbyName    = next;
+        _standbyPending = true;
+      }
+    }
+
+    // Auto-advance to next shuffled GIF after N full loops
+    if (_loopsPerGif > 0 && _loopCount >= _loopsPerGif) {
+      _loopCount = 0;
+
+      // If idle animation is configured, play it before the next GIF
+      if (_idleAnim) {
+        _idlePlaying     = true;
+        _idleFrame       = 0;
+        _idleLoopCount   = 0;
+        _idleLoopTarget  = 1 + (esp_random() % 5);  // 1..5 random loops
+        _idleLastFrameMs = 0;  // render first frame immediately
+      } else {
+        // No idle animation, advance directly
+        String next = _nextSelection();
+        if (next.length() > 0) {
+          _requestedFile = next;
+          _fileChanged   = true;
+        }
+      }
+    }
+  }
 }
 
 void gifPlayerTick() {
   if (!_display) return;
 
+  // --- Drain the command mailbox (wait-free; see declaration) ---
+  uint32_t seq = _cmdSeq.load(std::memory_order_acquire);
+  if (seq != _cmdApplied && !(seq & 1)) {
+    char name[sizeof(_cmdFile)];
+    memcpy(name, _cmdFile, sizeof(name));
+    if (_cmdSeq.load(std::memory_order_acquire) == seq) {
+      // Stable copy: hand it to the existing (now tick-local) request path.
+      _cmdApplied    = seq;
+      _requestedFile = name;
+      _fileChanged   = true;
+    }
+    // else a producer is republishing; pick the newer command up next tick
+  }
+
   // --- Idle animation playback (PROGMEM, between GIFs) ---
   if (_idlePlaying && _idleAnim) {
     // If a file change was requested externally (e.g. touch), interrupt
@@ -323,7 +971,7 @@ void gifPlayerTick() {
           // Idle loops done -- switch to next GIF (or keep idling if there are no .qgif files)
           _idlePlaying   = false;
           _idleLoopCount = 0;
-          String next = gifPlayerNextShuffle();
+          String next = _nextSelection();
           if (next.length() > 0) {
             _requestedFile = next;
             _fileChanged   = true;
@@ -344,7 +992,10 @@ void gifPlayerTick() {
   if (_fileChanged) {
     _fileChanged = false;
     if (_requestedFile.length() > 0) {
-      _openFile(_requestedFile);
+      if (!_openFromStandby(_requestedFile)) {
+        _standbyDiscard();  // stale or mismatched staging
+        _openFile(_requestedFile);
+      }
     } else {
       if (_file) _file.close();
       _playing     = false;
@@ -354,80 +1005,112 @@ void gifPlayerTick() {
 
   if (!_playing) return;
 
-  // --- Frame timing ---
+  // --- Frame timing (absolute schedule + skip governor) ---
+  unsigned long now = millis();
   uint16_t delayMs = _delays[_currentFrame] / _speedDivisor;
   if (delayMs < 1) delayMs = 1;
-  if (millis() - _lastFrameMs < delayMs) return;
+  if (_nextDueMs == 0) _nextDueMs = now;    // fresh file: anchor here
+  if ((long)(now - _nextDueMs) < 0) return; // not due yet
+
+  if (now - _nextDueMs >= (unsigned long)delayMs)
+    perfStatsCountDroppedFrame();  // a stall pushed us at least a full period late
 
-  // --- Read frame from flash and render ---
-  if (_readFrame(_currentFrame)) {
-    gifRenderFrame(_display, _frameBuf, _width, _height);
+  if (now - _nextDueMs > GIF_CATCHUP_MAX_MS) {
+    // Hopeless backlog (e.g. long flash erase): re-anchor instead of
+    // fast-forwarding through seconds of content.
+    _nextDueMs = now;
+  } else {
+    // Skip frames whose entire display window already passed, so the
+    // animation stays wall-clock accurate under load.
+    while (now - _nextDueMs >= (unsigned long)delayMs) {
+      _nextDueMs += delayMs;
+      _advanceFrame();
+      perfStatsCountSkippedFrame();
+      if (!_playing || _fileChanged || _idlePlaying) return;  // advance handed off
+      delayMs = _delays[_currentFrame] / _speedDivisor;
+      if (delayMs < 1) delayMs = 1;
+    }
   }
 
-  _lastFrameMs = millis();
-  _currentFrame++;
-  if (_currentFrame >= _frameCount) {
-    _currentFrame = 0;
-    _loopCount++;
+  // --- Render the current frame ---
+  // Cached v1 files render straight out of the RAM cache (zero-copy;
+  // gifRenderFrame leaves frameData untouched).  Otherwise prefer the
+  // read-ahead buffer filled at the end of the previous tick, falling
+  // back to a synchronous read (first frame, or prefetch miss).
+  const uint8_t *cached = _cachedFramePtr(_currentFrame);
+  if (cached) {
+    gifRenderFrame(_display, (uint8_t *)cached, _width, _height);
+  } else if (_prefetchedFrame == (int16_t)_currentFrame) {
+    _drawBuf ^= 1;  // the prefetch buffer becomes the draw buffer
+    _prefetchedFrame = -1;
+    gifRenderFrame(_display, _frameBufs[_drawBuf], _width, _height);
+  } else {
+    int64_t tRead = qtraceNow();
+    bool ok = _readFrame(_currentFrame, _frameBufs[_drawBuf]);
+    qtraceSpan(_v2 ? "gif.decode" : "gif.read", tRead);
+    if (ok) gifRenderFrame(_display, _frameBufs[_drawBuf], _width, _height);
+  }
 
-    // Auto-advance to next shuffled GIF after N full loops
-    if (_loopsPerGif > 0 && _loopCount >= _loopsPerGif) {
-      _loopCount = 0;
+  _nextDueMs += delayMs;
+  _advanceFrame();
 
-      // If idle animation is configured, play it before the next GIF
-      if (_idleAnim) {
-        _idlePlaying     = true;
-        _idleFrame       = 0;
-        _idleLoopCount   = 0;
-        _idleLoopTarget  = 1 + (esp_random() % 5);  // 1..5 random loops
-        _idleLastFrameMs = 0;  // render first frame immediately
-      } else {
-        // No idle animation, advance directly
-        String next = gifPlayerNextShuffle();
-        if (next.length() > 0) {
-          _requestedFile = next;
-          _fileChanged   = true;
-        }
-      }
+  // --- Read-ahead ---
+  // Fetch the next frame into the spare buffer now, during the inter-frame
+  // wait, so the next deadline pays only render + I2C transmit instead of
+  // flash read + render + transmit.  Nothing to prefetch when v1 frames
+  // render straight from the RAM cache.
+  if (_playing && !_fileChanged && !_idlePlaying && !(_cacheValid && !_v2)) {
+    int64_t tRead = qtraceNow();
+    if (_readFrame(_currentFrame, _frameBufs[_drawBuf ^ 1])) {
+      _prefetchedFrame = (int16_t)_currentFrame;
     }
+    qtraceSpan("gif.prefetch", tRead);
   }
+
+  // --- Background work in the inter-frame window ---
+  // One cache-build chunk per rendered frame, and the one-shot standby
+  // staging once the final loop has chosen the next file.
+  _cacheFillTick();
+  if (_standbyPending && !_fileChanged) _standbyPrep();
+}
+
+uint32_t gifPlayerMsUntilNextFrame() {
+  unsigned long now = millis();
+
+  if (_idlePlaying && _idleAnim) {
+    uint16_t d = _idleAnim->delays[_idleFrame] / _speedDivisor;
+    if (d < 1) d = 1;
+    unsigned long e = now - _idleLastFrameMs;
+    return (e >= d) ? 0 : (uint32_t)(d - e);
+  }
+  if (_fileChanged) return 0;    // pending file switch: tick immediately
+  if (!_playing) return 1000;    // nothing animating
+
+  if (_nextDueMs == 0) return 0;  // fresh file: render immediately
+  return ((long)(now - _nextDueMs) >= 0) ? 0 : (uint32_t)(_nextDueMs - now);
 }
 
 // ---------------------------------------------------------------------------
-// gifRenderFrame -- rotation-aware render via U8G2 drawBitmap
+// gifRenderFrame -- direct framebuffer render (zero-copy fast path)
 // ---------------------------------------------------------------------------
-// qgif stores 0=lit, 1=dark. U8G2 drawBitmap draws bit=1 as foreground.
-// Invert frameData in-place when needed (caller's buffer; do not reuse before refill).
-// Default U8G2_R0: apply 180 deg buffer rotation only when flip mode is on.
-void gifRenderFrame(U8G2 *display, uint8_t *frameData,
-                    uint16_t width, uint16_t height) {
-  // Invert polarity unless Negative GIF mode is on
-  if (!getNegativeGif()) {
-    const uint16_t dataLen = (uint16_t)(width / 8) * height;
-    for (uint16_t i = 0; i < dataLen; i++) frameData[i] ^= 0xFF;
-  }
-
-  display->clearBuffer();
-  display->setDrawColor(1);
-  display->drawBitmap(0, 0, width / 8, height, frameData);
-
-  // With default R0: apply 180 rotation only when flip mode is on
-  if (getFlipMode()) {
-    uint8_t        *buf = display->getBufferPtr();
-    const uint16_t  len = 1024;
-    for (uint16_t i = 0; i < len / 2; i++) {
-      uint8_t tmp      = buf[i];
-      buf[i]           = buf[len - 1 - i];
-      buf[len - 1 - i] = tmp;
-    }
-    for (uint16_t i = 0; i < len; i++) {
-      uint8_t b = buf[i];
-      b = ((b & 0xF0) >> 4) | ((b & 0x0F) << 4);
-      b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
-      b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
-      buf[i] = b;
-    }
-  }
+// Thin wrapper around renderCoreFrameToPages() (include/render_core.h,
+// exercised by the native test env): transposes the qgif row layout
+// straight into u8g2's page buffer with polarity inversion (qgif stores
+// 0=lit, 1=dark) and the flip-mode 180 deg rotation folded into the same
+// pass.  This replaces the old per-pixel U8G2 drawBitmap path and leaves
+// frameData untouched, so callers can reuse their buffer across frames.
+// IRAM so the inlined transpose keeps its cadence through the cold-cache
+// windows upload/NVS flash writes leave behind (see render_core.h).
+void IRAM_ATTR gifRenderFrame(U8G2 *display, uint8_t *frameData,
+                              uint16_t width, uint16_t height) {
+  if (width != QGIF_FRAME_WIDTH || height != QGIF_FRAME_HEIGHT) return;
+
+  int64_t tSpan = qtraceNow();
+  renderCoreFrameToPages(frameData, display->getBufferPtr(),
+                         getNegativeGif() ? 0x00 : 0xFF, getFlipMode());
+  qtraceSpan("gif.render", tSpan);
 
-  display->sendBuffer();
+  tSpan = qtraceNow();
+  displayFlushDirty();
+  qtraceSpan("disp.flush", tSpan);
 }
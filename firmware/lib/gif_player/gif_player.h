@@ -5,6 +5,10 @@
 #include <U8g2lib.h>
 #include "gif_types.h"
 
+// Capacity of the persistent file index; also bounds the shuffle bag, so
+// callers snapshotting the bag size their buffers with it.
+#define GIF_INDEX_MAX 128
+
 // Mount LittleFS and store the display pointer for rendering.
 bool gifPlayerInit(U8G2 *display);
 
@@ -14,13 +18,42 @@ bool gifPlayerHasFiles();
 // Return the filename of the first .qgif file found (empty if none).
 String gifPlayerGetFirstFile();
 
-// Return the filename after 'current' in alphabetical order (wraps around).
+// Return the filename after 'current' in index order (wraps around).
 // If current is empty or not found, returns the first file.
 String gifPlayerGetNextFile(const String &current);
 
-// Build (or rebuild) the internal shuffle bag by scanning LittleFS for
-// .qgif files and applying a Fisher-Yates shuffle.  Call once after init
-// and again whenever files are added/removed.
+// Register a newly uploaded .qgif in the persistent file index (no-op if
+// already present).  Call after a successful upload.
+void gifPlayerIndexAdd(const String &filename);
+
+// Remove a .qgif from the persistent file index.  Call after deleting
+// the file from LittleFS.
+void gifPlayerIndexRemove(const String &filename);
+
+// Number of files in the persistent index (loads it on first use).
+uint8_t gifPlayerIndexCount();
+
+// Copy the basename of index entry 'i' (no leading '/') into 'out'.
+// Returns false when 'i' is out of range.  Safe to call from other tasks;
+// the copy happens under the player mutex so concurrent add/remove cannot
+// hand out a half-shifted slot.
+bool gifPlayerIndexEntry(uint8_t i, char *out, size_t outLen);
+
+// Content hash (FNV-1a over the file bytes) stored alongside each index
+// entry.  0 means "unknown" -- entries indexed before the hash existed or
+// recovered by a directory scan; callers must treat 0 as never-matching.
+uint32_t gifPlayerIndexHashAt(uint8_t i);
+uint32_t gifPlayerIndexHash(const String &filename);
+
+// Record the content hash for an already-indexed file and persist the
+// index.  Call after a successful upload, with the hash accumulated while
+// the bytes streamed through.
+void gifPlayerIndexSetHash(const String &filename, uint32_t hash);
+
+// Build (or rebuild) the internal shuffle bag from the persistent file
+// index and apply a Fisher-Yates shuffle.  The index is loaded from flash
+// on first use (a full directory scan runs only if the index file is
+// missing), so this stays cheap even with many files.
 void gifPlayerBuildShuffleBag();
 
 // Return the next filename from the shuffle bag.  When the bag is
@@ -28,13 +61,27 @@ void gifPlayerBuildShuffleBag();
 // away from position 0 to avoid immediate repeats at the boundary).
 String gifPlayerNextShuffle();
 
+// Copy the current bag order into 'orderOut' (at least GIF_INDEX_MAX
+// bytes) and the next hand-out position into 'posOut'.  Returns the bag
+// size, 0 when no bag has been built yet.  Lets the display task persist
+// the bag across reboots (session snapshot).
+uint8_t gifPlayerShuffleSnapshot(uint8_t *orderOut, uint8_t *posOut);
+
+// Reinstate a previously snapshotted bag.  Accepted only when 'order' is
+// a permutation of the current file index (uploads or deletes since the
+// snapshot invalidate it); returns false otherwise and leaves the bag
+// untouched for the caller to rebuild.
+bool gifPlayerShuffleRestore(const uint8_t *order, uint8_t total, uint8_t pos);
+
 // Enable auto-advance: after each GIF has looped 'loopsPerGif' times the
 // player automatically switches to the next file from the shuffle bag.
 // Pass 0 to disable auto-advance (default).
 void gifPlayerSetAutoAdvance(uint8_t loopsPerGif);
 
-// Request a file change (takes effect on next tick).
-// Pass an empty string to stop playback.
+// Request a file change (takes effect on next tick).  Pass an empty
+// string to stop playback.  Safe from any task and never blocks: the
+// request goes through a single-slot lock-free mailbox (last writer
+// wins), so a dashboard click can't stall the render loop.
 void gifPlayerSetFile(const String &filename);
 
 // Return the filename currently being played (empty if idle).
@@ -58,11 +105,16 @@ void gifPlayerStartIdleIfNoUserGifs();
 // Renders the next frame when timing is due.
 void gifPlayerTick();
 
+// Milliseconds until the next frame (file or idle animation) is due.
+// 0 = due now; a large value when nothing is animating.  Lets the display
+// loop sleep until the actual frame deadline instead of polling.
+uint32_t gifPlayerMsUntilNextFrame();
+
 // Render a raw 128x64 monochrome bitmap to the display.
-// Uses U8G2 drawBitmap(); rotation follows default R0 and flip-mode setting.
-// frameData may be inverted in-place for polarity — caller must not reuse
-// the buffer for another frame without refilling it first.
-// Shared by both the PROGMEM boot animation and file-based playback.
+// Transposes the qgif row layout straight into the u8g2 page buffer,
+// applying polarity inversion and the flip-mode 180 deg rotation during
+// the copy; frameData is left untouched and may be reused across frames.
+// Shared by boot animation, file-based playback, and CAM_VIEW.
 void gifRenderFrame(U8G2 *display, uint8_t *frameData,
                     uint16_t width, uint16_t height);
 
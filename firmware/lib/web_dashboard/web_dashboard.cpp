@@ -3,6 +3,14 @@
 #include "../../src/settings.h"
 #include "../../src/app_state.h"
 #include "../../src/network_task.h"
+#include "../../src/perf_stats.h"
+#include "../../src/power_governor.h"
+#include "../../src/qlog.h"
+#include "../../src/qheap.h"
+#include "../../src/qtrace.h"
+#include "../../src/display_task.h"
+#include "../../src/display_helpers.h"
+#include "render_core.h"
 #include <LittleFS.h>
 #include <ArduinoJson.h>
 #include <HTTPClient.h>
@@ -11,8 +19,10 @@
 #endif
 #if defined(ESP32)
 #include <esp_system.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include <freertos/task.h>
 #endif
 
 // ==========================================================================
@@ -21,8 +31,107 @@
 
 static File   _uploadFile;
 static bool   _uploadOk    = false;
+static bool   _uploadDedup = false;  // ?hash= matched the stored file; body ignored
 static String _uploadError;
 
+// Content hash for dedup: FNV-1a over the file bytes, accumulated as
+// chunks stream through so it costs nothing extra on the flash path.
+#define FNV1A_INIT 2166136261UL
+static uint32_t _uploadHash = FNV1A_INIT;
+static uint32_t fnv1aUpdate(uint32_t h, const uint8_t *data, size_t len) {
+    while (len--) {
+        h ^= *data++;
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+// --- Buffered upload write pipeline ---
+// AsyncTCP delivers uploads in small chunks; writing each one straight to
+// LittleFS from the async_tcp task stalls all other HTTP traffic on every
+// flash program.  Chunks are staged into one of two 4 KB buffers instead;
+// full buffers are handed to a low-priority writer task (ping-pong: the
+// async_tcp side fills one buffer while the writer flushes the other, with
+// at most one write outstanding).
+
+#define UPLOAD_BUF_SIZE 4096
+
+static uint8_t           _uploadBuf[2][UPLOAD_BUF_SIZE];
+static size_t            _uploadBufLen     = 0;        // fill level of the staging buffer
+static uint8_t           _uploadFillIdx    = 0;        // buffer the handler is filling
+static TaskHandle_t      _uploadWriterTask = nullptr;
+static SemaphoreHandle_t _uploadWriteDone  = nullptr;  // given when the writer is idle
+static volatile size_t   _uploadWriteLen   = 0;        // bytes handed to the writer
+static volatile uint8_t  _uploadWriteIdx   = 0;        // buffer handed to the writer
+static volatile bool     _uploadWriteFailed = false;
+
+// Per-upload throughput (reported in the /api/upload response)
+static size_t        _uploadBytes   = 0;
+static unsigned long _uploadStartMs = 0;
+static unsigned long _uploadEndMs   = 0;
+
+static void uploadWriterTaskFn(void *arg) {
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        size_t len = _uploadWriteLen;
+        if (len > 0 && _uploadFile) {
+            if (_uploadFile.write(_uploadBuf[_uploadWriteIdx], len) != len)
+                _uploadWriteFailed = true;
+        }
+        _uploadWriteLen = 0;
+        xSemaphoreGive(_uploadWriteDone);
+    }
+}
+
+// Wait for the outstanding write (if any) to finish.  Returns false if the
+// writer reported a failure or never completed.
+static bool uploadJoinWriter() {
+    if (xSemaphoreTake(_uploadWriteDone, pdMS_TO_TICKS(10000)) != pdTRUE)
+        return false;
+    xSemaphoreGive(_uploadWriteDone);
+    return !_uploadWriteFailed;
+}
+
+// Hand the filled staging buffer to the writer task and switch buffers.
+static bool uploadDispatchBuf() {
+    if (_uploadBufLen == 0) return true;
+    if (xSemaphoreTake(_uploadWriteDone, pdMS_TO_TICKS(10000)) != pdTRUE)
+        return false;
+    if (_uploadWriteFailed) {
+        xSemaphoreGive(_uploadWriteDone);
+        return false;
+    }
+    _uploadWriteIdx = _uploadFillIdx;
+    _uploadWriteLen = _uploadBufLen;
+    xTaskNotifyGive(_uploadWriterTask);
+    _uploadFillIdx ^= 1;
+    _uploadBufLen   = 0;
+    return true;
+}
+
+// ==========================================================================
+//  Storage stats cache
+// ==========================================================================
+// LittleFS.usedBytes() walks the allocator, which gets slow as the
+// filesystem fills.  Cache the totals and refresh only after an upload or
+// delete has actually touched flash.
+
+static size_t _fsTotalBytes = 0;
+static size_t _fsUsedBytes  = 0;
+static bool   _fsStatsDirty = true;
+
+static void storageStatsRefresh() {
+    if (!_fsStatsDirty) return;
+    _fsTotalBytes = LittleFS.totalBytes();
+    _fsUsedBytes  = LittleFS.usedBytes();
+    _fsStatsDirty = false;
+}
+
+static void storageStatsMarkDirty() {
+    _fsStatsDirty = true;
+}
+
 // ==========================================================================
 //  Path sanitization (prevent path traversal)
 // ==========================================================================
@@ -62,14 +171,44 @@ static String normalizeQgifPath(const String &url) {
 //  Helpers
 // ==========================================================================
 
-// Serve a file from LittleFS with the given content type.
+// Serve a static asset from LittleFS with the given content type.
+// The filesystem image carries the text assets pre-gzipped (.gz siblings,
+// scripts/gzip_littlefs.py); AsyncFileResponse picks those up and sets
+// Content-Encoding itself when the plain path is absent.  Assets only
+// change with a firmware/filesystem flash, so the ETag is the firmware
+// version plus file size -- a repeat visit revalidates with If-None-Match
+// and gets an empty 304 instead of re-downloading jszip and friends.
 static void serveFile(AsyncWebServerRequest *request,
                       const char *path, const char *contentType) {
-    if (LittleFS.exists(path)) {
-        request->send(LittleFS, path, contentType);
-    } else {
+    String gzPath = String(path) + ".gz";
+    bool plain = LittleFS.exists(path);
+    bool gz    = !plain && LittleFS.exists(gzPath);
+    if (!plain && !gz) {
         request->send(404, "text/plain", "File not found");
+        return;
+    }
+
+    size_t size = 0;
+    {
+        File f = LittleFS.open(gz ? gzPath.c_str() : path, "r");
+        if (f) { size = f.size(); f.close(); }
+    }
+    char etag[48];
+    snprintf(etag, sizeof(etag), "\"%s-%u\"", kQbitVersion, (unsigned)size);
+
+    if (request->hasHeader("If-None-Match") &&
+        request->getHeader("If-None-Match")->value() == etag) {
+        AsyncWebServerResponse *resp = request->beginResponse(304);
+        resp->addHeader("ETag", etag);
+        request->send(resp);
+        return;
     }
+
+    AsyncWebServerResponse *resp =
+        request->beginResponse(LittleFS, path, contentType);
+    resp->addHeader("ETag", etag);
+    resp->addHeader("Cache-Control", "no-cache");  // always revalidate; 304 is cheap
+    request->send(resp);
 }
 
 // ==========================================================================
@@ -109,47 +248,397 @@ static void handleFavicon(AsyncWebServerRequest *request) {
 //  Handlers -- REST API
 // ==========================================================================
 
+// Per-request state for the chunked /api/list stream.  Allocated into
+// request->_tempObject so the request destructor frees it even when the
+// client disconnects mid-stream.
+struct ListStreamState {
+    uint8_t pos;          // next index entry to emit
+    uint8_t phase;        // 0 = '[' pending, 1 = entries, 2 = ']' pending, 3 = done
+    uint8_t pendLen;      // bytes staged in pend[]
+    uint8_t pendOff;      // bytes of pend[] already copied out
+    char    current[64];  // currently playing file (snapshot at request time)
+    char    pend[160];    // one fully formatted JSON entry
+};
+
+// Append 'src' to 'dst' as a JSON string body (escapes quote/backslash/control
+// chars).  Returns the new write position.
+static size_t jsonEscapeAppend(char *dst, size_t cap, size_t at, const char *src) {
+    for (; *src && at + 6 < cap; src++) {
+        char c = *src;
+        if (c == '"' || c == '\\') {
+            dst[at++] = '\\';
+            dst[at++] = c;
+        } else if ((uint8_t)c >= 0x20) {
+            dst[at++] = c;
+        }
+    }
+    dst[at] = '\0';
+    return at;
+}
+
+// Streams the file list straight from the persistent .qgif index over a
+// chunked response: each callback invocation formats as many complete
+// entries as fit in the TCP window, so no multi-KB String is ever built
+// in the async_tcp task.
 static void handleList(AsyncWebServerRequest *request) {
-    StaticJsonDocument<2048> doc;
-    JsonArray arr = doc.to<JsonArray>();
-    File root = LittleFS.open("/");
-    if (root && root.isDirectory()) {
-        String current = gifPlayerGetCurrentFile();
-        File f = root.openNextFile();
-        while (f) {
-            String name = String(f.name());
-            size_t sz   = f.size();
-            f.close();
-            if (name.startsWith("/")) name = name.substring(1);
-            if (name.endsWith(".qgif")) {
-                JsonObject obj = arr.add<JsonObject>();
-                obj["name"]    = name;
-                obj["size"]    = sz;
-                obj["playing"] = (name == current);
+    ListStreamState *st = (ListStreamState *)calloc(1, sizeof(ListStreamState));
+    if (!st) {
+        request->send(500, "application/json", "{\"error\":\"Out of memory\"}");
+        return;
+    }
+    strlcpy(st->current, gifPlayerGetCurrentFile().c_str(), sizeof(st->current));
+    request->_tempObject = st;
+
+    AsyncWebServerResponse *res = request->beginChunkedResponse(
+        "application/json",
+        [st](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+            (void)index;
+            size_t out = 0;
+            while (out < maxLen) {
+                // Drain the staged entry first (it may span TCP windows)
+                if (st->pendOff < st->pendLen) {
+                    size_t n = st->pendLen - st->pendOff;
+                    if (n > maxLen - out) n = maxLen - out;
+                    memcpy(buffer + out, st->pend + st->pendOff, n);
+                    st->pendOff += n;
+                    out += n;
+                    continue;
+                }
+                st->pendOff = st->pendLen = 0;
+
+                if (st->phase == 0) {
+                    st->pend[0] = '[';
+                    st->pendLen = 1;
+                    st->phase   = 1;
+                } else if (st->phase == 1) {
+                    char name[64];
+                    if (!gifPlayerIndexEntry(st->pos, name, sizeof(name))) {
+                        st->phase = 2;
+                        continue;
+                    }
+                    st->pos++;
+                    File f = LittleFS.open(String("/") + name, "r");
+                    size_t sz = f ? f.size() : 0;
+                    if (f) f.close();
+                    size_t at = 0;
+                    if (st->pos > 1) st->pend[at++] = ',';
+                    at += strlcpy(st->pend + at, "{\"name\":\"", sizeof(st->pend) - at);
+                    at  = jsonEscapeAppend(st->pend, sizeof(st->pend), at, name);
+                    at += snprintf(st->pend + at, sizeof(st->pend) - at,
+                                   "\",\"size\":%u,\"playing\":%s}", (unsigned)sz,
+                                   strcmp(name, st->current) == 0 ? "true" : "false");
+                    st->pendLen = (uint8_t)at;
+                } else if (st->phase == 2) {
+                    st->pend[0] = ']';
+                    st->pendLen = 1;
+                    st->phase   = 3;
+                } else {
+                    break;  // phase 3: returning 0 on the next call ends the stream
+                }
             }
-            f = root.openNextFile();
+            return out;
+        });
+    request->send(res);
+}
+
+static void handleStats(AsyncWebServerRequest *request) {
+    StaticJsonDocument<768> doc;
+    perfStatsFillJson(doc);
+    String json;
+    serializeJson(doc, json);
+    request->send(200, "application/json", json);
+}
+
+// GET /api/log -- retained tail of the RAM log ring (qlog), oldest first.
+static void handleLog(AsyncWebServerRequest *request) {
+    char *buf = (char *)qheapAlloc(QHEAP_WEB, 4096 + 1);
+    if (!buf) {
+        request->send(503, "text/plain", "out of memory");
+        return;
+    }
+    qlogSnapshot(buf, 4096);
+    request->send(200, "text/plain", buf);
+    qheapFree(buf);
+}
+
+// GET /api/trace -- recent hot-path spans (see src/qtrace.h) as a JSON
+// timeline, oldest first, for flamegraph-style offline viewing.
+static void handleTrace(AsyncWebServerRequest *request) {
+    char *buf = (char *)qheapAlloc(QHEAP_WEB, 8192 + 1);
+    if (!buf) {
+        request->send(503, "text/plain", "out of memory");
+        return;
+    }
+    qtraceSnapshotJson(buf, 8192);
+    request->send(200, "application/json", buf);
+    qheapFree(buf);
+}
+
+// GET /api/heap -- tagged heap accounting (see src/qheap.h): global free/
+// min/largest-block plus live, peak and alloc/free counts per subsystem.
+static void handleHeap(AsyncWebServerRequest *request) {
+    StaticJsonDocument<512> doc;
+    qheapFillJson(doc);
+    String json;
+    serializeJson(doc, json);
+    request->send(200, "application/json", json);
+}
+
+// GET /api/bench -- on-device micro-benchmark: timed loops of the real
+// pipeline stages on the real hardware, for A/B-ing firmware builds in the
+// field.  The CPU-side loops (render core transpose, LittleFS sequential
+// frame reads, qgif header parse) run right here on scratch buffers; the
+// two panel-touching stages (rotateBuffer180, u8g2.sendBuffer over I2C)
+// are handed to the display task, which owns the live buffer and the bus,
+// and joined below.  Reports us/op per stage plus the max full-pipeline
+// FPS (read + render + rotate + send per frame) this build can sustain.
+#define BENCH_RENDER_ITERS 64
+#define BENCH_HDR_ITERS    16
+
+static bool qgifValidateFile(const String &path, String &err);   // defined with the upload pipeline below
+
+static void handleBench(AsyncWebServerRequest *request) {
+    displayBenchRequest();   // panel half runs on the display task meanwhile
+
+    static uint8_t _benchFrame[QGIF_FRAME_SIZE];
+    static uint8_t _benchPages[QGIF_FRAME_SIZE];
+    for (size_t i = 0; i < sizeof(_benchFrame); i++)
+        _benchFrame[i] = (uint8_t)(i * 31 + (i >> 3));
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < BENCH_RENDER_ITERS; i++)
+        renderCoreFrameToPages(_benchFrame, _benchPages, 0xFF, false);
+    uint32_t renderUs = (uint32_t)((esp_timer_get_time() - t0) / BENCH_RENDER_ITERS);
+
+    // FS stages need a real .qgif; 0 when the library is empty.
+    uint32_t fsReadUs   = 0;   // per frame-sized (1 KB) sequential read
+    uint32_t hdrParseUs = 0;
+    String name = gifPlayerGetFirstFile();
+    if (name.length() > 0) {
+        String path = "/" + name;
+        File f = LittleFS.open(path, "r");
+        if (f) {
+            uint32_t chunks = 0;
+            t0 = esp_timer_get_time();
+            while (f.read(_benchPages, sizeof(_benchPages)) == sizeof(_benchPages))
+                chunks++;
+            if (chunks > 0)
+                fsReadUs = (uint32_t)((esp_timer_get_time() - t0) / chunks);
+            f.close();
         }
-        root.close();
+        String err;
+        t0 = esp_timer_get_time();
+        for (int i = 0; i < BENCH_HDR_ITERS; i++) qgifValidateFile(path, err);
+        hdrParseUs = (uint32_t)((esp_timer_get_time() - t0) / BENCH_HDR_ITERS);
     }
+
+    // Join the display-task half (it serves the request within one loop pass
+    // unless a game is pinning it; give it a couple of seconds).
+    uint32_t rotateUs = 0, sendUs = 0;
+    for (int i = 0; i < 200 && !displayBenchResult(&rotateUs, &sendUs); i++)
+        vTaskDelay(pdMS_TO_TICKS(10));
+
+    StaticJsonDocument<256> doc;
+    doc["renderUs"]   = renderUs;
+    doc["rotateUs"]   = rotateUs;
+    doc["sendUs"]     = sendUs;
+    doc["fsReadUs"]   = fsReadUs;
+    doc["hdrParseUs"] = hdrParseUs;
+    uint32_t frameUs = fsReadUs + renderUs + rotateUs + sendUs;
+    doc["maxFps"] = frameUs ? (uint32_t)(1000000UL / frameUs) : 0;
     String json;
     serializeJson(doc, json);
     request->send(200, "application/json", json);
 }
 
 static void handleStorage(AsyncWebServerRequest *request) {
+    storageStatsRefresh();
     StaticJsonDocument<128> doc;
-    doc["total"] = LittleFS.totalBytes();
-    doc["used"]  = LittleFS.usedBytes();
-    doc["free"]  = LittleFS.totalBytes() - LittleFS.usedBytes();
+    doc["total"] = _fsTotalBytes;
+    doc["used"]  = _fsUsedBytes;
+    doc["free"]  = _fsTotalBytes - _fsUsedBytes;
     String json;
     serializeJson(doc, json);
     request->send(200, "application/json", json);
 }
 
+// Reopen a freshly written file and check it carries a plausible .qgif
+// header.  Shared by the single-file and batch upload paths.
+static bool qgifValidateFile(const String &path, String &err) {
+    File vf = LittleFS.open(path, "r");
+    if (!vf) {
+        err = "Cannot reopen file";
+        return false;
+    }
+    uint8_t hdr[QGIF2_HEADER_SIZE];
+    size_t  n  = vf.read(hdr, QGIF2_HEADER_SIZE);
+    vf.close();
+    bool v2 = (n >= 2 && hdr[0] == QGIF2_MAGIC0 && hdr[1] == QGIF2_MAGIC1);
+    if (n < (size_t)(v2 ? QGIF2_HEADER_SIZE : QGIF_HEADER_SIZE)) {
+        err = "File too small";
+        return false;
+    }
+    uint8_t  fc = v2 ? hdr[2] : hdr[0];
+    uint16_t w  = v2 ? (hdr[3] | ((uint16_t)hdr[4] << 8))
+                     : (hdr[1] | ((uint16_t)hdr[2] << 8));
+    uint16_t h  = v2 ? (hdr[5] | ((uint16_t)hdr[6] << 8))
+                     : (hdr[3] | ((uint16_t)hdr[4] << 8));
+    if (fc == 0 || w != QGIF_FRAME_WIDTH || h != QGIF_FRAME_HEIGHT) {
+        err = "Invalid .qgif format (bad header)";
+        return false;
+    }
+    return true;
+}
+
+// ==========================================================================
+//  Thumbnail sidecar (/.qgif.thm)
+// ==========================================================================
+//  Browsing a 100-file library used to mean downloading whole .qgif files
+//  just to see what they are.  Every upload now extracts frame 0,
+//  downscales it 4x to a 32x16 packed bitmap and upserts it into a
+//  fixed-slot sidecar file; /api/thumbs serves the sidecar verbatim, so
+//  the dashboard renders previews for the whole library in one ~KB
+//  transfer.  Slot = 44-byte NUL-padded basename (same cap as the gif
+//  index) + 64 thumb bytes; deleted entries are tombstoned (name[0] = 0)
+//  and reused by later uploads -- clients skip tombstones.  Thumb
+//  polarity matches qgif frames: bit value 0 = lit, row-major MSB-first.
+
+#define THUMB_PATH     "/.qgif.thm"
+#define THUMB_W        32
+#define THUMB_H        16
+#define THUMB_BYTES    ((THUMB_W / 8) * THUMB_H)       // 64
+#define THUMB_NAME_LEN 44
+#define THUMB_SLOT_LEN (THUMB_NAME_LEN + THUMB_BYTES)  // 108
+
+// 4x4 box downscale.  A block goes lit at >= 4 of 16 source pixels so the
+// 1-2 px line art most animations are drawn with survives, while isolated
+// dither pixels drop out.
+static void thumbDownscale(const uint8_t *frame, uint8_t *out) {
+    memset(out, 0xFF, THUMB_BYTES);   // all dark (qgif: 1 = dark)
+    for (uint8_t ty = 0; ty < THUMB_H; ty++) {
+        for (uint8_t tx = 0; tx < THUMB_W; tx++) {
+            uint8_t lit = 0;
+            for (uint8_t dy = 0; dy < 4; dy++) {
+                const uint8_t *row = frame + ((uint16_t)ty * 4 + dy) * 16;
+                for (uint8_t dx = 0; dx < 4; dx++) {
+                    uint8_t x = tx * 4 + dx;
+                    if (!(row[x >> 3] & (0x80 >> (x & 7)))) lit++;
+                }
+            }
+            if (lit >= 4)
+                out[ty * (THUMB_W / 8) + (tx >> 3)] &= (uint8_t)~(0x80 >> (tx & 7));
+        }
+    }
+}
+
+// Read frame 0 (always a keyframe, see gif_types.h) into 'frame'.
+static bool thumbExtractFrame0(const String &path, uint8_t *frame) {
+    File f = LittleFS.open(path, "r");
+    if (!f) return false;
+    uint8_t hdr[QGIF2_HEADER_SIZE];
+    if (f.read(hdr, QGIF2_HEADER_SIZE) < QGIF_HEADER_SIZE) {
+        f.close();
+        return false;
+    }
+    bool    v2 = (hdr[0] == QGIF2_MAGIC0 && hdr[1] == QGIF2_MAGIC1);
+    uint8_t fc = v2 ? hdr[2] : hdr[0];
+    bool    ok = false;
+    if (!v2) {
+        ok = f.seek(QGIF_HEADER_SIZE + 2u * fc) &&
+             f.read(frame, QGIF_FRAME_SIZE) == QGIF_FRAME_SIZE;
+    } else if (f.seek(QGIF2_HEADER_SIZE + 2u * fc)) {
+        uint8_t fh[QGIF2_FRAME_HDR_SIZE];
+        if (f.read(fh, sizeof(fh)) == sizeof(fh)) {
+            uint16_t plen = fh[1] | ((uint16_t)fh[2] << 8);
+            if (fh[0] & QGIF2_FLAG_RAW) {
+                ok = plen == QGIF_FRAME_SIZE &&
+                     f.read(frame, QGIF_FRAME_SIZE) == QGIF_FRAME_SIZE;
+            } else {
+                QgifRleState st;
+                qgifRleInit(&st);
+                uint8_t chunk[256];
+                ok = true;
+                while (plen > 0 && ok) {
+                    uint16_t want = plen > sizeof(chunk) ? (uint16_t)sizeof(chunk) : plen;
+                    if (f.read(chunk, want) != want ||
+                        !qgifRleChunk(&st, chunk, want, frame, false))
+                        ok = false;
+                    plen -= want;
+                }
+                ok = ok && qgifRleComplete(&st);
+            }
+        }
+    }
+    f.close();
+    return ok;
+}
+
+// Generate and upsert the thumbnail for a freshly written file.  Best
+// effort: a failure just leaves the file without a preview.
+static void thumbStore(const String &basename) {
+    if (basename.length() == 0 || basename.length() >= THUMB_NAME_LEN) return;
+    uint8_t *frame = (uint8_t *)qheapAlloc(QHEAP_WEB, QGIF_FRAME_SIZE);
+    if (!frame) return;
+    bool ok = thumbExtractFrame0("/" + basename, frame);
+    uint8_t slot[THUMB_SLOT_LEN];
+    if (ok) {
+        memset(slot, 0, THUMB_NAME_LEN);
+        strlcpy((char *)slot, basename.c_str(), THUMB_NAME_LEN);
+        thumbDownscale(frame, slot + THUMB_NAME_LEN);
+    }
+    qheapFree(frame);
+    if (!ok) return;
+
+    File tf = LittleFS.open(THUMB_PATH, "r+");
+    if (!tf) tf = LittleFS.open(THUMB_PATH, "w+");
+    if (!tf) return;
+    // Overwrite the file's existing slot or the first tombstone; append
+    // when neither exists.
+    uint8_t  cur[THUMB_NAME_LEN];
+    uint32_t pos = 0, freeAt = UINT32_MAX, writeAt = UINT32_MAX;
+    while (tf.seek(pos) && tf.read(cur, sizeof(cur)) == sizeof(cur)) {
+        if (cur[0] == '\0') {
+            if (freeAt == UINT32_MAX) freeAt = pos;
+        } else if (strncmp((const char *)cur, (const char *)slot, THUMB_NAME_LEN) == 0) {
+            writeAt = pos;
+            break;
+        }
+        pos += THUMB_SLOT_LEN;
+    }
+    if (writeAt == UINT32_MAX) writeAt = (freeAt != UINT32_MAX) ? freeAt : pos;
+    if (tf.seek(writeAt)) tf.write(slot, sizeof(slot));
+    tf.close();
+}
+
+// Tombstone the slot of a deleted file (no-op when it has none).
+static void thumbRemove(const String &basename) {
+    File tf = LittleFS.open(THUMB_PATH, "r+");
+    if (!tf) return;
+    uint8_t  cur[THUMB_NAME_LEN];
+    uint32_t pos = 0;
+    while (tf.seek(pos) && tf.read(cur, sizeof(cur)) == sizeof(cur)) {
+        if (strncmp((const char *)cur, basename.c_str(), THUMB_NAME_LEN) == 0) {
+            uint8_t z = 0;
+            if (tf.seek(pos)) tf.write(&z, 1);
+            break;
+        }
+        pos += THUMB_SLOT_LEN;
+    }
+    tf.close();
+}
+
 static void handleUploadDone(AsyncWebServerRequest *request) {
     StaticJsonDocument<256> doc;
     if (_uploadOk) {
-        doc["ok"] = true;
+        unsigned long ms = _uploadEndMs - _uploadStartMs;
+        if (ms == 0) ms = 1;
+        doc["ok"]    = true;
+        doc["bytes"] = _uploadBytes;
+        doc["ms"]    = ms;
+        doc["kbps"]  = (uint32_t)((_uploadBytes * 8UL) / ms);  // kbit/s
+        if (_uploadDedup) doc["skipped"] = true;  // hash matched, nothing written
+        Serial.printf("Upload: %u bytes in %lu ms (%lu kbit/s)\n",
+                      (unsigned)_uploadBytes, ms,
+                      (unsigned long)((_uploadBytes * 8UL) / ms));
     } else {
         doc["error"] = _uploadError;
     }
@@ -166,11 +655,23 @@ static void handleUploadDone(AsyncWebServerRequest *request) {
 static void handleUploadData(AsyncWebServerRequest *request,
                              const String &filename, size_t index,
                              uint8_t *data, size_t len, bool final) {
+    powerGovernorNoteUpload();  // full radio performance while chunks flow
+
     // --- Start of upload (first chunk, index == 0) ---
     if (index == 0) {
         _uploadOk    = true;
+        _uploadDedup = false;
+        _uploadHash  = FNV1A_INIT;
         _uploadError = "";
 
+        // Reset the write pipeline (waits out any write left by an aborted upload)
+        uploadJoinWriter();
+        _uploadBufLen      = 0;
+        _uploadFillIdx     = 0;
+        _uploadWriteFailed = false;
+        _uploadBytes       = 0;
+        _uploadStartMs     = millis();
+
         // Validate extension
         if (!filename.endsWith(".qgif")) {
             _uploadOk    = false;
@@ -188,8 +689,24 @@ static void handleUploadData(AsyncWebServerRequest *request,
             return;
         }
 
+        // Content-hash dedup: when the client sends ?hash= (hex FNV-1a)
+        // and it matches the stored hash for this name, skip the flash
+        // write entirely.  The body still arrives on this connection;
+        // provisioning scripts are expected to check /api/files/hashes
+        // first so identical files are never sent at all -- this is the
+        // backstop for clients that upload blindly.
+        if (request->hasParam("hash")) {
+            uint32_t want = (uint32_t)strtoul(
+                request->getParam("hash")->value().c_str(), nullptr, 16);
+            if (want != 0 && want == gifPlayerIndexHash(basename)) {
+                _uploadDedup = true;
+                return;
+            }
+        }
+
         // Rough free-space check (exact size unknown at this point)
-        size_t freeBytes = LittleFS.totalBytes() - LittleFS.usedBytes();
+        storageStatsRefresh();
+        size_t freeBytes = _fsTotalBytes - _fsUsedBytes;
         if (freeBytes < 2048) {
             _uploadOk    = false;
             _uploadError = "Insufficient storage -- delete some files first";
@@ -203,17 +720,45 @@ static void handleUploadData(AsyncWebServerRequest *request,
         }
     }
 
-    // --- Write data ---
+    // --- Stage data (flash writes happen on the writer task) ---
     if (_uploadOk && _uploadFile && len > 0) {
-        if (_uploadFile.write(data, len) != len) {
-            _uploadOk    = false;
-            _uploadError = "Write failed -- storage may be full";
+        _uploadHash = fnv1aUpdate(_uploadHash, data, len);
+        size_t off = 0;
+        while (off < len) {
+            size_t n = UPLOAD_BUF_SIZE - _uploadBufLen;
+            if (n > len - off) n = len - off;
+            memcpy(_uploadBuf[_uploadFillIdx] + _uploadBufLen, data + off, n);
+            _uploadBufLen += n;
+            off           += n;
+            if (_uploadBufLen == UPLOAD_BUF_SIZE && !uploadDispatchBuf()) {
+                _uploadOk    = false;
+                _uploadError = "Write failed -- storage may be full";
+                break;
+            }
         }
+        _uploadBytes += off;
     }
 
     // --- End of upload (last chunk) ---
     if (final) {
+        if (_uploadDedup) {
+            _uploadEndMs = millis();
+            return;       // file untouched; handleUploadDone reports skipped
+        }
+        // Flush the partial staging buffer and wait for the writer to drain
+        // before touching the file from this task again.
+        if (_uploadOk && _uploadFile && !uploadDispatchBuf()) {
+            _uploadOk    = false;
+            _uploadError = "Write failed -- storage may be full";
+        }
+        if (!uploadJoinWriter() && _uploadOk) {
+            _uploadOk    = false;
+            _uploadError = "Write failed -- storage may be full";
+        }
+        _uploadEndMs = millis();
+
         if (_uploadFile) _uploadFile.close();
+        storageStatsMarkDirty();
 
         int lastSlash = filename.lastIndexOf('/');
         String basename = lastSlash >= 0 ? filename.substring(lastSlash + 1) : filename;
@@ -231,38 +776,296 @@ static void handleUploadData(AsyncWebServerRequest *request,
         }
 
         // Validate .qgif header
-        File vf = LittleFS.open(path, "r");
-        if (!vf) {
+        if (!qgifValidateFile(path, _uploadError))
             _uploadOk = false;
-            _uploadError = "Cannot reopen file";
-        } else {
-            uint8_t hdr[QGIF_HEADER_SIZE];
-            if (vf.read(hdr, QGIF_HEADER_SIZE) != QGIF_HEADER_SIZE) {
-                _uploadOk = false;
-                _uploadError = "File too small";
-            } else {
-                uint8_t  fc = hdr[0];
-                uint16_t w  = hdr[1] | ((uint16_t)hdr[2] << 8);
-                uint16_t h  = hdr[3] | ((uint16_t)hdr[4] << 8);
-                if (fc == 0 || w != QGIF_FRAME_WIDTH || h != QGIF_FRAME_HEIGHT) {
-                    _uploadOk    = false;
-                    _uploadError = "Invalid .qgif format (bad header)";
-                }
-            }
-            vf.close();
-        }
 
         if (!_uploadOk) {
             LittleFS.remove(path);
             return;
         }
 
+        gifPlayerIndexAdd(basename);
+        gifPlayerIndexSetHash(basename, _uploadHash);
+        thumbStore(basename);
+
         if (gifPlayerGetCurrentFile().length() == 0)
             gifPlayerSetFile(basename);
     }
 }
 
-// Serve a single .qgif file by name (for backup download; ensures correct binary response)
+// ==========================================================================
+//  Handlers -- Batch ZIP upload (/api/upload_batch)
+// ==========================================================================
+//  One POST with a store-only ZIP body replaces N single-file uploads:
+//  entries are parsed incrementally as body chunks arrive and stream
+//  straight into LittleFS through the same ping-pong writer pipeline as
+//  /api/upload, so provisioning runs at sustained flash write speed with
+//  one connection's worth of HTTP overhead.  Deflated entries and
+//  data-descriptor streams (jszip only emits those with streamFiles:true)
+//  are rejected; non-.qgif entries (directories, __MACOSX junk) are
+//  skipped without aborting the batch.
+
+#define ZIP_LOCAL_SIG   0x04034b50UL
+#define ZIP_CENTRAL_SIG 0x02014b50UL
+#define ZIP_LFH_LEN     26    // local file header after the 4-byte signature
+#define ZIP_FLAG_DESCRIPTOR 0x0008
+
+enum BatchPhase : uint8_t {
+    BATCH_SIG,    // collecting a 4-byte signature
+    BATCH_LFH,    // collecting the 26-byte local file header
+    BATCH_NAME,   // collecting the entry name (+ skipping the extra field)
+    BATCH_DATA,   // streaming entry payload
+    BATCH_DONE,   // central directory reached
+    BATCH_FAIL,
+};
+
+static BatchPhase _batchPhase     = BATCH_FAIL;  // body without index 0 is garbage
+static uint8_t    _batchHdr[ZIP_LFH_LEN];
+static uint8_t    _batchHdrLen    = 0;
+static uint32_t   _batchSig       = 0;
+static uint8_t    _batchSigLen    = 0;
+static char       _batchName[MAX_BASENAME_LEN + 1];
+static uint16_t   _batchNameLen   = 0;   // from the header
+static uint16_t   _batchNameGot   = 0;
+static uint16_t   _batchExtraLeft = 0;
+static uint32_t   _batchDataLeft  = 0;
+static bool       _batchStoring   = false;  // current entry goes to flash
+static uint32_t   _batchHash      = FNV1A_INIT;  // FNV-1a of the current entry
+static uint16_t   _batchFiles     = 0;
+static uint16_t   _batchSkipped   = 0;
+static uint32_t   _batchBytes     = 0;
+static String     _batchError;
+
+static uint16_t zipU16(const uint8_t *p) { return p[0] | ((uint16_t)p[1] << 8); }
+static uint32_t zipU32(const uint8_t *p) {
+    return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void batchFail(const char *why) {
+    if (_batchStoring) {
+        uploadDispatchBuf();
+        uploadJoinWriter();
+        if (_uploadFile) _uploadFile.close();
+        LittleFS.remove(String("/") + _batchName);
+        _batchStoring = false;
+    }
+    _batchPhase = BATCH_FAIL;
+    _batchError = why;
+}
+
+// Local file header + name fully read: decide whether this entry streams
+// to flash or gets discarded.
+static void batchEntryStart() {
+    uint16_t flags  = zipU16(_batchHdr + 2);
+    uint16_t method = zipU16(_batchHdr + 4);
+    _batchDataLeft  = zipU32(_batchHdr + 14);   // compressed size (== stored size)
+    _batchStoring   = false;
+
+    if (flags & ZIP_FLAG_DESCRIPTOR) {
+        batchFail("ZIP uses data descriptors (re-pack without streaming)");
+        return;
+    }
+    if (method != 0) {
+        batchFail("ZIP entry is compressed (store-only ZIPs accepted)");
+        return;
+    }
+
+    _batchName[_batchNameGot] = '\0';
+    String basename = sanitizeFileBasename(String(_batchName));
+    if (basename.length() == 0 || !basename.endsWith(".qgif") ||
+        _batchNameLen > MAX_BASENAME_LEN || _batchDataLeft == 0) {
+        _batchSkipped++;   // directory, junk entry or oversized name
+        return;
+    }
+
+    storageStatsRefresh();
+    if (_fsUsedBytes + _batchDataLeft + 2048 > _fsTotalBytes) {
+        batchFail("Insufficient storage -- delete some files first");
+        return;
+    }
+
+    _uploadFile = LittleFS.open("/" + basename, "w");
+    if (!_uploadFile) {
+        batchFail("Failed to create file");
+        return;
+    }
+    _uploadBufLen      = 0;
+    _uploadFillIdx     = 0;
+    _uploadWriteFailed = false;
+    strlcpy(_batchName, basename.c_str(), sizeof(_batchName));
+    _batchHash    = FNV1A_INIT;
+    _batchStoring = true;
+}
+
+// Entry payload fully streamed: flush, validate and index it.
+static void batchEntryEnd() {
+    if (!_batchStoring) return;
+    bool ok = uploadDispatchBuf() && uploadJoinWriter();
+    _uploadFile.close();
+    _batchStoring = false;
+
+    String basename(_batchName);
+    String path = "/" + basename;
+    String err;
+    if (!ok) {
+        LittleFS.remove(path);
+        batchFail("Write failed -- storage may be full");
+        return;
+    }
+    storageStatsMarkDirty();
+    if (!qgifValidateFile(path, err)) {
+        LittleFS.remove(path);
+        _batchSkipped++;
+        return;
+    }
+    gifPlayerIndexAdd(basename);
+    gifPlayerIndexSetHash(basename, _batchHash);
+    thumbStore(basename);
+    if (gifPlayerGetCurrentFile().length() == 0)
+        gifPlayerSetFile(basename);
+    _batchFiles++;
+}
+
+static void handleBatchBody(AsyncWebServerRequest *request, uint8_t *data,
+                            size_t len, size_t index, size_t total) {
+    (void)request; (void)total;
+    powerGovernorNoteUpload();
+
+    if (index == 0) {
+        uploadJoinWriter();   // wait out any write left by an aborted upload
+        _batchPhase   = BATCH_SIG;
+        _batchSigLen  = 0;
+        _batchStoring = false;
+        _batchFiles   = 0;
+        _batchSkipped = 0;
+        _batchBytes   = 0;
+        _batchError   = "";
+        _uploadStartMs = millis();
+    }
+    _batchBytes += len;
+
+    size_t at = 0;
+    while (at < len) {
+        switch (_batchPhase) {
+            case BATCH_SIG:
+                _batchSig |= (uint32_t)data[at++] << (8 * _batchSigLen++);
+                if (_batchSigLen < 4) break;
+                if (_batchSig == ZIP_LOCAL_SIG) {
+                    _batchPhase  = BATCH_LFH;
+                    _batchHdrLen = 0;
+                } else if (_batchSig == ZIP_CENTRAL_SIG) {
+                    _batchPhase = BATCH_DONE;   // rest of the body is ignored
+                } else {
+                    batchFail("Not a ZIP file");
+                }
+                _batchSig    = 0;
+                _batchSigLen = 0;
+                break;
+
+            case BATCH_LFH: {
+                size_t n = ZIP_LFH_LEN - _batchHdrLen;
+                if (n > len - at) n = len - at;
+                memcpy(_batchHdr + _batchHdrLen, data + at, n);
+                _batchHdrLen += n;
+                at           += n;
+                if (_batchHdrLen == ZIP_LFH_LEN) {
+                    _batchNameLen   = zipU16(_batchHdr + 22);
+                    _batchExtraLeft = zipU16(_batchHdr + 24);
+                    _batchNameGot   = 0;
+                    _batchPhase     = BATCH_NAME;
+                }
+                break;
+            }
+
+            case BATCH_NAME:
+                if (_batchNameGot < _batchNameLen) {
+                    char c = (char)data[at++];
+                    if (_batchNameGot < MAX_BASENAME_LEN)
+                        _batchName[_batchNameGot] = c;
+                    _batchNameGot++;
+                } else if (_batchExtraLeft > 0) {
+                    size_t n = _batchExtraLeft;
+                    if (n > len - at) n = len - at;
+                    _batchExtraLeft -= n;
+                    at              += n;
+                } else {
+                    if (_batchNameGot > MAX_BASENAME_LEN)
+                        _batchNameGot = MAX_BASENAME_LEN;
+                    batchEntryStart();
+                    if (_batchPhase != BATCH_FAIL)
+                        _batchPhase = BATCH_DATA;
+                }
+                break;
+
+            case BATCH_DATA: {
+                size_t n = _batchDataLeft;
+                if (n > len - at) n = len - at;
+                if (_batchStoring && n > 0) {
+                    _batchHash = fnv1aUpdate(_batchHash, data + at, n);
+                    size_t off = 0;
+                    while (off < n) {
+                        size_t c = UPLOAD_BUF_SIZE - _uploadBufLen;
+                        if (c > n - off) c = n - off;
+                        memcpy(_uploadBuf[_uploadFillIdx] + _uploadBufLen,
+                               data + at + off, c);
+                        _uploadBufLen += c;
+                        off           += c;
+                        if (_uploadBufLen == UPLOAD_BUF_SIZE && !uploadDispatchBuf()) {
+                            batchFail("Write failed -- storage may be full");
+                            break;
+                        }
+                    }
+                }
+                if (_batchPhase == BATCH_FAIL) break;
+                _batchDataLeft -= n;
+                at             += n;
+                if (_batchDataLeft == 0) {
+                    batchEntryEnd();
+                    if (_batchPhase != BATCH_FAIL)
+                        _batchPhase = BATCH_SIG;
+                }
+                break;
+            }
+
+            case BATCH_DONE:
+            case BATCH_FAIL:
+                at = len;   // swallow the rest of the body
+                break;
+        }
+    }
+
+    if (index + len == total &&
+        _batchPhase != BATCH_DONE && _batchPhase != BATCH_FAIL) {
+        batchFail("Truncated ZIP");
+    }
+}
+
+static void handleBatchDone(AsyncWebServerRequest *request) {
+    StaticJsonDocument<256> doc;
+    if (_batchPhase == BATCH_DONE) {
+        unsigned long ms = millis() - _uploadStartMs;
+        if (ms == 0) ms = 1;
+        doc["ok"]      = true;
+        doc["files"]   = _batchFiles;
+        doc["skipped"] = _batchSkipped;
+        doc["bytes"]   = _batchBytes;
+        doc["ms"]      = ms;
+        Serial.printf("Batch upload: %u files (%u skipped), %u bytes in %lu ms\n",
+                      _batchFiles, _batchSkipped, (unsigned)_batchBytes, ms);
+    } else {
+        doc["error"] = _batchError.length() ? _batchError : "Upload failed";
+    }
+    String json;
+    serializeJson(doc, json);
+    request->send(_batchPhase == BATCH_DONE ? 200 : 400, "application/json", json);
+    _batchPhase = BATCH_FAIL;   // require a fresh index-0 body to start again
+}
+
+// Serve a single .qgif file by name (for backup download; ensures correct
+// binary response).  Honors Range / If-Range so interrupted transfers
+// resume where they stopped, and streams through a per-request file
+// handle captured in the filler callback so several downloads can run
+// concurrently instead of serializing on one shared cursor.
 static void handleGetFile(AsyncWebServerRequest *request) {
     if (!request->hasParam("name")) {
         request->send(400, "text/plain", "Missing name");
@@ -274,11 +1077,130 @@ static void handleGetFile(AsyncWebServerRequest *request) {
         return;
     }
     String path = "/" + name;
-    if (!LittleFS.exists(path)) {
+    File f = LittleFS.open(path, "r");
+    if (!f) {
         request->send(404, "text/plain", "Not found");
         return;
     }
-    request->send(LittleFS, path, "application/octet-stream");
+    uint32_t total = f.size();
+
+    // Validator for If-Range: size + mtime is enough to notice the file
+    // was replaced between the original transfer and the resume attempt.
+    char etag[48];
+    snprintf(etag, sizeof(etag), "\"%u-%lu\"",
+             (unsigned)total, (unsigned long)f.getLastWrite());
+
+    uint32_t start = 0;
+    uint32_t end   = total ? total - 1 : 0;
+    bool ranged    = false;
+    if (request->hasHeader("Range")) {
+        // Only honor the range when If-Range (if present) still matches;
+        // otherwise fall through to a full 200 so the client restarts
+        // cleanly against the new content.
+        bool fresh = !request->hasHeader("If-Range") ||
+                     request->getHeader("If-Range")->value() == etag;
+        const String &r = request->getHeader("Range")->value();
+        int dash = r.indexOf('-', 6);
+        if (fresh && r.startsWith("bytes=") && dash > 0) {
+            String sa = r.substring(6, dash);
+            String sb = r.substring(dash + 1);
+            if (sa.length() == 0 && sb.length() > 0) {
+                // Suffix form "bytes=-N": the last N bytes
+                uint32_t n = (uint32_t)sb.toInt();
+                if (n > total) n = total;
+                start  = total - n;
+                ranged = (n > 0);
+            } else if (sa.length() > 0) {
+                start = (uint32_t)sa.toInt();
+                if (sb.length() > 0) end = (uint32_t)sb.toInt();
+                if (total && end > total - 1) end = total - 1;
+                ranged = true;
+            }
+        }
+        if (ranged && (total == 0 || start >= total || start > end)) {
+            AsyncWebServerResponse *resp =
+                request->beginResponse(416, "text/plain", "Range not satisfiable");
+            char cr[40];
+            snprintf(cr, sizeof(cr), "bytes */%u", (unsigned)total);
+            resp->addHeader("Content-Range", cr);
+            request->send(resp);
+            return;
+        }
+    }
+
+    uint32_t offset  = ranged ? start : 0;
+    uint32_t sendLen = ranged ? (end - start + 1) : total;
+    AsyncWebServerResponse *resp = request->beginResponse(
+        "application/octet-stream", sendLen,
+        [f, offset, sendLen](uint8_t *buf, size_t maxLen, size_t index) mutable -> size_t {
+            if (index >= sendLen) return 0;
+            size_t want = sendLen - index;
+            if (want > maxLen) want = maxLen;
+            if (!f.seek(offset + index)) return 0;
+            return f.read(buf, want);
+        });
+    if (ranged) {
+        resp->setCode(206);
+        char cr[56];
+        snprintf(cr, sizeof(cr), "bytes %u-%u/%u",
+                 (unsigned)start, (unsigned)end, (unsigned)total);
+        resp->addHeader("Content-Range", cr);
+    }
+    resp->addHeader("Accept-Ranges", "bytes");
+    resp->addHeader("ETag", etag);
+    request->send(resp);
+}
+
+// GET /api/files/hashes -- stored content hashes, for provisioning-side
+// dedup: the pusher diffs this list against its local library and uploads
+// only files whose hash differs.  Hash "00000000" means unknown (indexed
+// before hashing existed); treat it as needing upload.
+static void handleHashes(AsyncWebServerRequest *request) {
+    const size_t cap = 10240;   // 128 entries at ~70 bytes fits comfortably
+    char *buf = (char *)qheapAlloc(QHEAP_WEB, cap);
+    if (!buf) {
+        request->send(503, "text/plain", "out of memory");
+        return;
+    }
+    size_t at = 0;
+    buf[at++] = '[';
+    uint8_t n = gifPlayerIndexCount();
+    for (uint8_t i = 0; i < n && at + 80 < cap; i++) {
+        char name[48];
+        if (!gifPlayerIndexEntry(i, name, sizeof(name))) continue;
+        if (at > 1) buf[at++] = ',';
+        at += strlcpy(buf + at, "{\"name\":\"", cap - at);
+        at  = jsonEscapeAppend(buf, cap, at, name);
+        at += snprintf(buf + at, cap - at, "\",\"hash\":\"%08x\"}",
+                       (unsigned)gifPlayerIndexHashAt(i));
+    }
+    buf[at++] = ']';
+    buf[at]   = '\0';
+    request->send(200, "application/json", buf);
+    qheapFree(buf);
+}
+
+// GET /api/thumbs -- the thumbnail sidecar verbatim: fixed 108-byte
+// records (44-byte NUL-padded name + 32x16 packed bitmap, see the
+// sidecar section above).  Records whose name starts with a NUL byte are
+// tombstones and must be skipped by the client.  Streamed straight from
+// flash; ~14 KB worst case at the 128-file index cap.
+static void handleThumbs(AsyncWebServerRequest *request) {
+    File f = LittleFS.open(THUMB_PATH, "r");
+    if (!f) {
+        request->send(204);   // no uploads since the sidecar was introduced
+        return;
+    }
+    size_t total = f.size();
+    AsyncWebServerResponse *resp = request->beginResponse(
+        "application/octet-stream", total,
+        [f, total](uint8_t *buf, size_t maxLen, size_t index) mutable -> size_t {
+            if (index >= total) return 0;
+            if (!f.seek(index)) return 0;
+            return f.read(buf, maxLen);
+        });
+    resp->addHeader("Cache-Control", "no-cache");
+    request->send(resp);
 }
 
 static void handleDelete(AsyncWebServerRequest *request) {
@@ -299,6 +1221,9 @@ static void handleDelete(AsyncWebServerRequest *request) {
     }
 
     LittleFS.remove(path);
+    gifPlayerIndexRemove(name);
+    thumbRemove(name);
+    storageStatsMarkDirty();
 
     if (gifPlayerGetCurrentFile() == name) {
         String next = gifPlayerGetFirstFile();
@@ -576,11 +1501,32 @@ static void handlePostTimezone(AsyncWebServerRequest *request) {
 // ==========================================================================
 //  Web Cam WebSocket (/ws_cam)
 // ==========================================================================
+//  Frames are triple-buffered: the WebSocket task writes into a back slot,
+//  publishes it with an index swap under a short critical section, and the
+//  display task swaps the published slot in for reading.  The 1KB copies
+//  happen outside the lock and never touch a slot the other side owns, so
+//  a frame arriving mid-render is never dropped wholesale.
+//
+//  Wire format: a plain 1024-byte binary message is a full frame (legacy
+//  clients keep working).  A message starting with 0x01 is a delta:
+//  [0x01][8-byte dirty mask over 64 16-byte blocks][dirty blocks in order],
+//  applied to the previous reconstructed frame.  Deltas cut per-frame
+//  bytes dramatically on mostly-static scenes, which is what raises
+//  effective FPS on weak AP links.
+
+#define CAM_DELTA_MAGIC     0x01
+#define CAM_DELTA_BLOCK     16
+#define CAM_DELTA_MASK_LEN  8   // 1024 / 16 blocks = 64 bits
+#define CAM_DELTA_HDR       (1 + CAM_DELTA_MASK_LEN)
 
 static AsyncWebSocket      _camWs("/ws_cam");
-static uint8_t             _camBuf[QGIF_FRAME_SIZE];
+static uint8_t             _camRing[3][QGIF_FRAME_SIZE];
+static uint8_t             _camPrev[QGIF_FRAME_SIZE];  // reconstruction state (producer only)
+static volatile uint8_t    _camBackIdx        = 0;  // producer writes here
+static volatile uint8_t    _camPendingIdx     = 1;  // newest complete frame
+static volatile uint8_t    _camFrontIdx       = 2;  // consumer reads here
+static portMUX_TYPE        _camRingMux        = portMUX_INITIALIZER_UNLOCKED;
 static volatile bool       _camFrameNew       = false;
-static SemaphoreHandle_t   _camMutex          = nullptr;
 static volatile int        _camClientCount    = 0;
 static uint32_t            _camActiveClientId = 0;
 static uint32_t            _camLastFrameMs    = 0;
@@ -596,13 +1542,30 @@ bool webCamHasNewFrame() {
     return _camFrameNew;
 }
 
+// Producer side: publish the reconstructed frame into the ring.
+static void camPushFrame(uint32_t nowMs) {
+    memcpy(_camRing[_camBackIdx], _camPrev, QGIF_FRAME_SIZE);
+    portENTER_CRITICAL(&_camRingMux);
+    uint8_t t       = _camPendingIdx;
+    _camPendingIdx  = _camBackIdx;
+    _camBackIdx     = t;
+    _camFrameNew    = true;
+    portEXIT_CRITICAL(&_camRingMux);
+    _camLastFrameMs = nowMs;
+}
+
 void webCamConsumeFrame(uint8_t *dst) {
-    if (!_camMutex) return;
-    if (xSemaphoreTake(_camMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        memcpy(dst, _camBuf, QGIF_FRAME_SIZE);
-        _camFrameNew = false;
-        xSemaphoreGive(_camMutex);
+    portENTER_CRITICAL(&_camRingMux);
+    if (!_camFrameNew) {
+        portEXIT_CRITICAL(&_camRingMux);
+        return;
     }
+    uint8_t t      = _camFrontIdx;
+    _camFrontIdx   = _camPendingIdx;
+    _camPendingIdx = t;
+    _camFrameNew   = false;
+    portEXIT_CRITICAL(&_camRingMux);
+    memcpy(dst, _camRing[_camFrontIdx], QGIF_FRAME_SIZE);
 }
 
 void webCamDisconnectAll() {
@@ -631,6 +1594,7 @@ static void onCamWsEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
             }
             _camClientCount++;
             _camActiveClientId = client->id();
+            memset(_camPrev, 0, sizeof(_camPrev));  // client must open with a full frame
             if (_onCamStart) _onCamStart();
             break;
         }
@@ -652,20 +1616,35 @@ static void onCamWsEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
                 client->close();
                 break;
             }
-            // Rate-limit and accept only a complete, unfragmented binary message of exactly 1024 bytes
+            // Rate-limit and accept only complete, unfragmented binary messages
             uint32_t nowMs = millis();
-            if (info->final && info->index == 0 &&
-                info->len == QGIF_FRAME_SIZE && info->opcode == WS_BINARY &&
-                len == QGIF_FRAME_SIZE) {
-                if (_camLastFrameMs != 0 && (nowMs - _camLastFrameMs) < 50) {
-                    break;
+            if (!info->final || info->index != 0 || info->opcode != WS_BINARY ||
+                len != info->len) {
+                break;
+            }
+            if (_camLastFrameMs != 0 && (nowMs - _camLastFrameMs) < 50) {
+                break;
+            }
+            if (len == QGIF_FRAME_SIZE) {
+                // Full frame -- also resets the delta reconstruction state
+                memcpy(_camPrev, data, QGIF_FRAME_SIZE);
+                camPushFrame(nowMs);
+            } else if (len >= CAM_DELTA_HDR && data[0] == CAM_DELTA_MAGIC) {
+                // Delta frame: validate length against the dirty-block count
+                size_t nBlocks = 0;
+                for (int i = 0; i < CAM_DELTA_MASK_LEN; i++) {
+                    uint8_t m = data[1 + i];
+                    while (m) { nBlocks += (m & 1); m >>= 1; }
                 }
-                if (_camMutex && xSemaphoreTake(_camMutex, pdMS_TO_TICKS(5)) == pdTRUE) {
-                    memcpy(_camBuf, data, QGIF_FRAME_SIZE);
-                    _camFrameNew = true;
-                    _camLastFrameMs = nowMs;
-                    xSemaphoreGive(_camMutex);
+                if (len != CAM_DELTA_HDR + nBlocks * CAM_DELTA_BLOCK) break;
+                const uint8_t *src = data + CAM_DELTA_HDR;
+                for (int b = 0; b < QGIF_FRAME_SIZE / CAM_DELTA_BLOCK; b++) {
+                    if (data[1 + (b >> 3)] & (1 << (7 - (b & 7)))) {
+                        memcpy(_camPrev + b * CAM_DELTA_BLOCK, src, CAM_DELTA_BLOCK);
+                        src += CAM_DELTA_BLOCK;
+                    }
                 }
+                camPushFrame(nowMs);
             }
             break;
         }
@@ -674,6 +1653,136 @@ static void onCamWsEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
     }
 }
 
+// ==========================================================================
+//  State push WebSocket (/ws_state)
+// ==========================================================================
+//  Replaces the dashboard's steady-state polling of /api/current and
+//  /api/storage: clients get one snapshot on connect, then a broadcast
+//  only when the playing file or storage usage actually changes.  The
+//  change check runs on the network task at 1s cadence and costs two
+//  LittleFS counters and a String compare; with no clients connected it
+//  is a single count() call.
+
+#define STATE_WS_CHECK_MS 1000
+
+static AsyncWebSocket _stateWs("/ws_state");
+static String         _statePrevCurrent;
+static size_t         _statePrevUsed  = 0;
+static size_t         _statePrevTotal = 0;
+static unsigned long  _stateNextCheckMs = 0;
+
+static void stateWsBuild(String &out) {
+  StaticJsonDocument<256> doc;
+  doc["name"]  = _statePrevCurrent;
+  doc["total"] = _statePrevTotal;
+  doc["used"]  = _statePrevUsed;
+  doc["free"]  = _statePrevTotal - _statePrevUsed;
+  serializeJson(doc, out);
+}
+
+static void onStateWsEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
+                           AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  (void)server; (void)arg; (void)data; (void)len;
+  if (type == WS_EVT_CONNECT) {
+    // Full snapshot on connect; deltas from then on.
+    _statePrevCurrent = gifPlayerGetCurrentFile();
+    storageStatsRefresh();
+    _statePrevUsed  = _fsUsedBytes;
+    _statePrevTotal = _fsTotalBytes;
+    String json;
+    stateWsBuild(json);
+    client->text(json);
+  }
+}
+
+void webStateTick() {
+  if (_stateWs.count() == 0) return;
+  unsigned long now = millis();
+  if (now < _stateNextCheckMs) return;
+  _stateNextCheckMs = now + STATE_WS_CHECK_MS;
+  _stateWs.cleanupClients();
+
+  String current = gifPlayerGetCurrentFile();
+  storageStatsRefresh();
+  if (current == _statePrevCurrent &&
+      _fsUsedBytes == _statePrevUsed && _fsTotalBytes == _statePrevTotal) {
+    return;
+  }
+  _statePrevCurrent = current;
+  _statePrevUsed    = _fsUsedBytes;
+  _statePrevTotal   = _fsTotalBytes;
+  String json;
+  stateWsBuild(json);
+  _stateWs.textAll(json);
+}
+
+// ==========================================================================
+//  Screen mirroring over WebSocket (/ws_screen)
+// ==========================================================================
+//  The reverse of /ws_cam: mirrors the device's 1 KB panel buffer to
+//  dashboard clients.  display_helpers stages pages as they go out on the
+//  I2C bus (displayMirrorEnable/Fetch); the tick below broadcasts XOR
+//  deltas against the last sent frame, page-masked, so an idle screen
+//  costs zero bytes and a clock tick costs one page.  Messages:
+//    0x00 + 1024 bytes              -- full frame (sent after a connect)
+//    0x01 + page mask + N*128 bytes -- XOR delta for each set page
+//  Capture is off whenever no client is connected.
+
+#define SCREEN_WS_MIN_MS 100   // cap broadcasts at ~10 fps
+
+static AsyncWebSocket _screenWs("/ws_screen");
+static uint8_t        _screenPrev[1024];          // last broadcast frame
+static volatile bool  _screenSendFull = false;    // a client just connected
+static unsigned long  _screenNextMs   = 0;
+
+static void onScreenWsEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
+                            AwsEventType type, void *arg, uint8_t *data, size_t len) {
+    (void)server; (void)client; (void)arg; (void)data; (void)len;
+    if (type == WS_EVT_CONNECT) {
+        displayMirrorEnable(true);    // idempotent; re-marks all pages dirty
+        _screenSendFull = true;
+    } else if (type == WS_EVT_DISCONNECT) {
+        if (_screenWs.count() == 0) displayMirrorEnable(false);
+    }
+}
+
+void webScreenTick() {
+    if (_screenWs.count() == 0) return;
+    unsigned long now = millis();
+    if (now < _screenNextMs) return;
+
+    static uint8_t snap[1024];
+    static uint8_t msg[2 + 1024];
+    uint8_t mask = displayMirrorFetch(snap);
+
+    if (_screenSendFull) {
+        // Resync everyone on the frame just fetched; deltas resume from it.
+        _screenSendFull = false;
+        memcpy(_screenPrev, snap, sizeof(_screenPrev));
+        msg[0] = 0x00;
+        memcpy(msg + 1, snap, sizeof(snap));
+        _screenWs.cleanupClients();
+        _screenWs.binaryAll(msg, 1 + sizeof(snap));
+        _screenNextMs = now + SCREEN_WS_MIN_MS;
+        return;
+    }
+    if (mask == 0) return;
+
+    msg[0] = 0x01;
+    msg[1] = mask;
+    size_t at = 2;
+    for (uint8_t page = 0; page < 8; page++) {
+        if (!(mask & (1 << page))) continue;
+        const uint16_t off = (uint16_t)page * 128;
+        for (uint16_t i = 0; i < 128; i++)
+            msg[at++] = (uint8_t)(snap[off + i] ^ _screenPrev[off + i]);
+        memcpy(_screenPrev + off, snap + off, 128);
+    }
+    _screenWs.cleanupClients();
+    _screenWs.binaryAll(msg, at);
+    _screenNextMs = now + SCREEN_WS_MIN_MS;
+}
+
 // ==========================================================================
 //  Handlers -- Weather location API
 // ==========================================================================
@@ -824,11 +1933,25 @@ static void handleWeatherSearch(AsyncWebServerRequest *request) {
 // ==========================================================================
 
 void webDashboardInit(AsyncWebServer &server) {
-    // Cam WebSocket: create mutex, register event handler, and add to server
-    _camMutex = xSemaphoreCreateMutex();
+    // Upload write pipeline: writer starts idle with the done-semaphore given
+    if (_uploadWriteDone == nullptr) {
+        _uploadWriteDone = xSemaphoreCreateBinary();
+        xSemaphoreGive(_uploadWriteDone);
+        xTaskCreate(uploadWriterTaskFn, "upWriter", 4096, nullptr, 1,
+                    &_uploadWriterTask);
+    }
+
+    // Cam WebSocket: register event handler and add to server
     _camWs.onEvent(onCamWsEvent);
     server.addHandler(&_camWs);
 
+    // State push WebSocket: playback/storage deltas instead of polling
+    _stateWs.onEvent(onStateWsEvent);
+    server.addHandler(&_stateWs);
+
+    _screenWs.onEvent(onScreenWsEvent);
+    server.addHandler(&_screenWs);
+
     // Dashboard at "/" only when STA is connected; when in AP mode (e.g. after WiFi lost
     // and portal restarted), "/" is left for NetWizard so opening 192.168.4.1/ shows WiFi setup.
     server.on("/", HTTP_GET, handleRoot).setFilter(ON_STA_FILTER);
@@ -843,11 +1966,19 @@ void webDashboardInit(AsyncWebServer &server) {
     // API endpoints
     server.on("/api/list",          HTTP_GET,  handleList);
     server.on("/api/storage",       HTTP_GET,  handleStorage);
+    server.on("/api/stats",         HTTP_GET,  handleStats);
+    server.on("/api/log",           HTTP_GET,  handleLog);
+    server.on("/api/heap",          HTTP_GET,  handleHeap);
+    server.on("/api/trace",         HTTP_GET,  handleTrace);
+    server.on("/api/bench",         HTTP_GET,  handleBench);
     server.on("/api/upload",        HTTP_POST, handleUploadDone, handleUploadData);
+    server.on("/api/upload_batch",  HTTP_POST, handleBatchDone, nullptr, handleBatchBody);
     server.on("/api/delete",        HTTP_POST, handleDelete);
     server.on("/api/play",          HTTP_POST, handlePlay);
     server.on("/api/current",       HTTP_GET,  handleCurrent);
     server.on("/api/file",          HTTP_GET,  handleGetFile);
+    server.on("/api/files/hashes",  HTTP_GET,  handleHashes);
+    server.on("/api/thumbs",        HTTP_GET,  handleThumbs);
     server.on("/api/settings",      HTTP_GET,  handleGetSettings);
     server.on("/api/settings",      HTTP_POST, handlePostSettings);
     server.on("/api/device",        HTTP_GET,  handleGetDevice);
@@ -13,8 +13,11 @@
 //
 // REST API:
 //   GET  /api/list            -- JSON array of .qgif files
+//   GET  /api/files/hashes    -- JSON [{name, hash}] for upload dedup
+//   GET  /api/thumbs          -- frame-0 previews, packed 108-byte records
 //   GET  /api/storage         -- JSON storage info  {total, used, free}
 //   POST /api/upload          -- multipart .qgif upload
+//   POST /api/upload_batch    -- store-only ZIP of .qgif files, streamed
 //   POST /api/delete          -- delete a file      (?name=xxx)
 //   POST /api/play            -- select file to play (?name=xxx)
 //   GET  /api/settings        -- JSON {speed, brightness, volume}
@@ -22,6 +25,9 @@
 //   POST /api/settings?save=1 -- also persist current settings to NVS
 //   GET  /api/timezone        -- JSON {timezone, offset}
 //   POST /api/timezone?tz=    -- set timezone IANA name
+//   GET  /api/bench           -- on-device micro-benchmark (us/op + max FPS)
+//   GET  /api/heap            -- tagged heap accounting (per-subsystem)
+//   GET  /api/trace           -- recent hot-path spans (JSON timeline)
 void webDashboardInit(AsyncWebServer &server);
 
 // Settings callbacks -- implemented by settings.cpp / display_helpers.cpp.
@@ -81,7 +87,10 @@ extern bool weatherScreenRefreshNow();
 //
 //  The browser captures the camera, converts each frame to a 1024-byte
 //  packed monochrome bitmap (QGIF format: bit 0 = lit pixel, bit 1 = dark),
-//  and sends it as a binary WebSocket message to /ws_cam.
+//  and sends it as a binary WebSocket message to /ws_cam.  A message
+//  starting with 0x01 is instead a delta against the previous frame
+//  (8-byte dirty mask over 64 16-byte blocks, then the dirty blocks);
+//  the device reconstructs the full frame before handing it out.
 //
 //  Register callbacks to be notified when the first client connects (onStart)
 //  or the last client disconnects (onStop).  Call before server.begin().
@@ -98,4 +107,25 @@ void webCamConsumeFrame(uint8_t *dst);
 // when the user taps the device to exit cam view).
 void webCamDisconnectAll();
 
+// ==========================================================================
+//  State push over WebSocket (/ws_state)
+// ==========================================================================
+//
+//  Broadcasts {name, total, used, free} to dashboard clients whenever the
+//  playing file or storage usage changes, replacing the frontend's steady
+//  /api/current + /api/storage polling.  Call from the network task loop;
+//  no-op (one count() call) while no client is connected.
+void webStateTick();
+
+// ==========================================================================
+//  Screen mirroring over WebSocket (/ws_screen)
+// ==========================================================================
+//
+//  Mirrors the device's panel content to dashboard clients (the reverse
+//  of /ws_cam): a full 1 KB frame after connect, then page-masked XOR
+//  deltas only when transmitted pages actually changed, capped at ~10 fps.
+//  Call from the network task loop; no-op (one count() call) while no
+//  client is connected, and panel capture is disabled entirely then.
+void webScreenTick();
+
 #endif // WEB_DASHBOARD_H
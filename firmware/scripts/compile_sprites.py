@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+Sprite compiler for the games' shared blitter (src/games/sprite_blit.h).
+
+Converts an XBM bitmap (and an optional mask XBM of the same size) into
+the packed page format the blitter consumes: width, height, then (h+7)/8
+row-strips of w bytes with 8 vertical pixels per byte, bit 0 = top row of
+the strip.  That is the u8g2 page-buffer layout, so the blitter ORs whole
+bytes instead of plotting pixels.
+
+The committed t-rex assets are already in this format (they came packed
+from t-rex-duino); run this manually when adding new art:
+
+    python3 compile_sprites.py bird.xbm --mask bird-mask.xbm -o bird.h
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+def parse_xbm(path):
+    """Return (width, height, pixel) where pixel(x, y) -> 0/1."""
+    with open(path) as f:
+        text = f.read()
+    try:
+        width = int(re.search(r"#define\s+\w+width\s+(\d+)", text).group(1))
+        height = int(re.search(r"#define\s+\w+height\s+(\d+)", text).group(1))
+    except AttributeError:
+        sys.exit("%s: missing XBM width/height defines" % path)
+    body = text[text.index("{"):]
+    data = [int(tok, 16) for tok in re.findall(r"0[xX][0-9a-fA-F]+", body)]
+    stride = (width + 7) // 8
+    if len(data) < stride * height:
+        sys.exit("%s: expected %d data bytes, found %d"
+                 % (path, stride * height, len(data)))
+
+    def pixel(x, y):
+        # XBM packs bits LSB-first: bit 0 = leftmost pixel of the byte
+        return (data[y * stride + x // 8] >> (x % 8)) & 1
+
+    return width, height, pixel
+
+
+def pack(width, height, pixel):
+    """Pack pixels into the page format: strips of vertical bytes."""
+    out = [width, height]
+    for strip in range((height + 7) // 8):
+        for x in range(width):
+            b = 0
+            for bit in range(8):
+                y = strip * 8 + bit
+                if y < height and pixel(x, y):
+                    b |= 1 << bit
+            out.append(b)
+    return out
+
+
+def emit_array(name, values):
+    lines = ["static const uint8_t %s[] PROGMEM = {" % name]
+    for i in range(0, len(values), 16):
+        chunk = ", ".join("0x%02x" % v for v in values[i:i + 16])
+        lines.append(chunk + ("," if i + 16 < len(values) else ""))
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("bitmap", help="XBM source for the sprite bitmap")
+    ap.add_argument("--mask", help="XBM source for the coverage mask "
+                                   "(1 = pixel owned by the sprite)")
+    ap.add_argument("--name", help="C symbol base name "
+                                   "(default: derived from the filename)")
+    ap.add_argument("-o", "--out", help="output header (default: stdout)")
+    args = ap.parse_args()
+
+    base = args.name or re.sub(
+        r"\W", "_", os.path.splitext(os.path.basename(args.bitmap))[0])
+
+    w, h, px = parse_xbm(args.bitmap)
+    out = "/* Generated by scripts/compile_sprites.py from %s -- do not edit. */\n" \
+          % os.path.basename(args.bitmap)
+    out += emit_array(base + "_bitmap", pack(w, h, px))
+
+    if args.mask:
+        mw, mh, mpx = parse_xbm(args.mask)
+        if (mw, mh) != (w, h):
+            sys.exit("mask is %dx%d but bitmap is %dx%d" % (mw, mh, w, h))
+        out += "\n" + emit_array(base + "_mask", pack(mw, mh, mpx))
+
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write(out)
+    else:
+        sys.stdout.write(out)
+
+
+if __name__ == "__main__":
+    main()
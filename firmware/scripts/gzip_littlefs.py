@@ -0,0 +1,50 @@
+"""
+PlatformIO pre-build script: gzip the dashboard's static assets at
+filesystem-image build time.
+
+The text assets (index.html, style.css, script.js, jszip.min.js,
+icon.svg) compress ~4-10x; the web server serves the .gz siblings with
+Content-Encoding: gzip (ESPAsyncWebServer picks them up automatically
+when the plain path is absent).  Already-compressed payloads (.woff2,
+.qgif) are copied through untouched.
+
+The source data/ directory is never modified: assets are staged into the
+build directory and PROJECT_DATA_DIR is repointed there, so `pio run -t
+buildfs` / `uploadfs` transparently produce the compressed image.
+"""
+
+import gzip
+import os
+import shutil
+
+Import("env")
+
+GZIP_EXTS = {".html", ".css", ".js", ".svg", ".json"}
+
+
+def stage_gzipped_data(src_dir, out_dir):
+    if os.path.isdir(out_dir):
+        shutil.rmtree(out_dir)
+    os.makedirs(out_dir)
+    for name in sorted(os.listdir(src_dir)):
+        src = os.path.join(src_dir, name)
+        if not os.path.isfile(src):
+            continue
+        ext = os.path.splitext(name)[1].lower()
+        if ext in GZIP_EXTS:
+            dst = os.path.join(out_dir, name + ".gz")
+            with open(src, "rb") as f_in:
+                data = f_in.read()
+            with open(dst, "wb") as f_out:
+                f_out.write(gzip.compress(data, 9))
+            print("gzip_littlefs: %s %d -> %d bytes"
+                  % (name, len(data), os.path.getsize(dst)))
+        else:
+            shutil.copy2(src, os.path.join(out_dir, name))
+
+
+src_dir = env.subst("$PROJECT_DATA_DIR")
+if os.path.isdir(src_dir):
+    out_dir = os.path.join(env.subst("$BUILD_DIR"), "gzipped_data")
+    stage_gzipped_data(src_dir, out_dir)
+    env.Replace(PROJECT_DATA_DIR=out_dir)
@@ -2,6 +2,7 @@
 //  QBIT -- RTOS primitive instantiation & global objects
 // ==========================================================================
 #include "app_state.h"
+#include "qheap.h"
 
 // RTOS handles (created in main.cpp setup())
 QueueHandle_t       gestureQueue      = nullptr;
@@ -21,3 +22,136 @@ const char *kQbitVersion = (QBIT_VERSION[0] != '\0')
 
 volatile bool updateAvailable = false;
 char         updateAvailableVersion[UPDATE_AVAILABLE_VERSION_LEN] = "";
+
+// ==========================================================================
+//  NetworkEvent pool
+// ==========================================================================
+// Fixed pool + free list guarded by a short critical section; acquire and
+// release are called from the network task, AsyncWeb callbacks and the
+// display task, so the lock must be ISR-grade cheap.
+
+static NetworkEvent  _eventPool[NETWORK_EVENT_POOL_SIZE];
+static NetworkEvent *_eventFree[NETWORK_EVENT_POOL_SIZE];
+static uint8_t       _eventFreeCount  = 0;
+static bool          _eventPoolInit   = false;
+static uint32_t      _eventPoolMisses = 0;
+static portMUX_TYPE  _eventPoolMux    = portMUX_INITIALIZER_UNLOCKED;
+
+NetworkEvent *networkEventAcquire() {
+    NetworkEvent *evt = nullptr;
+    portENTER_CRITICAL(&_eventPoolMux);
+    if (!_eventPoolInit) {
+        for (uint8_t i = 0; i < NETWORK_EVENT_POOL_SIZE; i++)
+            _eventFree[i] = &_eventPool[i];
+        _eventFreeCount = NETWORK_EVENT_POOL_SIZE;
+        _eventPoolInit  = true;
+    }
+    if (_eventFreeCount > 0) {
+        evt = _eventFree[--_eventFreeCount];
+    } else {
+        _eventPoolMisses++;
+    }
+    portEXIT_CRITICAL(&_eventPoolMux);
+    if (evt) memset(evt, 0, sizeof(NetworkEvent));
+    return evt;
+}
+
+void networkEventRelease(NetworkEvent *evt) {
+    if (!evt) return;
+    if (evt->senderBmp) { pokeBitmapFree(evt->senderBmp); evt->senderBmp = nullptr; }
+    if (evt->textBmp)   { pokeBitmapFree(evt->textBmp);   evt->textBmp   = nullptr; }
+    portENTER_CRITICAL(&_eventPoolMux);
+    if (_eventFreeCount < NETWORK_EVENT_POOL_SIZE)
+        _eventFree[_eventFreeCount++] = evt;
+    portEXIT_CRITICAL(&_eventPoolMux);
+}
+
+uint32_t networkEventPoolMisses() {
+    portENTER_CRITICAL(&_eventPoolMux);
+    uint32_t n = _eventPoolMisses;
+    portEXIT_CRITICAL(&_eventPoolMux);
+    return n;
+}
+
+// ==========================================================================
+//  Poke bitmap arena
+// ==========================================================================
+// Poke bitmaps (live poke, in-flight NetworkEvents, history ring copies)
+// used to be plain malloc/free of odd sizes; after a day of pokes the
+// scattered frees fragment the heap until large GIF-upload allocations
+// fail.  All poke bitmap storage now comes from this fixed arena: a
+// first-fit free list over a 20 KB static pool, with adjacent free blocks
+// coalesced on release.  Alloc and free run from the network task, async
+// web callbacks and the display task, so the walk happens under the same
+// kind of short critical section as the event pool above.
+
+#define POKE_ARENA_SIZE 20480
+
+// Block header, 4 bytes so payloads stay 4-byte aligned; size excludes it.
+struct ArenaBlock {
+    uint16_t size;
+    uint16_t used;
+};
+
+static uint8_t      _pokeArena[POKE_ARENA_SIZE] __attribute__((aligned(4)));
+static bool         _pokeArenaInit = false;
+static portMUX_TYPE _pokeArenaMux  = portMUX_INITIALIZER_UNLOCKED;
+
+static inline ArenaBlock *arenaNext(ArenaBlock *b) {
+    return (ArenaBlock *)((uint8_t *)b + sizeof(ArenaBlock) + b->size);
+}
+
+void *pokeBitmapAlloc(size_t len) {
+    if (len == 0 || len > POKE_ARENA_SIZE)
+        return len ? qheapAlloc(QHEAP_POKE, len) : nullptr;
+    size_t need = (len + 3) & ~(size_t)3;
+
+    void *out = nullptr;
+    portENTER_CRITICAL(&_pokeArenaMux);
+    if (!_pokeArenaInit) {
+        ArenaBlock *first = (ArenaBlock *)_pokeArena;
+        first->size    = POKE_ARENA_SIZE - sizeof(ArenaBlock);
+        first->used    = 0;
+        _pokeArenaInit = true;
+    }
+    ArenaBlock *end = (ArenaBlock *)(_pokeArena + POKE_ARENA_SIZE);
+    for (ArenaBlock *b = (ArenaBlock *)_pokeArena; b < end; b = arenaNext(b)) {
+        if (b->used || b->size < need) continue;
+        // Split when the remainder can hold another block
+        if (b->size >= need + sizeof(ArenaBlock) + 4) {
+            ArenaBlock *rest = (ArenaBlock *)((uint8_t *)b + sizeof(ArenaBlock) + need);
+            rest->size = (uint16_t)(b->size - need - sizeof(ArenaBlock));
+            rest->used = 0;
+            b->size    = (uint16_t)need;
+        }
+        b->used = 1;
+        out = (uint8_t *)b + sizeof(ArenaBlock);
+        break;
+    }
+    portEXIT_CRITICAL(&_pokeArenaMux);
+
+    // Arena full: fall back to the heap (tagged) so bursts still succeed
+    return out ? out : qheapAlloc(QHEAP_POKE, len);
+}
+
+void pokeBitmapFree(void *ptr) {
+    if (!ptr) return;
+    uint8_t *p = (uint8_t *)ptr;
+    if (p < _pokeArena || p >= _pokeArena + POKE_ARENA_SIZE) {
+        qheapFree(ptr);  // heap-fallback pointer
+        return;
+    }
+    portENTER_CRITICAL(&_pokeArenaMux);
+    ((ArenaBlock *)(p - sizeof(ArenaBlock)))->used = 0;
+    // Merge every run of adjacent free blocks in one forward pass
+    ArenaBlock *end = (ArenaBlock *)(_pokeArena + POKE_ARENA_SIZE);
+    for (ArenaBlock *b = (ArenaBlock *)_pokeArena; b < end; b = arenaNext(b)) {
+        if (b->used) continue;
+        ArenaBlock *n = arenaNext(b);
+        while (n < end && !n->used) {
+            b->size = (uint16_t)(b->size + sizeof(ArenaBlock) + n->size);
+            n = arenaNext(b);
+        }
+    }
+    portEXIT_CRITICAL(&_pokeArenaMux);
+}
@@ -66,6 +66,7 @@ struct GestureEvent {
     enum Kind {
         POKE,
         POKE_BITMAP,
+        POKE_SUMMARY,     // burst overflow: N pokes coalesced (see network_task)
         CLAIM_REQUEST,
         FRIEND_REQUEST,
         WIFI_STATUS,
@@ -80,7 +81,8 @@ struct GestureEvent {
     char text[65];
     char title[21];
 
-    // Bitmap poke data (heap pointers, receiver must free)
+    // Bitmap poke data (pokeBitmapAlloc'd; networkEventRelease() frees any
+    // still attached, consumers that keep a bitmap must null the field)
     uint8_t *senderBmp;
     uint16_t senderBmpWidth;
     size_t   senderBmpLen;
@@ -90,8 +92,47 @@ struct GestureEvent {
 
     // Status flags
     bool connected;
+
+    // POKE_SUMMARY: how many pokes the burst absorbed
+    uint16_t count;
 };
 
+// ==========================================================================
+//  NetworkEvent pool
+// ==========================================================================
+// networkEventQueue carries NetworkEvent* drawn from this fixed pool instead
+// of copying the ~140-byte struct through the queue.  Ownership is explicit:
+// the producer acquires, fills and sends; on a failed send it must release.
+// The consumer releases after handling -- release also frees any bitmap
+// buffers still attached, so the old "receiver must free" contract cannot
+// leak any more.
+#define NETWORK_EVENT_POOL_SIZE 16
+
+// Take a zeroed event from the pool.  Returns nullptr when the pool is
+// exhausted (counted, see networkEventPoolMisses()).
+NetworkEvent *networkEventAcquire();
+
+// Return an event to the pool, freeing any attached bitmap buffers.
+void networkEventRelease(NetworkEvent *evt);
+
+// Number of acquire calls that failed because the pool was empty.
+uint32_t networkEventPoolMisses();
+
+// ==========================================================================
+//  Poke bitmap arena
+// ==========================================================================
+// All poke bitmap buffers (live poke, NetworkEvent attachments, history
+// copies) are carved from a fixed 20 KB arena with a first-fit free list,
+// so their odd-sized alloc/free churn can never fragment the general heap.
+// When the arena is full the allocator falls back to malloc so bursts
+// still succeed; pokeBitmapFree() routes each pointer back to its origin.
+
+// Allocate a poke bitmap buffer (nullptr on len == 0 or full arena + OOM).
+void *pokeBitmapAlloc(size_t len);
+
+// Release a buffer from pokeBitmapAlloc (arena or malloc fallback).
+void pokeBitmapFree(void *ptr);
+
 // ==========================================================================
 //  Poke history record
 // ==========================================================================
@@ -110,8 +151,8 @@ struct PokeRecord {
     bool     hasBitmaps  = false;
 
     void freeBitmaps() {
-        if (senderBmp) { free(senderBmp); senderBmp = nullptr; }
-        if (textBmp)   { free(textBmp);   textBmp   = nullptr; }
+        if (senderBmp) { pokeBitmapFree(senderBmp); senderBmp = nullptr; }
+        if (textBmp)   { pokeBitmapFree(textBmp);   textBmp   = nullptr; }
         hasBitmaps = false;
         senderBmpW = senderBmpH = 0;
         textBmpW   = textBmpH   = 0;
@@ -4,6 +4,8 @@
 #include "display_helpers.h"
 #include "app_state.h"
 #include "settings.h"
+#include "perf_stats.h"
+#include "render_core.h"
 #include <Wire.h>
 
 // ==========================================================================
@@ -44,6 +46,153 @@ void clearFullGDDRAM() {
     Wire.write(0x21);  Wire.write(0x00);  Wire.write(0x7F);  // col  0-127
     Wire.write(0x22);  Wire.write(0x00);  Wire.write(0x07);  // page 0-7
     Wire.endTransmission();
+
+    displayMarkAllDirty();  // GDDRAM no longer matches the shadow copy
+}
+
+// ==========================================================================
+//  Dirty-page partial flush (paced)
+// ==========================================================================
+// The SSD1306 is organised as 8 pages of 128 columns (128 bytes each).
+// Keeping a shadow copy of the last transmitted buffer lets us skip pages
+// whose content did not change -- a clock tick or a small sprite move then
+// costs one or two pages (~128 bytes) on the I2C bus instead of 1 KB.
+//
+// Transmission is additionally paced: a flush sends at most
+// DISPLAY_FLUSH_BUDGET_PAGES per call (~3 ms of bus time each at 400 kHz)
+// and parks the rest in a pending mask that displayFlushTick() drains on
+// later loop wakes.  A full-frame update used to block the display task
+// for the whole ~25 ms sendBuffer() transfer with gestures and network
+// events sitting unhandled; now the longest blocking window is one burst
+// and the loop handles events between bursts.  (A truly asynchronous
+// transfer via the ESP-IDF i2c_master driver would overlap the bus time
+// entirely, but u8g2 and the raw command helpers here all share the
+// blocking Wire core -- pacing gets most of the responsiveness win
+// without forking the u8g2 HAL.)
+
+#define DISPLAY_PAGE_COUNT 8
+#define DISPLAY_PAGE_BYTES 128
+#define DISPLAY_FLUSH_BUDGET_PAGES 2
+
+static uint8_t _shadowBuf[DISPLAY_PAGE_COUNT * DISPLAY_PAGE_BYTES];
+static bool    _shadowValid = false;
+static uint8_t _pendingMask = 0;    // pages awaiting transmission
+
+// --- Screen mirror staging (/ws_screen) ---
+// Pages are copied here as they go out on the I2C bus, so the mirror is
+// always the panel content, never a half-composed frame.  The web side
+// drains it from the network task; the critical sections keep a page
+// from being fetched half-written.
+static uint8_t          _mirrorBuf[DISPLAY_PAGE_COUNT * DISPLAY_PAGE_BYTES];
+static volatile uint8_t _mirrorDirty   = 0;
+static volatile bool    _mirrorEnabled = false;
+static portMUX_TYPE     _mirrorMux     = portMUX_INITIALIZER_UNLOCKED;
+
+static void mirrorCapture(uint8_t pageMask) {
+    portENTER_CRITICAL(&_mirrorMux);
+    for (uint8_t page = 0; page < DISPLAY_PAGE_COUNT; page++) {
+        if (!(pageMask & (1 << page))) continue;
+        const uint16_t off = (uint16_t)page * DISPLAY_PAGE_BYTES;
+        memcpy(_mirrorBuf + off, _shadowBuf + off, DISPLAY_PAGE_BYTES);
+    }
+    _mirrorDirty |= pageMask;
+    portEXIT_CRITICAL(&_mirrorMux);
+}
+
+void displayMirrorEnable(bool on) {
+    portENTER_CRITICAL(&_mirrorMux);
+    _mirrorEnabled = on;
+    if (on) {
+        memcpy(_mirrorBuf, _shadowBuf, sizeof(_mirrorBuf));
+        _mirrorDirty = 0xFF;   // first fetch carries the whole screen
+    }
+    portEXIT_CRITICAL(&_mirrorMux);
+}
+
+uint8_t displayMirrorFetch(uint8_t *out) {
+    portENTER_CRITICAL(&_mirrorMux);
+    uint8_t mask = _mirrorDirty;
+    _mirrorDirty = 0;
+    memcpy(out, _mirrorBuf, sizeof(_mirrorBuf));
+    portEXIT_CRITICAL(&_mirrorMux);
+    return mask;
+}
+
+void displayMarkAllDirty() {
+    _shadowValid = false;
+    _pendingMask = 0;
+}
+
+// Transmit the changed tile span of one page and sync its shadow copy.
+// updateDisplayArea() works in 8x8 tiles: one page = tile row of 16;
+// within the page only the span that actually changed is sent, so a
+// moving sprite or a patched clock digit costs a few tiles instead of
+// the whole 128-byte page.
+static void sendDirtyPage(uint8_t page) {
+    uint8_t *buf = u8g2.getBufferPtr();
+    const uint16_t off = (uint16_t)page * DISPLAY_PAGE_BYTES;
+    if (memcmp(buf + off, _shadowBuf + off, DISPLAY_PAGE_BYTES) == 0) return;
+    uint8_t lo = 0, hi = DISPLAY_PAGE_BYTES - 1;
+    while (buf[off + lo] == _shadowBuf[off + lo]) lo++;
+    while (buf[off + hi] == _shadowBuf[off + hi]) hi--;
+    uint8_t t0 = lo / 8;
+    uint8_t t1 = hi / 8;
+    u8g2.updateDisplayArea(t0, page, (uint8_t)(t1 - t0 + 1), 1);
+    memcpy(_shadowBuf + off, buf + off, DISPLAY_PAGE_BYTES);
+    if (_mirrorEnabled) mirrorCapture((uint8_t)(1 << page));
+}
+
+// Send up to the per-wake budget of pending pages (low page first).
+static void sendBudget() {
+    uint8_t sent = 0;
+    for (uint8_t page = 0;
+         page < DISPLAY_PAGE_COUNT && sent < DISPLAY_FLUSH_BUDGET_PAGES;
+         page++) {
+        if (!(_pendingMask & (1 << page))) continue;
+        sendDirtyPage(page);
+        _pendingMask &= ~(1 << page);
+        sent++;
+    }
+}
+
+bool displayFlushPending() {
+    return _pendingMask != 0;
+}
+
+void displayFlushTick() {
+    if (_pendingMask) sendBudget();
+}
+
+void displayFlushDirty() {
+    uint8_t *buf = u8g2.getBufferPtr();
+
+    if (!_shadowValid) {
+        // Shadow does not match the panel (boot, raw GDDRAM writes): pay
+        // the one blocking full transfer to re-establish it.
+        u8g2.sendBuffer();
+        memcpy(_shadowBuf, buf, sizeof(_shadowBuf));
+        _shadowValid = true;
+        _pendingMask = 0;
+        if (_mirrorEnabled) mirrorCapture(0xFF);
+        perfStatsCountFrame();
+        return;
+    }
+
+    uint8_t dirtyMask = 0;
+    for (uint8_t page = 0; page < DISPLAY_PAGE_COUNT; page++) {
+        const uint16_t off = (uint16_t)page * DISPLAY_PAGE_BYTES;
+        if (memcmp(buf + off, _shadowBuf + off, DISPLAY_PAGE_BYTES) != 0)
+            dirtyMask |= (1 << page);
+    }
+
+    if (dirtyMask == 0 && _pendingMask == 0) return;
+
+    // Pages still pending from a previous frame are simply re-merged: the
+    // shadow compare above already reflects the latest buffer content, so
+    // they transmit the newest frame when their turn comes.
+    _pendingMask |= dirtyMask;
+    sendBudget();
+    if (dirtyMask) perfStatsCountFrame();
 }
 
 // ==========================================================================
@@ -77,24 +226,123 @@ void setDisplayInvert(bool invert) {
 // ==========================================================================
 //  Rotate U8G2 buffer 180° in-place
 // ==========================================================================
+//  Thin wrapper around renderCoreRotate180() (include/render_core.h,
+//  exercised by the native test env): buf'[i] = bitrev(buf[1023-i]), done
+//  word-wise with a 256-entry bit-reverse table.  Pages that come out
+//  unchanged are still suppressed at transmit time by displayFlushDirty()'s
+//  shadow compare, so no separate dirty integration is needed here.
+//  IRAM: the rotate runs on every flip-mode frame, including right after
+//  upload/NVS flash writes that leave the cache cold (see render_core.h).
 
-void rotateBuffer180() {
+void IRAM_ATTR rotateBuffer180() {
     if (!getFlipMode()) return;  // default R0: only rotate when flip mode is on
+    renderCoreRotate180(u8g2.getBufferPtr(), 1024);
+}
+
+// ==========================================================================
+//  Pre-rendered digit cells (logisoso28 numerals)
+// ==========================================================================
+// Rendering a logisoso28 glyph through u8g2 walks the compressed BDF data
+// pixel by pixel; at one redraw per second the clock and timer screens pay
+// that for eight glyphs each time.  Instead each glyph is drawn once per
+// baseline and its page-aligned column bytes are captured, so steady-state
+// updates become a few-hundred-byte memcpy per changed digit.
+//
+// Cells are captured at the exact vertical position the screens use
+// (baseline-relative), so a blit lands on the same page rows a full drawStr
+// would have touched and needs no bit shifting.
+
+#define DIGIT_CELL_SLOTS  2             // clock (baseline 38) + timer (48)
+#define DIGIT_CELL_GLYPHS 11            // '0'-'9' and ':'
+#define DIGIT_CELL_MAX_W  24            // logisoso28 digit advance is ~16 px
+#define DIGIT_CELL_MAX_PAGES 5          // 28 px can straddle five 8-px pages
+
+struct DigitCellSlot {
+    bool    valid;
+    int16_t baseline;
+    uint8_t page0;                      // first page row of the cells
+    uint8_t pages;                      // page rows per cell (4 or 5)
+    uint8_t width[DIGIT_CELL_GLYPHS];
+    uint8_t bytes[DIGIT_CELL_GLYPHS][DIGIT_CELL_MAX_PAGES * DIGIT_CELL_MAX_W];
+};
+
+static DigitCellSlot _digitSlots[DIGIT_CELL_SLOTS];
+static uint8_t       _digitSlotNext = 0;  // round-robin eviction
+
+static int digitGlyphIndex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c == ':') return 10;
+    return -1;
+}
+
+static DigitCellSlot *digitSlotFind(int16_t baseline) {
+    for (uint8_t i = 0; i < DIGIT_CELL_SLOTS; i++) {
+        if (_digitSlots[i].valid && _digitSlots[i].baseline == baseline)
+            return &_digitSlots[i];
+    }
+    return nullptr;
+}
+
+void digitCellsPrepare(int16_t baseline) {
+    if (digitSlotFind(baseline)) return;
+
+    DigitCellSlot *slot = &_digitSlots[_digitSlotNext];
+    _digitSlotNext = (uint8_t)((_digitSlotNext + 1) % DIGIT_CELL_SLOTS);
+
+    slot->valid    = false;
+    slot->baseline = baseline;
+    slot->page0    = (uint8_t)((baseline - 28) >> 3);
+    slot->pages    = (uint8_t)(((baseline - 1) >> 3) - slot->page0 + 1);
+    if (slot->pages > DIGIT_CELL_MAX_PAGES) slot->pages = DIGIT_CELL_MAX_PAGES;
+
+    const char glyphs[DIGIT_CELL_GLYPHS + 1] = "0123456789:";
     uint8_t *buf = u8g2.getBufferPtr();
-    const uint16_t len = 1024;
+    u8g2.setFont(u8g2_font_logisoso28_tn);
+    u8g2.setDrawColor(1);
 
-    for (uint16_t i = 0; i < len / 2; i++) {
-        uint8_t tmp       = buf[i];
-        buf[i]            = buf[len - 1 - i];
-        buf[len - 1 - i]  = tmp;
+    for (uint8_t g = 0; g < DIGIT_CELL_GLYPHS; g++) {
+        char str[2] = { glyphs[g], '\0' };
+        u8g2.clearBuffer();
+        u8g2.drawStr(0, baseline, str);
+        uint8_t w = u8g2.getStrWidth(str);
+        if (w > DIGIT_CELL_MAX_W) w = DIGIT_CELL_MAX_W;
+        slot->width[g] = w;
+        for (uint8_t p = 0; p < slot->pages; p++) {
+            memcpy(slot->bytes[g] + (size_t)p * DIGIT_CELL_MAX_W,
+                   buf + ((size_t)(slot->page0 + p) * 128), w);
+        }
     }
+    slot->valid = true;
+    Serial.printf("[Display] Digit cells built for baseline %d (%u pages)\n",
+                  baseline, slot->pages);
+}
+
+uint8_t digitCellsCharWidth(int16_t baseline, char c) {
+    DigitCellSlot *slot = digitSlotFind(baseline);
+    int g = digitGlyphIndex(c);
+    if (!slot || g < 0) return 0;
+    return slot->width[g];
+}
 
-    for (uint16_t i = 0; i < len; i++) {
-        uint8_t b = buf[i];
-        b = ((b & 0xF0) >> 4) | ((b & 0x0F) << 4);
-        b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
-        b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
-        buf[i] = b;
+uint8_t digitCellsTextWidth(int16_t baseline, const char *s) {
+    uint16_t w = 0;
+    for (; *s; s++) w += digitCellsCharWidth(baseline, *s);
+    return (uint8_t)(w > 255 ? 255 : w);
+}
+
+void digitCellsBlit(int16_t baseline, uint8_t *frame, const char *s, int16_t x) {
+    DigitCellSlot *slot = digitSlotFind(baseline);
+    if (!slot) return;
+    for (; *s; s++) {
+        int g = digitGlyphIndex(*s);
+        if (g < 0) continue;
+        uint8_t w = slot->width[g];
+        if (x < 0 || x + w > 128) { x += w; continue; }
+        for (uint8_t p = 0; p < slot->pages; p++) {
+            memcpy(frame + ((size_t)(slot->page0 + p) * 128) + x,
+                   slot->bytes[g] + (size_t)p * DIGIT_CELL_MAX_W, w);
+        }
+        x += w;
     }
 }
 
@@ -111,5 +359,8 @@ void showText(const char *l1, const char *l2,
     if (l3) u8g2.drawStr(4, 43, l3);
     if (l4) u8g2.drawStr(4, 58, l4);
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
+    // Callers often block (vTaskDelay) right after showing a message, so
+    // finish the paced transfer instead of leaving pages parked.
+    while (displayFlushPending()) displayFlushTick();
 }
@@ -21,6 +21,65 @@ void setDisplayInvert(bool invert);
 // Rotate the U8G2 frame buffer 180 degrees in-place.
 void rotateBuffer180();
 
+// Send only the display regions that changed since the last flush.
+// Compares the U8G2 buffer against a shadow copy and transmits, per dirty
+// page (8-pixel row), just the changed tile span via updateDisplayArea().
+// At most a small budget of pages is sent per call; the rest are parked
+// in a pending mask so the display loop stays responsive during full-
+// frame updates.  Use this instead of u8g2.sendBuffer() so the shadow
+// copy stays in sync -- the GIF player, clock, timer and games all draw
+// through this.
+void displayFlushDirty();
+
+// Continue a partially transmitted frame: sends up to the per-wake page
+// budget from the pending mask.  Call once per display-loop wake; no-op
+// when nothing is pending.
+void displayFlushTick();
+
+// True while pages from the last flush are still awaiting transmission
+// (the display loop shortens its deadline wait accordingly).
+bool displayFlushPending();
+
+// Invalidate the shadow copy so the next flush retransmits all pages.
+// Call after writing GDDRAM behind U8G2's back (e.g. clearFullGDDRAM).
+void displayMarkAllDirty();
+
+// Screen mirroring (/ws_screen): pages are staged into a mirror copy at
+// the moment they are sent to the panel, so the mirror shows exactly what
+// the OLED shows.  Enable while mirror clients are connected; capture is
+// a 128-byte copy per transmitted page when on, zero cost when off.
+void displayMirrorEnable(bool on);
+
+// Copy the mirror buffer (1 KB, panel layout) into 'out' and return the
+// mask of pages that changed since the previous fetch (0 = no change).
+// Safe to call from the network task.
+uint8_t displayMirrorFetch(uint8_t *out);
+
+// --------------------------------------------------------------------------
+//  Pre-rendered digit cells (u8g2_font_logisoso28_tn)
+// --------------------------------------------------------------------------
+// The clock and timer screens redraw a time string every update even though
+// only one digit changes.  These helpers render '0'-'9' and ':' once per
+// baseline into a small page-aligned cell cache; a screen can then keep its
+// own pre-rotation frame copy and blit just the changed digit cells into it
+// (displayFlushDirty()'s shadow compare keeps the I2C cost proportional).
+
+// Build (or reuse) the glyph cells for 'baseline'.  Two baselines are kept
+// cached at a time.  NOTE: a rebuild draws into the U8G2 buffer, so call
+// this before composing the screen.
+void digitCellsPrepare(int16_t baseline);
+
+// Advance width of a single cached glyph ('0'-'9' or ':'), 0 if unknown.
+uint8_t digitCellsCharWidth(int16_t baseline, char c);
+
+// Summed advance width of a digit/colon string.
+uint8_t digitCellsTextWidth(int16_t baseline, const char *s);
+
+// Blit 's' into 'frame' (pre-rotation U8G2 page layout, 128x64) starting at
+// column 'x'.  Only the glyph cells are written; everything else is left
+// untouched.
+void digitCellsBlit(int16_t baseline, uint8_t *frame, const char *s, int16_t x);
+
 // Show up to 4 lines of 6x13 text on the OLED (rotated 180°).
 void showText(const char *l1, const char *l2 = nullptr,
               const char *l3 = nullptr, const char *l4 = nullptr);
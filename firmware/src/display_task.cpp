@@ -10,10 +10,14 @@
 #include "poke_handler.h"
 #include "network_task.h"
 #include "mqtt_ha.h"
-#include "melodies.h"
+#include "melodies_compiled.h"
+#include "melody_player.h"
 #include "gif_player.h"
 #include "web_dashboard.h"
 #include "timer_ui.h"
+#include "session_snapshot.h"
+#include "power_governor.h"
+#include "qtrace.h"
 #include "games/game_menu.h"
 #include "weather/weather_screen.h"
 #include "games/trex_runner/trex_runner.h"
@@ -21,12 +25,11 @@
 #include "games/car_avoidance/car_avoidance.h"
 
 #include "gif_types.h"
-#include "sys_scx.h"
-#include "sys_idle.h"
+#include "sys_anim.h"
 
-#include <NonBlockingRtttl.h>
 #include <WiFi.h>
 #include <stdio.h>
+#include <esp_timer.h>
 
 // ==========================================================================
 //  Configuration
@@ -89,7 +92,7 @@ static bool          _melodyWasPlaying      = false;
 static bool          _timerAlarmRestoreMute = false;
 static bool          _timerAlarmStarted     = false;
 
-// Cam frame render buffer (owned by display task; gifRenderFrame inverts in-place)
+// Cam frame render buffer (owned by display task)
 static uint8_t       _camRenderBuf[QGIF_FRAME_SIZE];
 
 // Settings menu
@@ -127,6 +130,8 @@ static void enterState(DisplayState newState) {
     _prevState = _state;
     _state = newState;
     _stateEntryMs = millis();
+    powerGovernorOnState(newState);      // radio sleep depth follows the UI
+    sessionSnapshotNoteState(newState);  // debounced NVS snapshot for warm resume
 }
 
 // ==========================================================================
@@ -206,7 +211,7 @@ static void drawSettingsMenu() {
         }
         u8g2.setDrawColor(1);
         rotateBuffer180();
-        u8g2.sendBuffer();
+        displayFlushDirty();
         return;
     }
 
@@ -283,7 +288,7 @@ static void drawSettingsMenu() {
 
     u8g2.setDrawColor(1);
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 static void enterSettingsMenu() {
@@ -308,7 +313,7 @@ static void drawContributeScreen() {
     u8g2.drawStr((128 - (int16_t)u8g2.getStrWidth(line2)) / 2, 43, line2);
     u8g2.drawStr((128 - (int16_t)u8g2.getStrWidth(line3)) / 2, 58, line3);
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 // Terminal-style countdown: title, blank line, "AP in Xs", progress bar. Countdown starts when network declares connection lost.
@@ -382,26 +387,229 @@ static void showPokeHistoryEntry(uint8_t index) {
 // ==========================================================================
 
 static void playBootAnimation() {
+    const AnimatedGIF *boot = sysAnimBoot();
+    if (!boot) return;   // anim partition not flashed, no embedded fallback
+
     uint8_t frameBuf[QGIF_FRAME_SIZE];
 
     if (getBuzzerVolume() > 0) {
-        rtttl::begin(getPinBuzzer(), BOOT_MELODY);
+        melodyBegin(getPinBuzzer(), BOOT_MELODY);
     }
 
-    for (uint8_t f = 0; f < sys_scx_gif.frame_count; f++) {
-        if (getBuzzerVolume() > 0 && rtttl::isPlaying()) {
-            rtttl::play();
+    for (uint8_t f = 0; f < boot->frame_count; f++) {
+        if (getBuzzerVolume() > 0 && melodyIsPlaying()) {
+            melodyTick();
         }
 
-        memcpy_P(frameBuf, sys_scx_gif.frames[f], QGIF_FRAME_SIZE);
-        gifRenderFrame(&u8g2, frameBuf, sys_scx_gif.width, sys_scx_gif.height);
+        memcpy_P(frameBuf, boot->frames[f], QGIF_FRAME_SIZE);
+        gifRenderFrame(&u8g2, frameBuf, boot->width, boot->height);
+
+        // The inter-frame wait doubles as drain time for the paced flush;
+        // without it the pending pages would pile up frame over frame.
+        uint16_t d = boot->delays[f] / BOOT_GIF_SPEED;
+        unsigned long until = millis() + (d > 0 ? d : 1);
+        do {
+            displayFlushTick();
+            vTaskDelay(1);
+        } while ((long)(millis() - until) < 0);
+    }
+
+    melodyStop();
+}
+
+// ==========================================================================
+//  HISTORY_TIME clock screen
+// ==========================================================================
+//  The clock is composed once into a pre-rotation frame copy; while the
+//  screen is showing, the tick path patches only the digit cells that
+//  changed at a minute rollover (display_helpers digit cache) instead of
+//  re-rendering the logisoso28 glyphs, and falls back to a full compose
+//  when the date or AM/PM suffix changes.
+
+#define CLOCK_BASELINE 38
+
+static uint8_t _clockFrame[1024];       // pre-rotation composed screen
+static bool    _clockFrameValid = false;
+static char    _clockDigits[9]  = "";   // time digits the frame shows
+static int16_t _clockCellX[8];          // column of each digit/colon cell
+static String  _clockRawTime;           // full formatted string the frame shows
+static String  _clockDate;
+static String  _clockAmPm;
+
+// Draw (or refresh) the clock.  Pass full=true on entry so the screen is
+// re-established even when nothing changed; the state tick calls with
+// full=false and returns early while the minute holds.
+static void historyTimeDraw(bool full) {
+    String timeStr = timeManagerGetFormatted();
+    String dateStr = timeManagerGetDateFormatted();
+    if (!full && _clockFrameValid &&
+        timeStr == _clockRawTime && dateStr == _clockDate)
+        return;
+
+    String timePart = timeStr;
+    String ampmPart;
+    if (!getTimeFormat24h()) {
+        int sp = timeStr.indexOf(" AM");
+        if (sp < 0) sp = timeStr.indexOf(" PM");
+        if (sp < 0) { sp = timeStr.indexOf("AM"); if (sp < 0) sp = timeStr.indexOf("PM"); }
+        if (sp >= 0) {
+            timePart = timeStr.substring(0, sp);
+            ampmPart = timeStr.substring(sp);
+        }
+    }
+
+    digitCellsPrepare(CLOCK_BASELINE);  // no-op once built (trashes buffer on rebuild)
+
+    // Patch path: same layout, only digits differ
+    bool patch = _clockFrameValid && dateStr == _clockDate &&
+                 ampmPart == _clockAmPm &&
+                 timePart.length() == strlen(_clockDigits) &&
+                 timePart.length() <= 8;
+    for (uint8_t i = 0; patch && i < timePart.length(); i++) {
+        char c = timePart[i];
+        if (c != _clockDigits[i] &&
+            !(c >= '0' && c <= '9' && _clockDigits[i] >= '0' && _clockDigits[i] <= '9'))
+            patch = false;
+    }
+
+    if (patch) {
+        char one[2] = { '\0', '\0' };
+        for (uint8_t i = 0; i < timePart.length(); i++) {
+            if (timePart[i] == _clockDigits[i]) continue;
+            one[0] = timePart[i];
+            digitCellsBlit(CLOCK_BASELINE, _clockFrame, one, _clockCellX[i]);
+        }
+        strlcpy(_clockDigits, timePart.c_str(), sizeof(_clockDigits));
+        _clockRawTime = timeStr;
+        memcpy(u8g2.getBufferPtr(), _clockFrame, sizeof(_clockFrame));
+        rotateBuffer180();
+        displayFlushDirty();
+        return;
+    }
+
+    // Full compose (first draw, date/AM-PM rollover, or format change)
+    u8g2.clearBuffer();
+    u8g2.setFont(u8g2_font_logisoso28_tn);
+    int16_t tw = (int16_t)u8g2.getStrWidth(timePart.c_str());
+    int16_t tx = (128 - tw) / 2;
+    if (tx < 0) tx = 0;
+    u8g2.drawStr((uint8_t)tx, CLOCK_BASELINE, timePart.c_str());
+
+    // Record cell columns for the patch path
+    int16_t x = tx;
+    for (uint8_t i = 0; i < timePart.length() && i < 8; i++) {
+        _clockCellX[i] = x;
+        x += digitCellsCharWidth(CLOCK_BASELINE, timePart[i]);
+    }
 
-        uint16_t d = sys_scx_gif.delays[f] / BOOT_GIF_SPEED;
-        vTaskDelay(pdMS_TO_TICKS(d > 0 ? d : 1));
+    u8g2.setFont(u8g2_font_6x13_tr);
+    uint8_t dw = u8g2.getStrWidth(dateStr.c_str());
+    if (ampmPart.length() > 0) {
+        uint8_t aw = u8g2.getStrWidth(ampmPart.c_str());
+        int16_t line2W = (int16_t)dw + 4 + (int16_t)aw;
+        int16_t line2X = (128 - line2W) / 2;
+        if (line2X < 0) line2X = 0;
+        u8g2.drawStr((uint8_t)line2X, 58, dateStr.c_str());
+        u8g2.drawStr((uint8_t)(line2X + dw + 4), 58, ampmPart.c_str());
+    } else {
+        u8g2.drawStr((128 - dw) / 2, 58, dateStr.c_str());
     }
 
-    rtttl::stop();
-    noTone(getPinBuzzer());
+    strlcpy(_clockDigits, timePart.c_str(), sizeof(_clockDigits));
+    _clockRawTime    = timeStr;
+    _clockDate       = dateStr;
+    _clockAmPm       = ampmPart;
+    memcpy(_clockFrame, u8g2.getBufferPtr(), sizeof(_clockFrame));
+    _clockFrameValid = true;
+
+    rotateBuffer180();
+    displayFlushDirty();
+}
+
+// ==========================================================================
+//  Loop wait -- per-state deadline for the event-driven main loop
+// ==========================================================================
+// How long the main loop may block before the current state next needs to
+// do work.  Gestures wake the loop immediately (blocking queue receive);
+// network events and connectivity bits are polled at each wake, so the
+// wait is capped to keep them responsive.
+
+#define LOOP_WAIT_MAX_MS 50
+
+static uint32_t loopWaitMs() {
+    // An active melody needs near-continuous melodyTick() calls
+    if (melodyIsPlaying()) return 1;
+
+    // A partially transmitted frame needs displayFlushTick() soon
+    if (displayFlushPending()) return 1;
+
+    uint32_t wait = LOOP_WAIT_MAX_MS;
+    switch (_state) {
+        case GIF_PLAYBACK: {
+            uint32_t ms = gifPlayerMsUntilNextFrame();
+            if (ms < wait) wait = ms;
+            break;
+        }
+        case POKE_DISPLAY:
+        case HISTORY_POKE:
+            wait = POKE_SCROLL_INTERVAL_MS / 3;  // scroll cadence with low jitter
+            break;
+        case WIFI_SETUP:
+            wait = 40;  // connecting progress bar redraw
+            break;
+        case TIMER_RUNNING:
+            wait = 25;  // catch the countdown second boundary promptly
+            break;
+        case TREX_RUNNING:
+        case FLAPPY_RUNNING:
+        case CAR_RUNNING:
+        case CAM_VIEW:
+            wait = 5;   // frame pacing lives inside the game/cam tick
+            break;
+        default:
+            break;      // static screens: only elapsed-timeout checks, cap is enough
+    }
+    return wait;
+}
+
+// ==========================================================================
+//  On-device micro-benchmark (see /api/bench in web_dashboard.cpp)
+// ==========================================================================
+// Only the two panel-touching measurements live here; the CPU-side loops
+// (render core, FS reads, header parse) run in the web handler on scratch
+// buffers.  An even rotation count leaves the live buffer exactly as it
+// was, and the sendBuffer timing includes real I2C transfer to the panel.
+
+#define BENCH_ROTATE_ITERS 64
+#define BENCH_SEND_ITERS   8
+
+static volatile bool     _benchPending  = false;
+static volatile bool     _benchDone     = false;
+static volatile uint32_t _benchRotateUs = 0;   // per op
+static volatile uint32_t _benchSendUs   = 0;
+
+void displayBenchRequest() {
+    _benchDone    = false;
+    _benchPending = true;
+}
+
+bool displayBenchResult(uint32_t *rotateUs, uint32_t *sendUs) {
+    if (!_benchDone) return false;
+    *rotateUs = _benchRotateUs;
+    *sendUs   = _benchSendUs;
+    return true;
+}
+
+static void displayBenchTick() {
+    if (!_benchPending) return;
+    _benchPending = false;
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < BENCH_ROTATE_ITERS; i++) rotateBuffer180();
+    _benchRotateUs = (uint32_t)((esp_timer_get_time() - t0) / BENCH_ROTATE_ITERS);
+    t0 = esp_timer_get_time();
+    for (int i = 0; i < BENCH_SEND_ITERS; i++) u8g2.sendBuffer();
+    _benchSendUs = (uint32_t)((esp_timer_get_time() - t0) / BENCH_SEND_ITERS);
+    _benchDone = true;
 }
 
 // ==========================================================================
@@ -411,32 +619,62 @@ static void playBootAnimation() {
 void displayTask(void *param) {
     (void)param;
 
-    pokeHandlerInit();
+    GestureEvent pendingGesture;
+    bool         hasPendingGesture = false;
 
-    // --- BOOT_ANIM state ---
-    playBootAnimation();
-
-    // Check WiFi status after boot animation
-    EventBits_t bits = xEventGroupGetBits(connectivityBits);
-    if (bits & WIFI_CONNECTED_BIT) {
-        enterState(CONNECTED_INFO);
-        String ip = WiFi.localIP().toString();
-        showText("[ Wi-Fi Connected ]",
-                 "",
-                 ip.c_str(),
-                 "http://qbit.local");
+    pokeHandlerInit();
+    sessionSnapshotInit();
+
+    if (sessionSnapshotWarmBoot()) {
+        // Warm restart (scheduled reboot, OTA, crash recovery): skip the
+        // boot animation and Wi-Fi splash and put the UI back where it
+        // was.  WiFi reconnects in the background; everything the
+        // restored screens need (GIF files, warm-boot clock) is local.
+        DisplayState resume = sessionSnapshotState();
+        uint32_t remain = (resume == TIMER_RUNNING)
+                              ? sessionSnapshotTimerRemain() : 0;
+        if (resume == TIMER_RUNNING && remain > 0) {
+            timerUiRestoreRunning(remain, millis());
+            enterState(TIMER_RUNNING);
+            timerUiDrawRunning(remain, true);
+        } else if (resume == HISTORY_TIME) {
+            enterState(HISTORY_TIME);
+            historyTimeDraw(true);
+        } else if (resume == WEATHER_SCREEN) {
+            weatherScreenEnter();
+            enterState(WEATHER_SCREEN);
+        } else {
+            enterState(GIF_PLAYBACK);
+            if (!sessionSnapshotRestorePlayback()) {
+                gifPlayerStartIdleIfNoUserGifs();
+            }
+        }
     } else {
-        enterState(WIFI_SETUP);
-        _wifiSetupShowQR = true;
-        _wifiSetupPortalDrawn = false;
-        if (bits & PORTAL_ACTIVE_BIT) {
-            _wifiSetupPortalDrawn = true;
-            String apPwd = getApPassword();
-            showWifiQR("QBIT", apPwd.c_str());
+        // --- BOOT_ANIM state ---
+        playBootAnimation();
+
+        // Check WiFi status after boot animation
+        EventBits_t bits = xEventGroupGetBits(connectivityBits);
+        if (bits & WIFI_CONNECTED_BIT) {
+            enterState(CONNECTED_INFO);
+            String ip = WiFi.localIP().toString();
+            showText("[ Wi-Fi Connected ]",
+                     "",
+                     ip.c_str(),
+                     "http://qbit.local");
         } else {
-            _lastWifiConnBar = 0xFF;
-            _lastWifiConnSec = 0xFF;
-            showWifiConnectingProgress(millis());
+            enterState(WIFI_SETUP);
+            _wifiSetupShowQR = true;
+            _wifiSetupPortalDrawn = false;
+            if (bits & PORTAL_ACTIVE_BIT) {
+                _wifiSetupPortalDrawn = true;
+                String apPwd = getApPassword();
+                showWifiQR("QBIT", apPwd.c_str());
+            } else {
+                _lastWifiConnBar = 0xFF;
+                _lastWifiConnSec = 0xFF;
+                showWifiConnectingProgress(millis());
+            }
         }
     }
 
@@ -446,17 +684,27 @@ void displayTask(void *param) {
         unsigned long elapsed = now - _stateEntryMs;
 
         // --- Advance melody ---
-        if (rtttl::isPlaying()) {
-            rtttl::play();
+        if (melodyIsPlaying()) {
+            melodyTick();
             _melodyWasPlaying = true;
         } else if (_melodyWasPlaying) {
             noTone(getPinBuzzer());
             _melodyWasPlaying = false;
         }
 
-        // --- Check for network events ---
-        NetworkEvent netEvt;
-        if (xQueueReceive(networkEventQueue, &netEvt, 0) == pdTRUE) {
+        // --- Continue any partially transmitted frame (paced I2C flush) ---
+        displayFlushTick();
+
+        // --- Serve a pending /api/bench panel measurement (no-op otherwise) ---
+        displayBenchTick();
+
+        // --- Persist the session snapshot when it changed (debounced) ---
+        sessionSnapshotTick();
+
+        // --- Check for network events (pooled; release returns the slot) ---
+        NetworkEvent *netEvtPtr = nullptr;
+        if (xQueueReceive(networkEventQueue, &netEvtPtr, 0) == pdTRUE && netEvtPtr) {
+            NetworkEvent &netEvt = *netEvtPtr;
             switch (netEvt.kind) {
                 case NetworkEvent::POKE:
                     if (_state != CLAIM_PROMPT && _state != FRIEND_PROMPT) {
@@ -468,7 +716,7 @@ void displayTask(void *param) {
                         handlePoke(netEvt.sender, netEvt.text, netEvt.title[0] ? netEvt.title : nullptr);
                         if (getBuzzerVolume() > 0) {
                             noTone(getPinBuzzer());
-                            rtttl::begin(getPinBuzzer(), POKE_MELODY);
+                            melodyBegin(getPinBuzzer(), POKE_MELODY);
                         }
                         enterState(POKE_DISPLAY);
                     }
@@ -486,21 +734,45 @@ void displayTask(void *param) {
                         netEvt.textBmp   = nullptr;
                         if (getBuzzerVolume() > 0) {
                             noTone(getPinBuzzer());
-                            rtttl::begin(getPinBuzzer(), POKE_MELODY);
+                            melodyBegin(getPinBuzzer(), POKE_MELODY);
+                        }
+                        enterState(POKE_DISPLAY);
+                    }
+                    // Rejected bitmaps are freed by networkEventRelease() below
+                    break;
+
+                case NetworkEvent::POKE_SUMMARY: {
+                    // Burst overflow: drain the coalesced {sender, text} pairs
+                    // into history in one batch, then show the newest via the
+                    // normal poke path (which records it) under a burst title.
+                    char cSender[33], cText[65];
+                    const bool canShow =
+                        (_state != CLAIM_PROMPT && _state != FRIEND_PROMPT);
+                    while (networkCoalescedPokeCount() > (canShow ? 1 : 0) &&
+                           networkCoalescedPokePop(cSender, cText)) {
+                        pokeAddToHistory(cSender, cText, timeManagerNow());
+                    }
+                    if (canShow && networkCoalescedPokePop(cSender, cText)) {
+                        char sumTitle[21];
+                        snprintf(sumTitle, sizeof(sumTitle), "%u NEW POKES",
+                                 (unsigned)netEvt.count);
+                        handlePoke(cSender, cText,
+                                   netEvt.count > 1 ? sumTitle : nullptr);
+                        if (getBuzzerVolume() > 0) {
+                            noTone(getPinBuzzer());
+                            melodyBegin(getPinBuzzer(), POKE_MELODY);
                         }
                         enterState(POKE_DISPLAY);
-                    } else {
-                        if (netEvt.senderBmp) { free(netEvt.senderBmp); netEvt.senderBmp = nullptr; }
-                        if (netEvt.textBmp)   { free(netEvt.textBmp);   netEvt.textBmp   = nullptr; }
                     }
                     break;
+                }
 
                 case NetworkEvent::CLAIM_REQUEST:
                     enterState(CLAIM_PROMPT);
                     showText("[ Claim Request ]", "", netEvt.sender, "Hold to confirm");
                     if (getBuzzerVolume() > 0) {
                         noTone(getPinBuzzer());
-                        rtttl::begin(getPinBuzzer(), CLAIM_MELODY);
+                        melodyBegin(getPinBuzzer(), CLAIM_MELODY);
                     }
                     break;
 
@@ -509,7 +781,7 @@ void displayTask(void *param) {
                     showText("[ Friend Request ]", "", netEvt.sender, "Hold to confirm");
                     if (getBuzzerVolume() > 0) {
                         noTone(getPinBuzzer());
-                        rtttl::begin(getPinBuzzer(), CLAIM_MELODY);
+                        melodyBegin(getPinBuzzer(), CLAIM_MELODY);
                     }
                     break;
 
@@ -583,11 +855,20 @@ void displayTask(void *param) {
                     }
                     break;
             }
+            networkEventRelease(netEvtPtr);
         }
 
-        // --- Check for gesture events ---
+        // --- Check for gesture events (stashed by the deadline wait below, or fresh) ---
         GestureEvent gesture;
-        if (xQueueReceive(gestureQueue, &gesture, 0) == pdTRUE) {
+        bool haveGesture = hasPendingGesture;
+        if (haveGesture) {
+            gesture           = pendingGesture;
+            hasPendingGesture = false;
+        } else {
+            haveGesture = (xQueueReceive(gestureQueue, &gesture, 0) == pdTRUE);
+        }
+        if (haveGesture) {
+            int64_t tGesture = qtraceNow();
             // Publish to MQTT only when not in game; never publish touch_down/touch_up (low-level press/release)
             if (!isGameDisplayState(_state) &&
                 gesture.type != TOUCH_DOWN && gesture.type != TOUCH_UP)
@@ -616,7 +897,7 @@ void displayTask(void *param) {
                             // Immediate audio feedback on touch
                             if (getBuzzerVolume() > 0) {
                                 noTone(getPinBuzzer());
-                                rtttl::begin(getPinBuzzer(), TOUCH_MELODY);
+                                melodyBegin(getPinBuzzer(), TOUCH_MELODY);
                             }
                             break;
                         case SINGLE_TAP: {
@@ -629,41 +910,7 @@ void displayTask(void *param) {
                         }
                         case DOUBLE_TAP:
                             enterState(HISTORY_TIME);
-                            {
-                                String timeStr = timeManagerGetFormatted();
-                                String dateStr = timeManagerGetDateFormatted();
-                                u8g2.clearBuffer();
-                                String timePart = timeStr;
-                                String ampmPart;
-                                if (!getTimeFormat24h()) {
-                                    int sp = timeStr.indexOf(" AM");
-                                    if (sp < 0) sp = timeStr.indexOf(" PM");
-                                    if (sp < 0) { sp = timeStr.indexOf("AM"); if (sp < 0) sp = timeStr.indexOf("PM"); }
-                                    if (sp >= 0) {
-                                        timePart = timeStr.substring(0, sp);
-                                        ampmPart = timeStr.substring(sp);
-                                    }
-                                }
-                                u8g2.setFont(u8g2_font_logisoso28_tn);
-                                int16_t tw = (int16_t)u8g2.getStrWidth(timePart.c_str());
-                                int16_t tx = (128 - tw) / 2;
-                                if (tx < 0) tx = 0;
-                                u8g2.drawStr((uint8_t)tx, 38, timePart.c_str());
-                                u8g2.setFont(u8g2_font_6x13_tr);
-                                uint8_t dw = u8g2.getStrWidth(dateStr.c_str());
-                                if (ampmPart.length() > 0) {
-                                    uint8_t aw = u8g2.getStrWidth(ampmPart.c_str());
-                                    int16_t line2W = (int16_t)dw + 4 + (int16_t)aw;
-                                    int16_t line2X = (128 - line2W) / 2;
-                                    if (line2X < 0) line2X = 0;
-                                    u8g2.drawStr((uint8_t)line2X, 58, dateStr.c_str());
-                                    u8g2.drawStr((uint8_t)(line2X + dw + 4), 58, ampmPart.c_str());
-                                } else {
-                                    u8g2.drawStr((128 - dw) / 2, 58, dateStr.c_str());
-                                }
-                                rotateBuffer180();
-                                u8g2.sendBuffer();
-                            }
+                            historyTimeDraw(true);
                             break;
                         case LONG_PRESS:
                             enterSettingsMenu();
@@ -716,7 +963,7 @@ void displayTask(void *param) {
                     _stateEntryMs = now;  // reset idle timer
                     if (gesture.type == SINGLE_TAP) {
                         _historyIndex++;
-                        if (_historyIndex >= pokeHistoryCount() || _historyIndex >= 3) {
+                        if (_historyIndex >= pokeHistoryCount()) {
                             enterState(GIF_PLAYBACK);
                         } else {
                             showPokeHistoryEntry(_historyIndex);
@@ -849,7 +1096,7 @@ void displayTask(void *param) {
                             carAvoidanceEnter();
                             if (getBuzzerVolume() > 0) {
                                 noTone(getPinBuzzer());
-                                rtttl::begin(getPinBuzzer(), CAR_START_MELODY);
+                                melodyBegin(getPinBuzzer(), CAR_START_MELODY);
                             }
                             enterState(CAR_RUNNING);
                             carAvoidanceDrawFrame();
@@ -895,16 +1142,19 @@ void displayTask(void *param) {
                     TimerAction ta = timerUiOnGestureRunning(tg,
                             timerUiGetDone(), timerUiGetStarted());
                     if (ta == TimerAction::Dismiss) {
-                        rtttl::stop();
+                        melodyStop();
                         noTone(getPinBuzzer());
+                        sessionSnapshotNoteTimer(0);
                         enterState(GIF_PLAYBACK);
                     } else if (ta == TimerAction::GoToSet) {
                         timerUiEnterSet();
+                        sessionSnapshotNoteTimer(0);
                         enterState(TIMER_SET);
                         timerUiDrawSet();
                     } else if (ta == TimerAction::Redraw) {
                         timerUiSetStarted(true);
                         timerUiSetLastTickMs(now);
+                        sessionSnapshotNoteTimer(timerUiGetRemainSec());
                         timerUiDrawRunning(timerUiGetRemainSec(), true);
                     }
                     break;
@@ -923,7 +1173,7 @@ void displayTask(void *param) {
                         trexRunnerApplyJump();
                         if (getBuzzerVolume() > 0) {
                             noTone(getPinBuzzer());
-                            rtttl::begin(getPinBuzzer(), TOUCH_MELODY);
+                            melodyBegin(getPinBuzzer(), TOUCH_MELODY);
                         }
                     } else if (ra == TrexRunnerAction::Duck) {
                         trexRunnerApplyDuck();
@@ -958,7 +1208,7 @@ void displayTask(void *param) {
                         flappyApplyFlap();
                         if (getBuzzerVolume() > 0) {
                             noTone(getPinBuzzer());
-                            rtttl::begin(getPinBuzzer(), TOUCH_MELODY);
+                            melodyBegin(getPinBuzzer(), TOUCH_MELODY);
                         }
                     }
                     break;
@@ -987,7 +1237,7 @@ void displayTask(void *param) {
                         carAvoidanceApplyChangeLane();
                         if (getBuzzerVolume() > 0) {
                             noTone(getPinBuzzer());
-                            rtttl::begin(getPinBuzzer(), TOUCH_MELODY);
+                            melodyBegin(getPinBuzzer(), TOUCH_MELODY);
                         }
                     }
                     break;
@@ -999,7 +1249,7 @@ void displayTask(void *param) {
                         carAvoidanceEnter();
                         if (getBuzzerVolume() > 0) {
                             noTone(getPinBuzzer());
-                            rtttl::begin(getPinBuzzer(), CAR_START_MELODY);
+                            melodyBegin(getPinBuzzer(), CAR_START_MELODY);
                         }
                         enterState(CAR_RUNNING);
                         carAvoidanceDrawFrame();
@@ -1016,6 +1266,7 @@ void displayTask(void *param) {
                     }
                     break;
             }
+            qtraceSpan("disp.gesture", tGesture);
         }
 
         // --- State-specific tick logic ---
@@ -1023,6 +1274,7 @@ void displayTask(void *param) {
         now = millis();
         elapsed = now - _stateEntryMs;
 
+        int64_t tState = qtraceNow();
         switch (_state) {
             case WIFI_SETUP: {
                 EventBits_t wb = xEventGroupGetBits(connectivityBits);
@@ -1165,6 +1417,7 @@ void displayTask(void *param) {
                 break;
 
             case HISTORY_TIME:
+                historyTimeDraw(false);  // patches digits on minute rollover
                 if (elapsed >= HISTORY_IDLE_MS) {
                     enterState(GIF_PLAYBACK);
                 }
@@ -1266,18 +1519,18 @@ void displayTask(void *param) {
 
             case TIMER_RUNNING:
                 if (timerUiGetDone()) {
-                    if (!rtttl::isPlaying()) {
+                    if (!melodyIsPlaying()) {
                         if (!_timerAlarmStarted) {
                             if (getBuzzerVolume() == 0) {
                                 _timerAlarmRestoreMute = true;
                                 setBuzzerVolume(getSavedVolume() > 0 ? getSavedVolume() : 100);
                             }
                             noTone(getPinBuzzer());
-                            rtttl::begin(getPinBuzzer(), TIMER_MELODY);
+                            melodyBegin(getPinBuzzer(), TIMER_MELODY);
                             _timerAlarmStarted = true;
                         } else {
                             noTone(getPinBuzzer());
-                            rtttl::begin(getPinBuzzer(), TIMER_MELODY);
+                            melodyBegin(getPinBuzzer(), TIMER_MELODY);
                         }
                     }
                 } else if (timerUiTick(now)) {
@@ -1287,7 +1540,7 @@ void displayTask(void *param) {
                             setBuzzerVolume(getSavedVolume() > 0 ? getSavedVolume() : 100);
                         }
                         noTone(getPinBuzzer());
-                        rtttl::begin(getPinBuzzer(), TIMER_MELODY);
+                        melodyBegin(getPinBuzzer(), TIMER_MELODY);
                         _timerAlarmStarted = true;
                         showText("[ Timer Done! ]", "", "Time's up!", "TAP to dismiss");
                     } else {
@@ -1302,7 +1555,7 @@ void displayTask(void *param) {
                     setTrexHighScore(trexRunnerGetScore());
                     if (getBuzzerVolume() > 0) {
                         noTone(getPinBuzzer());
-                        rtttl::begin(getPinBuzzer(), MUTE_MELODY);
+                        melodyBegin(getPinBuzzer(), MUTE_MELODY);
                     }
                     enterState(TREX_OVER);
                     trexRunnerDrawGameOver();
@@ -1319,7 +1572,7 @@ void displayTask(void *param) {
                     setFlappyHighScore(flappyGetScore());
                     if (getBuzzerVolume() > 0) {
                         noTone(getPinBuzzer());
-                        rtttl::begin(getPinBuzzer(), MUTE_MELODY);
+                        melodyBegin(getPinBuzzer(), MUTE_MELODY);
                     }
                     enterState(FLAPPY_OVER);
                     flappyDrawGameOver();
@@ -1336,13 +1589,13 @@ void displayTask(void *param) {
                     setCarHighScore(carAvoidanceGetScore());
                     if (getBuzzerVolume() > 0) {
                         noTone(getPinBuzzer());
-                        rtttl::begin(getPinBuzzer(), CAR_CRASH_MELODY);
+                        melodyBegin(getPinBuzzer(), CAR_CRASH_MELODY);
                     }
                     enterState(CAR_OVER);
                     carAvoidanceDrawGameOver();
                 } else if (carAvoidanceNearMiss() && getBuzzerVolume() > 0) {
                     noTone(getPinBuzzer());
-                    rtttl::begin(getPinBuzzer(), CAR_NEAR_MELODY);
+                    melodyBegin(getPinBuzzer(), CAR_NEAR_MELODY);
                 }
                 break;
 
@@ -1362,8 +1615,17 @@ void displayTask(void *param) {
             default:
                 break;
         }
-
-        // Short delay to yield CPU
-        vTaskDelay(pdMS_TO_TICKS(5));
+        qtraceSpan("disp.state", tState);
+
+        // --- Deadline wait ---
+        // Block on the gesture queue until the next state deadline instead
+        // of a fixed 5 ms poll: static screens wake at most every
+        // LOOP_WAIT_MAX_MS, animated states exactly when the next frame or
+        // scroll tick is due, and a gesture wakes the loop immediately
+        // (stashed here, handled at the top of the next iteration).
+        if (xQueueReceive(gestureQueue, &pendingGesture,
+                          pdMS_TO_TICKS(loopWaitMs())) == pdTRUE) {
+            hasPendingGesture = true;
+        }
     }
 }
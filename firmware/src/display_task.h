@@ -8,4 +8,12 @@
 // Priority 2, stack 8192 bytes.
 void displayTask(void *param);
 
+// --- On-device micro-benchmark (GET /api/bench) ---
+// The panel-touching measurements (rotateBuffer180, u8g2.sendBuffer) must
+// run on the display task -- it owns the live buffer and the I2C bus.  The
+// web handler requests a run and polls for the result.
+void displayBenchRequest();
+// False while a requested run is still pending; per-op microseconds on true.
+bool displayBenchResult(uint32_t *rotateUs, uint32_t *sendUs);
+
 #endif // DISPLAY_TASK_H
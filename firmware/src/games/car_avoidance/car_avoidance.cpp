@@ -8,6 +8,8 @@
 #include "app_state.h"
 #include "display_helpers.h"
 #include "settings.h"
+#include "games/game_timestep.h"
+#include "games/sprite_blit.h"
 #include <stdio.h>
 
 // --------------------------------------------------------------------------
@@ -72,8 +74,9 @@ static const uint8_t CA_DIV_X[CA_NUM_LANES - 1] = { 50, 78 };
 
 // --------------------------------------------------------------------------
 //  Sprites
-//  Each byte = one row; bit 7 = leftmost pixel (col 0), bit 0 = rightmost (col 7).
-//  Stored in flash with PROGMEM; read with pgm_read_byte().
+//  Row-by-row source below (bit 7 = leftmost); the arrays hold the packed
+//  page-format equivalent (games/sprite_blit.h; scripts/compile_sprites.py
+//  output) blitted by the shared sprite blitter.
 // --------------------------------------------------------------------------
 
 // Player car (8W × 12H): top-down view, front of car faces UP (toward enemies).
@@ -89,10 +92,10 @@ static const uint8_t CA_DIV_X[CA_NUM_LANES - 1] = { 50, 78 };
 //  Row  9: XXXXXXXX  0xFF  trunk
 //  Row 10: X..XX..X  0x99  rear wheel arches
 //  Row 11: .XXXXXX.  0x7E  tail lights / rear bumper
-static const uint8_t PLAYER_CAR[CA_CAR_H] PROGMEM = {
-    0x7E, 0xFF, 0xBD, 0xBD,
-    0xFF, 0xDB, 0xFF, 0xBD,
-    0xBD, 0xFF, 0x99, 0x7E
+static const uint8_t PLAYER_CAR[] PROGMEM = {
+    8, 12,
+    0xFE, 0x73, 0xDF, 0xFF, 0xFF, 0xDF, 0x73, 0xFE,
+    0x07, 0x0A, 0x0B, 0x0F, 0x0F, 0x0B, 0x0A, 0x07
 };
 
 // Enemy car (8W × 10H): traveling downward.
@@ -107,10 +110,10 @@ static const uint8_t PLAYER_CAR[CA_CAR_H] PROGMEM = {
 //  Row  7: XXXXXXXX  0xFF  hood
 //  Row  8: X..XX..X  0x99  front wheel arches
 //  Row  9: .XXXXXX.  0x7E  front bumper / headlights  (bottom = closest to player)
-static const uint8_t ENEMY_CAR[CA_ENEMY_H] PROGMEM = {
-    0x7E, 0x99, 0xFF, 0xBD,
-    0xBD, 0xFF, 0xDB, 0xFF,
-    0x99, 0x7E
+static const uint8_t ENEMY_CAR[] PROGMEM = {
+    8, 10,
+    0xFE, 0xE5, 0xBD, 0xFF, 0xFF, 0xBD, 0xE5, 0xFE,
+    0x01, 0x02, 0x02, 0x03, 0x03, 0x02, 0x02, 0x01
 };
 
 // --------------------------------------------------------------------------
@@ -153,20 +156,10 @@ static uint16_t caRand() {
 // --------------------------------------------------------------------------
 //  Draw one car sprite, clipped to road interior
 // --------------------------------------------------------------------------
-static void drawCar(int8_t left, int16_t top, const uint8_t *sprite, uint8_t h) {
-    u8g2.setDrawColor(1);
-    for (uint8_t row = 0; row < h; row++) {
-        int16_t sy = top + (int16_t)row;
-        if (sy <= CA_ROAD_TOP_Y || sy >= CA_ROAD_BTM_Y) continue;
-        uint8_t bits = pgm_read_byte(&sprite[row]);
-        for (uint8_t col = 0; col < CA_CAR_W; col++) {
-            if (bits & (0x80u >> col)) {
-                int16_t sx = (int16_t)left + (int16_t)col;
-                if (sx > CA_ROAD_X && sx < CA_ROAD_X + (int16_t)CA_ROAD_W - 1)
-                    u8g2.drawPixel((uint8_t)sx, (uint8_t)sy);
-            }
-        }
-    }
+static void drawCar(int8_t left, int16_t top, const uint8_t *sprite) {
+    spriteBlitWindow(left, top, sprite, nullptr, false,
+                     CA_ROAD_X + 1, CA_ROAD_TOP_Y + 1,
+                     CA_ROAD_X + CA_ROAD_W - 2, CA_ROAD_BTM_Y - 1);
 }
 
 // --------------------------------------------------------------------------
@@ -272,15 +265,14 @@ void carAvoidanceDrawFrame(unsigned long /*nowMs*/) {
     // Enemy cars
     for (uint8_t i = 0; i < CA_MAX_ENEMIES; i++) {
         if (_enemies[i].active)
-            drawCar(CA_LANE_X[_enemies[i].lane], _enemies[i].y,
-                    ENEMY_CAR, CA_ENEMY_H);
+            drawCar(CA_LANE_X[_enemies[i].lane], _enemies[i].y, ENEMY_CAR);
     }
 
     // Player car
-    drawCar(CA_LANE_X[_playerLane], CA_PLAYER_TOP_Y, PLAYER_CAR, CA_CAR_H);
+    drawCar(CA_LANE_X[_playerLane], CA_PLAYER_TOP_Y, PLAYER_CAR);
 
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 void carAvoidanceDrawGameOver() {
@@ -300,7 +292,7 @@ void carAvoidanceDrawGameOver() {
     u8g2.drawStr((128 - (int16_t)u8g2.getStrWidth(hint)) / 2, 62, hint);
 
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 CarAction carAvoidanceOnGesture(CarGestureType g) {
@@ -315,12 +307,8 @@ void carAvoidanceApplyChangeLane() {
     _playerLane = (_playerLane + 1) % CA_NUM_LANES;
 }
 
-bool carAvoidanceTick(unsigned long nowMs) {
-    if (nowMs - _lastTickMs < CA_TICK_MS) return false;
-    _lastTickMs = nowMs;
-
-    if (_dead) return false;
-
+// One fixed CA_TICK_MS physics step.  Returns true on crash.
+static bool carStepOnce() {
     _ticksSinceStart++;
 
     // Score grows more slowly: +1 every 2 ticks
@@ -394,6 +382,15 @@ bool carAvoidanceTick(unsigned long nowMs) {
     return crashed;
 }
 
+bool carAvoidanceTick(unsigned long nowMs) {
+    uint8_t steps = gameTimestepSteps(&_lastTickMs, nowMs, CA_TICK_MS);
+    if (steps == 0 || _dead) return false;
+    while (steps--) {
+        if (carStepOnce()) return true;  // crash mid-catchup ends the run
+    }
+    return false;
+}
+
 bool carAvoidanceNearMiss() {
     bool wasNear = _nearMiss;
     _nearMiss = false;
@@ -7,6 +7,8 @@
 #include "app_state.h"
 #include "display_helpers.h"
 #include "settings.h"
+#include "games/game_timestep.h"
+#include "games/sprite_blit.h"
 #include <stdio.h>
 
 // --------------------------------------------------------------------------
@@ -80,8 +82,7 @@ static uint16_t fbRand() {
 
 // --------------------------------------------------------------------------
 //  Bird sprite
-//  8 columns wide × 6 rows tall.
-//  Each byte = one row; bit 7 = leftmost pixel (col 0), bit 0 = rightmost (col 7).
+//  8 columns wide × 6 rows tall.  Row-by-row source (bit 7 = leftmost):
 //  Bird faces right: beak is the rightmost lit pixel on row 3.
 //  Eye hole: col 5 on row 2 is 0 (transparent).
 // --------------------------------------------------------------------------
@@ -92,25 +93,16 @@ static uint16_t fbRand() {
 //  Row3: X X X X X X X X   0xFF  ← beak at col 7 (rightmost)
 //  Row4: . X X X X X X .   0x7E
 //  Row5: . . X X X X . .   0x3C
-static const uint8_t BIRD_BODY[6] = { 0x38, 0x7C, 0xFA, 0xFF, 0x7E, 0x3C };
+// Packed page-format equivalent of the rows above (games/sprite_blit.h;
+// scripts/compile_sprites.py output): w, h, one strip, bit 0 = top row.
+static const uint8_t BIRD_SPRITE[] PROGMEM = {
+    8, 6, 0x0C, 0x1E, 0x3F, 0x3F, 0x3F, 0x3A, 0x1C, 0x08
+};
 
 static void drawBird(int16_t bx, int16_t topY, uint8_t frame, bool dead) {
+    spriteBlit(bx, topY, BIRD_SPRITE, nullptr, false);
     u8g2.setDrawColor(1);
 
-    // Draw body rows
-    for (int8_t r = 0; r < FB_BIRD_H; r++) {
-        int16_t sy = topY + r;
-        if (sy < 0 || sy > 63) continue;
-        uint8_t bits = BIRD_BODY[r];
-        for (int8_t c = 0; c < FB_BIRD_W; c++) {
-            if (bits & (0x80 >> c)) {
-                int16_t sx = bx + c;
-                if (sx >= 0 && sx <= 127)
-                    u8g2.drawPixel((uint8_t)sx, (uint8_t)sy);
-            }
-        }
-    }
-
     if (dead) {
         // X eyes: replace normal eye with × mark
         u8g2.setDrawColor(0);
@@ -249,7 +241,7 @@ void flappyDrawFrame(unsigned long /*nowMs*/) {
     drawBird(FB_BIRD_X, birdTopY, _birdFrame, _dead);
 
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 void flappyDrawGameOver() {
@@ -269,7 +261,7 @@ void flappyDrawGameOver() {
     u8g2.drawStr((128 - u8g2.getStrWidth(hint)) / 2, 62, hint);
 
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 FlappyAction flappyOnGesture(FlappyGestureType g) {
@@ -284,12 +276,8 @@ void flappyApplyFlap() {
     _animTick  = 0;
 }
 
-bool flappyTick(unsigned long nowMs) {
-    if (nowMs - _lastTickMs < FB_TICK_MS) return false;
-    _lastTickMs = nowMs;
-
-    if (_dead) return false;
-
+// One fixed FB_TICK_MS physics step.  Returns true on death.
+static bool flappyStepOnce() {
     // --- Physics ---
     _birdY4 += _velY4;
     _velY4  += FB_GRAVITY4;
@@ -361,4 +349,13 @@ bool flappyTick(unsigned long nowMs) {
     return false;
 }
 
+bool flappyTick(unsigned long nowMs) {
+    uint8_t steps = gameTimestepSteps(&_lastTickMs, nowMs, FB_TICK_MS);
+    if (steps == 0 || _dead) return false;
+    while (steps--) {
+        if (flappyStepOnce()) return true;  // death mid-catchup ends the run
+    }
+    return false;
+}
+
 uint32_t flappyGetScore() { return _score; }
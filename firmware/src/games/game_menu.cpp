@@ -67,7 +67,7 @@ void gameMenuDraw() {
     u8g2.drawStr((128 - u8g2.getStrWidth(hint)) / 2, 62, hint);
 
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 GameMenuAction gameMenuOnGesture(GameMenuGestureType g) {
@@ -0,0 +1,36 @@
+// ==========================================================================
+//  QBIT -- Fixed-timestep accumulator shared by the games
+// ==========================================================================
+// The games used to advance physics once per render tick: if an I2C flush
+// or a WS burst delayed the loop, the game world itself slowed down and
+// scores/difficulty became frame-rate dependent.  This accumulator keeps
+// the simulation on wall-clock time -- when the loop falls behind it
+// returns several steps to run before the next render, and when it is
+// hopelessly behind it drops the excess instead of spiralling.
+#ifndef GAME_TIMESTEP_H
+#define GAME_TIMESTEP_H
+
+#include <Arduino.h>
+
+// Longest burst of catch-up physics steps per render.  Beyond this
+// (hundreds of ms of stall) time is dropped: a visible hiccup is better
+// than an unwinnable fast-forward.
+#define GAME_TIMESTEP_MAX_CATCHUP 4
+
+// Number of fixed steps due at 'nowMs'; advances *lastStepMs by the steps
+// actually granted so leftover time carries into the next call.
+static inline uint8_t gameTimestepSteps(unsigned long *lastStepMs,
+                                        unsigned long nowMs,
+                                        unsigned long stepMs) {
+    unsigned long behind = nowMs - *lastStepMs;
+    if (behind < stepMs) return 0;
+    unsigned long steps = behind / stepMs;
+    if (steps > GAME_TIMESTEP_MAX_CATCHUP) {
+        *lastStepMs = nowMs;
+        return GAME_TIMESTEP_MAX_CATCHUP;
+    }
+    *lastStepMs += steps * stepMs;
+    return (uint8_t)steps;
+}
+
+#endif // GAME_TIMESTEP_H
@@ -0,0 +1,64 @@
+// QBIT -- shared masked-sprite blitter (format described in sprite_blit.h)
+#include "games/sprite_blit.h"
+#include "display_helpers.h"
+
+// ESP32 maps PROGMEM into the regular address space, so sprite bytes are
+// read in place -- no per-draw RAM staging copy.
+void spriteBlitWindow(int16_t px, int16_t py, const uint8_t *sprite,
+                      const uint8_t *mask, bool anchorBottom,
+                      uint8_t cx0, uint8_t cy0, uint8_t cx1, uint8_t cy1) {
+    uint8_t w = sprite[0];
+    uint8_t h = sprite[1];
+    if (w == 0 || h == 0) return;
+    int16_t top = anchorBottom ? (int16_t)(py - h) : py;
+    if (px > (int16_t)cx1 || px + w <= (int16_t)cx0 ||
+        top > (int16_t)cy1 || top + h <= (int16_t)cy0) return;
+
+    uint8_t xStart = (px < (int16_t)cx0) ? (uint8_t)(cx0 - px) : 0;
+    uint8_t xEnd   = ((int16_t)cx1 - px < (int16_t)(w - 1))
+                         ? (uint8_t)(cx1 - px) : (uint8_t)(w - 1);
+
+    uint8_t       *fb     = u8g2.getBufferPtr();
+    uint8_t        strips = (uint8_t)((h + 7) / 8);
+    const uint8_t *data   = sprite + 2;
+    const uint8_t *msrc   = mask ? mask + 2 : nullptr;
+
+    for (uint8_t sp = 0; sp < strips; sp++) {
+        int16_t yBase = top + (int16_t)sp * 8;
+        if (yBase > (int16_t)cy1 || yBase + 7 < (int16_t)cy0) continue;
+
+        // Rows of this strip that exist in the sprite and pass the window
+        uint8_t allow = 0xFF;
+        uint8_t rows  = (uint8_t)(h - sp * 8);
+        if (rows < 8) allow = (uint8_t)((1u << rows) - 1);
+        if (yBase < (int16_t)cy0) allow &= (uint8_t)(0xFF << (cy0 - yBase));
+        if (yBase + 7 > (int16_t)cy1) allow &= (uint8_t)(0xFF >> (yBase + 7 - cy1));
+        if (allow == 0) continue;
+
+        // Destination page and in-page shift.  Bias by 64 rows so the
+        // floor division stays correct for strips starting above row 0.
+        int16_t adj   = (int16_t)(yBase + 64);
+        int8_t  page  = (int8_t)((adj >> 3) - 8);
+        uint8_t shift = (uint8_t)(adj & 7);
+        uint8_t *fb0 = (page >= 0 && page < 8) ? fb + (int16_t)page * 128 : nullptr;
+        uint8_t *fb1 = (page + 1 >= 0 && page + 1 < 8) ? fb + (page + 1) * 128 : nullptr;
+
+        const uint8_t *row  = data + (uint16_t)sp * w;
+        const uint8_t *mrow = msrc ? msrc + (uint16_t)sp * w : nullptr;
+        for (uint8_t x = xStart; x <= xEnd; x++) {
+            uint8_t d = (uint8_t)(row[x] & allow);
+            uint8_t m = mrow ? (uint8_t)(mrow[x] & allow) : d;
+            if (m == 0) continue;
+            uint16_t sx = (uint16_t)(px + x);
+            if (fb0)
+                fb0[sx] = (uint8_t)((fb0[sx] & (uint8_t)~(m << shift)) | (uint8_t)(d << shift));
+            if (shift && fb1)
+                fb1[sx] = (uint8_t)((fb1[sx] & (uint8_t)~(m >> (8 - shift))) | (uint8_t)(d >> (8 - shift)));
+        }
+    }
+}
+
+void spriteBlit(int16_t px, int16_t py, const uint8_t *sprite,
+                const uint8_t *mask, bool anchorBottom) {
+    spriteBlitWindow(px, py, sprite, mask, anchorBottom, 0, 0, 127, 63);
+}
@@ -0,0 +1,33 @@
+// QBIT -- shared masked-sprite blitter for the games
+//
+// Sprite format (the packed layout the t-rex assets already use):
+//   byte 0 = width, byte 1 = height, then (h+7)/8 row-strips of w bytes,
+//   8 vertical pixels per byte, bit 0 = top row of the strip.  That is
+//   exactly the u8g2 page-buffer layout, so a blit is two shifted byte
+//   ops per column instead of up to 16 clipped drawPixel calls.
+//
+// Mask (optional, same dimensions): bit 1 = pixel owned by the sprite.
+// Owned pixels are cleared to background before the bitmap is OR-ed in,
+// so a masked sprite occludes whatever was drawn behind it; without a
+// mask the bitmap is OR-ed over the buffer (no clearing), matching the
+// old per-pixel draw loops.
+//
+// scripts/compile_sprites.py emits both arrays from XBM sources for new
+// assets.
+#ifndef SPRITE_BLIT_H
+#define SPRITE_BLIT_H
+
+#include <Arduino.h>
+
+// Blit into the full 128x64 buffer.  py is the sprite top edge, or the
+// bottom edge when anchorBottom (the games anchor sprites to the ground).
+void spriteBlit(int16_t px, int16_t py, const uint8_t *sprite,
+                const uint8_t *mask, bool anchorBottom);
+
+// Same, clipped to an inclusive pixel window (car_avoidance clips cars to
+// the road interior).
+void spriteBlitWindow(int16_t px, int16_t py, const uint8_t *sprite,
+                      const uint8_t *mask, bool anchorBottom,
+                      uint8_t cx0, uint8_t cy0, uint8_t cx1, uint8_t cy1);
+
+#endif // SPRITE_BLIT_H
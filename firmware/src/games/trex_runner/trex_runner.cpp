@@ -4,6 +4,8 @@
 #include "display_helpers.h"
 #include "t_rex_runner_assets.h"
 #include "settings.h"
+#include "games/game_timestep.h"
+#include "games/sprite_blit.h"
 #include <stdio.h>
 #include <pgmspace.h>
 
@@ -25,40 +27,9 @@
 #define RESPAWN_WAIT_MIN    15
 #define RESPAWN_WAIT_RANGE  35
 
-// T-rex format: first 2 bytes = width, height; data at +2, row-major 8 vertical bits/byte.
-// Mask: 1 = transparent (skip). Draw only pixels inside [0,127] x [0,63].
-// Use memcpy_P to copy sprite into RAM then draw (reliable on ESP32 with PROGMEM).
-#define DINO_BMP_MAX  (64 * 2 + 2)
-static void drawDinoBitmap(int16_t px, int16_t py, const uint8_t *bitmap, const uint8_t *mask, bool anchorBottom) {
-    uint8_t w = pgm_read_byte(bitmap + 0);
-    uint8_t h = pgm_read_byte(bitmap + 1);
-    if (w == 0 || h == 0) return;
-    uint16_t dataLen = 2 + (uint16_t)((h + 7) / 8) * w;
-    if (dataLen > DINO_BMP_MAX) return;
-    uint8_t ramBmp[DINO_BMP_MAX];
-    memcpy_P(ramBmp, bitmap, dataLen);
-    uint8_t ramMsk[DINO_BMP_MAX];
-    if (mask) memcpy_P(ramMsk, mask, dataLen);
-    const uint8_t *data = ramBmp + 2;
-    const uint8_t *msk  = mask ? (ramMsk + 2) : nullptr;
-    int16_t top = anchorBottom ? (py - (int16_t)h) : py;
-    for (uint8_t y = 0; y < h; y++) {
-        int16_t sy = top + y;
-        if (sy < 0 || sy > 63) continue;
-        uint8_t yByte = y / 8;
-        uint8_t yBit  = y % 8;
-        uint16_t rowOff = (uint16_t)yByte * w;
-        for (uint8_t x = 0; x < w; x++) {
-            int16_t sx = px + x;
-            if (sx < 0 || sx > 127) continue;
-            uint16_t off = rowOff + x;
-            if (msk && (msk[off] & (1 << yBit)))
-                continue;
-            if (data[off] & (1 << yBit))
-                u8g2.drawPixel((uint8_t)sx, (uint8_t)sy);
-        }
-    }
-}
+// Sprites use the shared packed page format (see games/sprite_blit.h);
+// the asset arrays are already in it.  Actors pass their mask so they
+// occlude the ground behind them; ground tiles OR in without one.
 
 enum ObstacleType { OBS_NONE, OBS_CACTUS_SB, OBS_CACTUS_BS, OBS_CACTUS_2B, OBS_CACTUS_3S, OBS_PTERO };
 struct Obstacle {
@@ -166,7 +137,7 @@ static void drawGround() {
     for (uint8_t i = 0; i < NUM_GROUND_TILES; i++) {
         int16_t gx = _groundTileX[i];
         if (gx + GAME_GROUND_W > 0 && gx < 128)
-            drawDinoBitmap(gx, (int16_t)GAME_GROUND_Y, gbm[_groundTileIdx[i]], nullptr, true);
+            spriteBlit(gx, (int16_t)GAME_GROUND_Y, gbm[_groundTileIdx[i]], nullptr, true);
     }
 }
 
@@ -184,18 +155,23 @@ void trexRunnerDrawFrame(unsigned long nowMs) {
 
     if (_dead) {
         if (_ducking)
-            drawDinoBitmap(GAME_TREX_X, GAME_GROUND_Y, trex_dead_2s_no_outline_bitmap, nullptr, true);
+            spriteBlit(GAME_TREX_X, GAME_GROUND_Y, trex_dead_2s_no_outline_bitmap,
+                       trex_dead_2s_no_outline_mask, true);
         else
-            drawDinoBitmap(GAME_TREX_X, GAME_GROUND_Y, trex_dead_1s_no_outline_bitmap, nullptr, true);
+            spriteBlit(GAME_TREX_X, GAME_GROUND_Y, trex_dead_1s_no_outline_bitmap,
+                       trex_dead_1s_no_outline_mask, true);
     } else if (_ducking) {
-        const uint8_t *bm = (_trexFrame & 1) ? trex_duck_2s_bitmap : trex_duck_1s_bitmap;
+        bool alt = (_trexFrame & 1);
+        const uint8_t *bm = alt ? trex_duck_2s_bitmap : trex_duck_1s_bitmap;
+        const uint8_t *mk = alt ? trex_duck_2s_mask   : trex_duck_1s_mask;
         int16_t dy = _onGround ? GAME_GROUND_Y : _trexY;
-        drawDinoBitmap(GAME_TREX_X, dy, bm, nullptr, true);
+        spriteBlit(GAME_TREX_X, dy, bm, mk, true);
     } else {
         const uint8_t *bm = trex_up_1s_bitmap;
-        if (_trexFrame == 1) bm = trex_up_2s_bitmap;
-        else if (_trexFrame == 2) bm = trex_up_3s_bitmap;
-        drawDinoBitmap(GAME_TREX_X, _trexY, bm, nullptr, true);
+        const uint8_t *mk = trex_up_1s_mask;
+        if (_trexFrame == 1)      { bm = trex_up_2s_bitmap; mk = trex_up_2s_mask; }
+        else if (_trexFrame == 2) { bm = trex_up_3s_bitmap; mk = trex_up_3s_mask; }
+        spriteBlit(GAME_TREX_X, _trexY, bm, mk, true);
     }
 
     for (uint8_t i = 0; i < 2; i++) {
@@ -204,15 +180,17 @@ void trexRunnerDrawFrame(unsigned long nowMs) {
         if (o.type == OBS_PTERO) {
             int16_t py = (o.pteroY == 0) ? PTERO_Y1 : (o.pteroY == 1) ? PTERO_Y2 : PTERO_Y3;
             const uint8_t *bm = _pteroFrame ? pterodactyl_2_bitmap : pterodactyl_1_bitmap;
-            drawDinoBitmap(o.x, py + 20, bm, nullptr, true);
+            const uint8_t *mk = _pteroFrame ? pterodactyl_2_mask   : pterodactyl_1_mask;
+            spriteBlit(o.x, py + 20, bm, mk, true);
         } else {
             uint8_t idx = (uint8_t)o.type - (uint8_t)OBS_CACTUS_SB;
             const uint8_t *cbm = (const uint8_t*)pgm_read_ptr(&CACTI_BMP[idx]);
-            drawDinoBitmap(o.x, CACTUS_Y, cbm, nullptr, true);
+            const uint8_t *cmk = (const uint8_t*)pgm_read_ptr(&CACTI_MSK[idx]);
+            spriteBlit(o.x, CACTUS_Y, cbm, cmk, true);
         }
     }
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 void trexRunnerDrawGameOver() {
@@ -228,7 +206,7 @@ void trexRunnerDrawGameOver() {
     const char *hint = "TAP=retry  HOLD=exit";
     u8g2.drawStr((128 - u8g2.getStrWidth(hint)) / 2, 62, hint);
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 TrexRunnerAction trexRunnerOnGesture(TrexRunnerGestureType g) {
@@ -255,12 +233,8 @@ static bool trexAABB(int16_t tx, int16_t ty, uint8_t tw, uint8_t th, bool trexDu
     return tRight >= oLeft && tLeft <= oRight && tBottom >= oTop && tTop <= oBottom;
 }
 
-bool trexRunnerTick(unsigned long nowMs) {
-    if (nowMs - _lastTickMs < GAME_TICK_MS) return false;
-    _lastTickMs = nowMs;
-
-    if (_dead) return false;
-
+// One fixed GAME_TICK_MS physics step.  Returns true on collision.
+static bool trexStepOnce() {
     if (!_onGround) {
         if (_ducking && _velY < 0) _velY = 0;
         _trexY += _velY;
@@ -324,6 +298,15 @@ bool trexRunnerTick(unsigned long nowMs) {
     return false;
 }
 
+bool trexRunnerTick(unsigned long nowMs) {
+    uint8_t steps = gameTimestepSteps(&_lastTickMs, nowMs, GAME_TICK_MS);
+    if (steps == 0 || _dead) return false;
+    while (steps--) {
+        if (trexStepOnce()) return true;  // collision mid-catchup ends the run
+    }
+    return false;
+}
+
 uint32_t trexRunnerGetScore() { return _score; }
 
 void trexRunnerApplyJump() {
@@ -0,0 +1,39 @@
+// ==========================================================================
+//  QBIT -- Outbound HTTP worker task
+// ==========================================================================
+#include "http_worker.h"
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+
+// Depth 4 covers the worst realistic pile-up (a 45 s version-check stall
+// with the weather poll ticking behind it); TLS handshakes in the jobs
+// need the large stack.
+#define HTTP_WORKER_QUEUE_DEPTH 4
+#define HTTP_WORKER_STACK       8192
+#define HTTP_WORKER_PRIORITY    0   // below networkTask (1): runs in its idle gaps
+
+static QueueHandle_t _httpJobQueue = nullptr;
+
+static void httpWorkerTask(void *pv) {
+    (void)pv;
+    HttpJobFn fn;
+    for (;;) {
+        if (xQueueReceive(_httpJobQueue, &fn, portMAX_DELAY) == pdPASS && fn) {
+            fn();
+        }
+    }
+}
+
+void httpWorkerInit() {
+    if (_httpJobQueue) return;
+    _httpJobQueue = xQueueCreate(HTTP_WORKER_QUEUE_DEPTH, sizeof(HttpJobFn));
+    xTaskCreate(httpWorkerTask, "http", HTTP_WORKER_STACK, NULL,
+                HTTP_WORKER_PRIORITY, NULL);
+}
+
+bool httpWorkerEnqueue(HttpJobFn fn) {
+    if (!_httpJobQueue || !fn) return false;
+    return xQueueSend(_httpJobQueue, &fn, 0) == pdPASS;
+}
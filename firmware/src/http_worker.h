@@ -0,0 +1,23 @@
+// ==========================================================================
+//  QBIT -- Outbound HTTP worker task
+// ==========================================================================
+// All blocking third-party HTTP (version check, ip-api timezone lookup,
+// weather fetch) runs on a low-priority worker fed by a job queue, so a
+// slow origin can never stall the network task's WS poll / MQTT keepalive
+// cadence.  Jobs are plain function pointers; the functions themselves
+// post their results through the same cross-task paths they already used
+// when they ran inline (globals, settings, network events).
+#ifndef HTTP_WORKER_H
+#define HTTP_WORKER_H
+
+typedef void (*HttpJobFn)();
+
+// Create the job queue and the worker task (priority below networkTask).
+// Call once from setup(), before the network task starts enqueueing.
+void httpWorkerInit();
+
+// Queue a job for the worker; returns false when the queue is full (all
+// callers are periodic, so a dropped job simply runs on the next cadence).
+bool httpWorkerEnqueue(HttpJobFn fn);
+
+#endif // HTTP_WORKER_H
@@ -1,40 +1,88 @@
 // ==========================================================================
-//  QBIT -- Input task (touch gesture state machine)
+//  QBIT -- Input task (touch gesture state machine, interrupt driven)
 // ==========================================================================
+// The touch pin fires an edge interrupt on CHANGE; the ISR timestamps the
+// edge and queues it.  The task blocks on that queue with a timeout equal
+// to the next state-machine deadline (long-press while held, double-tap
+// window after a short tap, forever when idle), so tap latency is bounded
+// by interrupt dispatch instead of a polling quantum and the task sleeps
+// completely while the device is untouched.
 #include "input_task.h"
 #include "app_state.h"
 #include "settings.h"
 #include <Arduino.h>
+#include <esp_timer.h>
 
 // Gesture state machine
 enum TouchState {
     TOUCH_IDLE,
     TOUCH_TOUCHED,
+    TOUCH_WAIT_RELEASE,      // long press / double tap reported, held down
     TOUCH_WAIT_SECOND_TAP
 };
 
 #define LONG_PRESS_MS      900
 #define DOUBLE_TAP_WINDOW  300
-#define POLL_INTERVAL_MS   10
+#define EDGE_QUEUE_LEN     16
+
+// One pin edge as seen by the ISR.  The TTP223 touch module output is
+// debounced in hardware, so edges map 1:1 to touch/release.
+struct TouchEdge {
+    bool          high;
+    unsigned long ms;
+};
+
+static QueueHandle_t _edgeQueue = nullptr;
+static uint8_t       _touchPin  = 0;
+
+static void IRAM_ATTR touchIsr() {
+    TouchEdge edge;
+    edge.high = (digitalRead(_touchPin) == HIGH);
+    edge.ms   = (unsigned long)(esp_timer_get_time() / 1000ULL);
+    BaseType_t woken = pdFALSE;
+    xQueueSendFromISR(_edgeQueue, &edge, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
 
 void inputTask(void *param) {
     (void)param;
 
+    _touchPin  = getPinTouch();
+    _edgeQueue = xQueueCreate(EDGE_QUEUE_LEN, sizeof(TouchEdge));
+    attachInterrupt(digitalPinToInterrupt(_touchPin), touchIsr, CHANGE);
+
     TouchState state = TOUCH_IDLE;
     unsigned long touchDownMs = 0;
     unsigned long releaseMs   = 0;
 
     for (;;) {
-        bool pinHigh = (digitalRead(getPinTouch()) == HIGH);
+        // Block until the next edge or the next state-machine deadline.
+        TickType_t wait = portMAX_DELAY;
         unsigned long now = millis();
+        if (state == TOUCH_TOUCHED) {
+            unsigned long due = touchDownMs + LONG_PRESS_MS;
+            wait = (due > now) ? pdMS_TO_TICKS(due - now) : 0;
+        } else if (state == TOUCH_WAIT_SECOND_TAP) {
+            unsigned long due = releaseMs + DOUBLE_TAP_WINDOW;
+            wait = (due > now) ? pdMS_TO_TICKS(due - now) : 0;
+        }
+
+        TouchEdge edge;
+        bool gotEdge = (xQueueReceive(_edgeQueue, &edge, wait) == pdTRUE);
+
+        now = millis();
+        // Edge wake: trust the ISR snapshot (level + timestamp).  Deadline
+        // wake: re-read the pin so a missed edge cannot wedge the machine.
+        bool          pinHigh = gotEdge ? edge.high : (digitalRead(_touchPin) == HIGH);
+        unsigned long evtMs   = gotEdge ? edge.ms   : now;
 
         switch (state) {
             case TOUCH_IDLE:
                 if (pinHigh) {
                     state = TOUCH_TOUCHED;
-                    touchDownMs = now;
+                    touchDownMs = evtMs;
                     // Immediate touch feedback
-                    GestureEvent tdEvt = { TOUCH_DOWN, now };
+                    GestureEvent tdEvt = { TOUCH_DOWN, evtMs };
                     xQueueSend(gestureQueue, &tdEvt, 0);
                 }
                 break;
@@ -45,44 +93,40 @@ void inputTask(void *param) {
                     if (now - touchDownMs >= LONG_PRESS_MS) {
                         GestureEvent evt = { LONG_PRESS, now };
                         xQueueSend(gestureQueue, &evt, 0);
-                        // Wait for release
-                        while (digitalRead(getPinTouch()) == HIGH) {
-                            vTaskDelay(pdMS_TO_TICKS(POLL_INTERVAL_MS));
-                        }
-                        GestureEvent upEvt = { TOUCH_UP, millis() };
-                        xQueueSend(gestureQueue, &upEvt, 0);
-                        state = TOUCH_IDLE;
+                        state = TOUCH_WAIT_RELEASE;
                     }
                 } else {
-                    GestureEvent upEvt = { TOUCH_UP, now };
+                    GestureEvent upEvt = { TOUCH_UP, evtMs };
                     xQueueSend(gestureQueue, &upEvt, 0);
                     // Released — was it a short tap?
-                    unsigned long held = now - touchDownMs;
+                    unsigned long held = evtMs - touchDownMs;
                     if (held < DOUBLE_TAP_WINDOW) {
                         // Short tap — wait for possible second tap
                         state = TOUCH_WAIT_SECOND_TAP;
-                        releaseMs = now;
+                        releaseMs = evtMs;
                     } else {
                         // Longer than double-tap window but shorter than long press
-                        GestureEvent evt = { SINGLE_TAP, now };
+                        GestureEvent evt = { SINGLE_TAP, evtMs };
                         xQueueSend(gestureQueue, &evt, 0);
                         state = TOUCH_IDLE;
                     }
                 }
                 break;
 
+            case TOUCH_WAIT_RELEASE:
+                if (!pinHigh) {
+                    GestureEvent upEvt = { TOUCH_UP, evtMs };
+                    xQueueSend(gestureQueue, &upEvt, 0);
+                    state = TOUCH_IDLE;
+                }
+                break;
+
             case TOUCH_WAIT_SECOND_TAP:
                 if (pinHigh) {
                     // Second tap detected within window
-                    GestureEvent evt = { DOUBLE_TAP, now };
+                    GestureEvent evt = { DOUBLE_TAP, evtMs };
                     xQueueSend(gestureQueue, &evt, 0);
-                    // Wait for release
-                    while (digitalRead(getPinTouch()) == HIGH) {
-                        vTaskDelay(pdMS_TO_TICKS(POLL_INTERVAL_MS));
-                    }
-                    GestureEvent upEvt = { TOUCH_UP, millis() };
-                    xQueueSend(gestureQueue, &upEvt, 0);
-                    state = TOUCH_IDLE;
+                    state = TOUCH_WAIT_RELEASE;
                 } else if (now - releaseMs >= DOUBLE_TAP_WINDOW) {
                     // Timeout — it was a single tap
                     GestureEvent evt = { SINGLE_TAP, now };
@@ -91,7 +135,5 @@ void inputTask(void *param) {
                 }
                 break;
         }
-
-        vTaskDelay(pdMS_TO_TICKS(POLL_INTERVAL_MS));
     }
 }
@@ -8,7 +8,6 @@
 #include <U8g2lib.h>
 #include <Wire.h>
 #include <NetWizard.h>
-#include <ESPmDNS.h>
 #include <new>
 
 #include "app_state.h"
@@ -19,9 +18,13 @@
 #include "display_task.h"
 #include "network_task.h"
 #include "input_task.h"
+#include "http_worker.h"
+#include "qlog.h"
+#include "perf_stats.h"
+#include "qheap.h"
 
 #include "gif_types.h"
-#include "sys_idle.h"
+#include "sys_anim.h"
 
 // ==========================================================================
 //  Web server (shared by NetWizard and web dashboard)
@@ -30,6 +33,10 @@
 AsyncWebServer server(80);
 NetWizard      NW(&server);
 
+// Power-on to gesture-handling budget; exceeding it is logged (and the
+// per-stage breakdown lands in /api/stats under boot.stages).
+#define BOOT_INTERACTIVE_BUDGET_MS 2000
+
 // ==========================================================================
 //  Arduino setup()
 // ==========================================================================
@@ -37,11 +44,15 @@ NetWizard      NW(&server);
 void setup() {
     Serial.begin(115200);
     Serial.setDebugOutput(false);
+    qheapInit();   // failed-alloc hook, before anything allocates
+    uint32_t tStage = millis();
 
     // 1. NVS + pin config
     settingsInit();
     pinMode(getPinTouch(), INPUT);
     pinMode(getPinBuzzer(), OUTPUT);
+    perfStatsNoteBootStage("settings", millis() - tStage);
+    tStage = millis();
 
     // 2. Display (reconstruct U8G2 with NVS pins)
     new (&u8g2) U8G2_SSD1306_128X64_NONAME_F_HW_I2C(
@@ -50,6 +61,8 @@ void setup() {
     u8g2.begin();
     clearFullGDDRAM();
     setDisplayInvert(false);
+    perfStatsNoteBootStage("display", millis() - tStage);
+    tStage = millis();
 
     // 3. Load settings + apply brightness
     loadSettings();
@@ -57,14 +70,17 @@ void setup() {
 
     // 4. Create RTOS primitives
     gestureQueue      = xQueueCreate(8, sizeof(GestureEvent));
-    networkEventQueue = xQueueCreate(16, sizeof(NetworkEvent));
+    networkEventQueue = xQueueCreate(16, sizeof(NetworkEvent *));  // pooled events, pointers only
     connectivityBits  = xEventGroupCreate();
     displayMutex      = xSemaphoreCreateMutex();
     gifPlayerMutex    = xSemaphoreCreateMutex();
 
-    // 5. GIF player + idle animation
+    // 5. GIF player + system animations (mapped from the 'anim' partition)
+    sysAnimInit();
     gifPlayerInit(&u8g2);
-    gifPlayerSetIdleAnimation(&sys_idle_gif);
+    gifPlayerSetIdleAnimation(sysAnimIdle());
+    perfStatsNoteBootStage("gifPlayer", millis() - tStage);
+    tStage = millis();
 
     // 6. Start display task early so boot animation runs while WiFi and server init in parallel
     xTaskCreate(displayTask, "display", 8192, NULL, 2, NULL);
@@ -94,40 +110,24 @@ void setup() {
     NW.autoConnect("QBIT", apPwd.c_str());
     // Apply AP RF stability for ESP32-C3 PCB antenna after NetWizard (fixes #2). Does not change mode; AP_STA kept for portal.
     wifiApplyApRfStabilityForPcbAntenna();
-
-    // 8. mDNS
-    if (MDNS.begin("qbit")) {
-        MDNS.addService("http", "tcp", 80);
-    }
-
-    // 9. Web dashboard + server
-    webDashboardInit(server);
-    // Wire cam WebSocket connect/disconnect → display task state machine
-    webCamSetCallbacks(
-        []() {
-            NetworkEvent evt = {};
-            evt.kind = NetworkEvent::CAM_START;
-            BaseType_t ok = xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(10));
-            if (ok != pdPASS) {
-                Serial.println("WARN: failed to enqueue CAM_START");
-            }
-        },
-        []() {
-            NetworkEvent evt = {};
-            evt.kind = NetworkEvent::CAM_STOP;
-            BaseType_t ok = xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(10));
-            if (ok != pdPASS) {
-                Serial.println("WARN: failed to enqueue CAM_STOP");
-            }
-        }
-    );
-    server.begin();
-
-    Serial.println("Web server started");
-
-    // 10. Launch network and input tasks
+    perfStatsNoteBootStage("netwizard", millis() - tStage);
+
+    // 8. Launch network and input tasks (plus the HTTP worker the network
+    //    task hands its blocking third-party fetches to). Dashboard route
+    //    registration + server.begin() run at the top of the network task,
+    //    and mDNS starts once STA is actually up -- neither belongs on the
+    //    path between power-on and the first handled gesture.
+    httpWorkerInit();
     xTaskCreate(networkTask, "network", 8192, NULL, 1, NULL);
     xTaskCreate(inputTask,   "input",   2048, NULL, 3, NULL);
+
+    uint32_t interactiveMs = millis();
+    perfStatsNoteBootInteractive(interactiveMs);
+    if (interactiveMs > BOOT_INTERACTIVE_BUDGET_MS)
+        qlogWarn("boot interactive in %lums (budget %ums)",
+                 (unsigned long)interactiveMs, BOOT_INTERACTIVE_BUDGET_MS);
+    else
+        qlogInfo("boot interactive in %lums", (unsigned long)interactiveMs);
 }
 
 // ==========================================================================
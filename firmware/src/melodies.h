@@ -1,6 +1,9 @@
 // ==========================================================================
-//  QBIT -- RTTTL melody constants
+//  QBIT -- RTTTL melody sources
 // ==========================================================================
+// Human-editable source of truth only: the firmware plays the packed note
+// arrays in melodies_compiled.h, regenerated from these strings with
+//   python3 tools/compile_melodies.py
 #ifndef MELODIES_H
 #define MELODIES_H
 
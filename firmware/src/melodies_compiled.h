@@ -0,0 +1,71 @@
+// ==========================================================================
+//  QBIT -- Precompiled melodies (generated -- do not edit)
+// ==========================================================================
+// Generated from the RTTTL strings in melodies.h by
+// tools/compile_melodies.py.  Edit melodies.h and re-run the script.
+#ifndef MELODIES_COMPILED_H
+#define MELODIES_COMPILED_H
+
+#include "melody_player.h"
+
+// tronboot
+static const MelodyNote BOOT_MELODY_NOTES[] PROGMEM = {
+    {523, 94}, {0, 94}, {784, 94}, {0, 94}, {1047, 94}, {0, 94}, {988, 94}, {880, 188},
+};
+static const Melody BOOT_MELODY = {BOOT_MELODY_NOTES, 8};
+
+// coin
+static const MelodyNote TOUCH_MELODY_NOTES[] PROGMEM = {
+    {988, 25}, {1319, 25},
+};
+static const Melody TOUCH_MELODY = {TOUCH_MELODY_NOTES, 2};
+
+// poke
+static const MelodyNote POKE_MELODY_NOTES[] PROGMEM = {
+    {1047, 75}, {1319, 75}, {1568, 75}, {2093, 75},
+};
+static const Melody POKE_MELODY = {POKE_MELODY_NOTES, 4};
+
+// claim
+static const MelodyNote CLAIM_MELODY_NOTES[] PROGMEM = {
+    {659, 167}, {784, 167}, {988, 167},
+};
+static const Melody CLAIM_MELODY = {CLAIM_MELODY_NOTES, 3};
+
+// mute
+static const MelodyNote MUTE_MELODY_NOTES[] PROGMEM = {
+    {784, 75}, {523, 75},
+};
+static const Melody MUTE_MELODY = {MUTE_MELODY_NOTES, 2};
+
+// unmute
+static const MelodyNote UNMUTE_MELODY_NOTES[] PROGMEM = {
+    {523, 75}, {784, 75},
+};
+static const Melody UNMUTE_MELODY = {UNMUTE_MELODY_NOTES, 2};
+
+// timer
+static const MelodyNote TIMER_MELODY_NOTES[] PROGMEM = {
+    {1047, 150}, {1047, 150}, {1319, 150}, {1047, 150}, {1319, 150}, {1568, 150},
+};
+static const Melody TIMER_MELODY = {TIMER_MELODY_NOTES, 6};
+
+// carstart
+static const MelodyNote CAR_START_MELODY_NOTES[] PROGMEM = {
+    {523, 62}, {659, 62}, {784, 62}, {1047, 62},
+};
+static const Melody CAR_START_MELODY = {CAR_START_MELODY_NOTES, 4};
+
+// nearmiss
+static const MelodyNote CAR_NEAR_MELODY_NOTES[] PROGMEM = {
+    {1047, 19}, {0, 150}, {1047, 19},
+};
+static const Melody CAR_NEAR_MELODY = {CAR_NEAR_MELODY_NOTES, 3};
+
+// carcrash
+static const MelodyNote CAR_CRASH_MELODY_NOTES[] PROGMEM = {
+    {880, 250}, {698, 250}, {523, 250},
+};
+static const Melody CAR_CRASH_MELODY = {CAR_CRASH_MELODY_NOTES, 3};
+
+#endif // MELODIES_COMPILED_H
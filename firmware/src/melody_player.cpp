@@ -0,0 +1,52 @@
+// ==========================================================================
+//  QBIT -- Precompiled melody player
+// ==========================================================================
+#include "melody_player.h"
+
+static const MelodyNote *_notes      = nullptr;
+static uint8_t           _noteCount  = 0;
+static uint8_t           _noteIdx    = 0;
+static uint8_t           _pin        = 0;
+static unsigned long     _noteEndMs  = 0;
+static bool              _playing    = false;
+
+static void melodyStartNote() {
+    const MelodyNote &n = _notes[_noteIdx];
+    if (n.freq > 0) {
+        // Sound for 7/8 of the slot so repeated notes (e.g. the timer
+        // alarm's c6,c6) stay articulated instead of slurring together.
+        tone(_pin, n.freq, n.durMs - (n.durMs >> 3));
+    } else {
+        noTone(_pin);
+    }
+    _noteEndMs = millis() + n.durMs;
+}
+
+void melodyBegin(uint8_t pin, const Melody &m) {
+    if (m.count == 0 || m.notes == nullptr) return;
+    _pin       = pin;
+    _notes     = m.notes;
+    _noteCount = m.count;
+    _noteIdx   = 0;
+    _playing   = true;
+    melodyStartNote();
+}
+
+void melodyTick() {
+    if (!_playing) return;
+    if ((long)(millis() - _noteEndMs) < 0) return;
+    if (++_noteIdx >= _noteCount) {
+        melodyStop();
+        return;
+    }
+    melodyStartNote();
+}
+
+bool melodyIsPlaying() {
+    return _playing;
+}
+
+void melodyStop() {
+    _playing = false;
+    if (_notes) noTone(_pin);
+}
@@ -0,0 +1,36 @@
+// ==========================================================================
+//  QBIT -- Precompiled melody player
+// ==========================================================================
+// Plays the packed (frequency, duration) note arrays produced by
+// tools/compile_melodies.py from melodies.h.  Replaces per-note RTTTL
+// string parsing at play time: starting or advancing a note is an array
+// index and a tone() call, which matters because pokes arrive exactly
+// when the display task is also decoding bitmaps and redrawing.
+#ifndef MELODY_PLAYER_H
+#define MELODY_PLAYER_H
+
+#include <Arduino.h>
+
+struct MelodyNote {
+    uint16_t freq;   // Hz; 0 = rest
+    uint16_t durMs;
+};
+
+struct Melody {
+    const MelodyNote *notes;
+    uint8_t           count;
+};
+
+// Start a melody on the buzzer pin (restarts if one is already playing).
+void melodyBegin(uint8_t pin, const Melody &m);
+
+// Advance playback; call from the display loop (cheap no-op when idle or
+// mid-note).  O(1) per note transition.
+void melodyTick();
+
+bool melodyIsPlaying();
+
+// Stop playback and silence the pin.
+void melodyStop();
+
+#endif // MELODY_PLAYER_H
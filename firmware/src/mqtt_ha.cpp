@@ -7,7 +7,54 @@
 #include <ArduinoJson.h>
 #include <WiFi.h>
 
-void mqttPublishHADiscovery(PubSubClient *client) {
+// ==========================================================================
+//  Discovery payload cache
+// ==========================================================================
+// Topics and payloads only depend on device id, device name and the MQTT
+// prefix, all fixed after settingsInit (name/prefix can change via the
+// dashboard, which the signature check below catches).  They are built
+// once into a static arena; a broker reconnect then republishes from the
+// cached buffers with zero heap allocation, so reconnect storms on flaky
+// APs no longer fragment the heap.
+
+#define HA_DISCOVERY_MAX 9
+#define HA_ARENA_SIZE    5120
+
+struct HaEntry {
+    uint16_t topicOff;    // NUL-terminated topic in _haArena
+    uint16_t payloadOff;  // NUL-terminated JSON payload in _haArena
+};
+
+static char    _haArena[HA_ARENA_SIZE];
+static HaEntry _haEntries[HA_DISCOVERY_MAX];
+static uint8_t _haCount     = 0;
+static size_t  _haUsed      = 0;
+static String  _haSignature;  // id + name + prefix the cache was built with
+
+// Copy topic + serialized doc into the arena and record the entry.
+static bool haCacheAdd(const String &topic, const JsonDocument &doc) {
+    size_t tLen = topic.length() + 1;
+    size_t pLen = measureJson(doc) + 1;
+    if (_haCount >= HA_DISCOVERY_MAX || _haUsed + tLen + pLen > HA_ARENA_SIZE) {
+        Serial.println("[MQTT] HA discovery cache full -- entry dropped");
+        return false;
+    }
+    HaEntry &e = _haEntries[_haCount++];
+    e.topicOff = (uint16_t)_haUsed;
+    memcpy(_haArena + _haUsed, topic.c_str(), tLen);
+    _haUsed += tLen;
+    e.payloadOff = (uint16_t)_haUsed;
+    serializeJson(doc, _haArena + _haUsed, pLen);
+    _haUsed += pLen;
+    return true;
+}
+
+// Build every discovery topic + payload into the arena (one-time cost;
+// the Strings here are freed again before any reconnect loop runs).
+static void haCacheBuild() {
+    _haCount = 0;
+    _haUsed  = 0;
+
     String id    = getDeviceId();
     String idLow = id;
     idLow.toLowerCase();
@@ -35,9 +82,7 @@ void mqttPublishHADiscovery(PubSubClient *client) {
         doc["pl_off"]            = "offline";
         doc["dev_cla"]           = "connectivity";
         doc["dev"]               = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
     }
 
     // --- Binary sensor: cloud / backend WebSocket (device register WS) ---
@@ -53,9 +98,7 @@ void mqttPublishHADiscovery(PubSubClient *client) {
         doc["dev_cla"]           = "connectivity";
         doc["icon"]              = "mdi:cloud-outline";
         doc["dev"]               = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
     }
 
     // --- Sensor: IP address ---
@@ -69,9 +112,7 @@ void mqttPublishHADiscovery(PubSubClient *client) {
         doc["val_tpl"]           = "{{ value_json.ip }}";
         doc["icon"]              = "mdi:ip-network";
         doc["dev"]               = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
     }
 
     // --- Button: poke trigger ---
@@ -93,9 +134,7 @@ void mqttPublishHADiscovery(PubSubClient *client) {
 
         doc["icon"]         = "mdi:hand-wave";
         doc["dev"]          = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
     }
 
     // --- Text: poke message (HA max 64 to avoid ValueError on paste; device uses first 25 only) ---
@@ -109,9 +148,7 @@ void mqttPublishHADiscovery(PubSubClient *client) {
         doc["max"]               = 64;
         doc["icon"]              = "mdi:message-text-outline";
         doc["dev"]               = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
     }
 
     // --- Sensor: last poke received ---
@@ -127,9 +164,7 @@ void mqttPublishHADiscovery(PubSubClient *client) {
         doc["json_attr_t"]       = prefix + "/" + id + "/poke";
         doc["json_attr_tpl"]     = "{{ {'sender': value_json.sender, 'message': value_json.text, 'time': value_json.time} | tojson }}";
         doc["dev"]               = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
     }
 
     // --- Switch: mute ---
@@ -143,9 +178,7 @@ void mqttPublishHADiscovery(PubSubClient *client) {
         doc["cmd_t"]             = prefix + "/" + id + "/mute/set";
         doc["icon"]              = "mdi:volume-off";
         doc["dev"]               = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
     }
 
     // --- Sensor: touch ---
@@ -160,9 +193,7 @@ void mqttPublishHADiscovery(PubSubClient *client) {
         doc["frc_upd"]           = true;
         doc["icon"]              = "mdi:gesture-tap";
         doc["dev"]               = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
     }
 
     // --- Button: next animation ---
@@ -175,9 +206,24 @@ void mqttPublishHADiscovery(PubSubClient *client) {
         doc["cmd_t"]             = prefix + "/" + id + "/animation/next";
         doc["icon"]              = "mdi:skip-next";
         doc["dev"]               = devBlock;
-        String payload;
-        serializeJson(doc, payload);
-        client->publish(topic.c_str(), payload.c_str(), true);
+        haCacheAdd(topic, doc);
+    }
+
+    Serial.printf("[MQTT] HA discovery cache built: %u entities, %u bytes\n",
+                  _haCount, (unsigned)_haUsed);
+}
+
+void mqttPublishHADiscovery(PubSubClient *client) {
+    String sig = getDeviceId() + "\n" + getDeviceName() + "\n" + getMqttPrefix();
+    if (_haCount == 0 || sig != _haSignature) {
+        haCacheBuild();
+        _haSignature = sig;
+    }
+
+    // Allocation-free batch publish from the cached buffers
+    for (uint8_t i = 0; i < _haCount; i++) {
+        client->publish(_haArena + _haEntries[i].topicOff,
+                        _haArena + _haEntries[i].payloadOff, true);
     }
 
     Serial.println("[MQTT] HA discovery config published");
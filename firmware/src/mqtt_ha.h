@@ -16,5 +16,7 @@ void mqttPublishMuteState(bool muted);
 void mqttPublishTouchEvent(GestureType type);
 void mqttPublishAnimationState(const String &filename);
 void mqttPublishServerConnectionState(bool connected);
+void mqttPublishPerfStats();
+void mqttPublishHeapStats();
 
 #endif // MQTT_HA_H
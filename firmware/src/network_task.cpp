@@ -7,12 +7,24 @@
 #include "time_manager.h"
 #include "mqtt_ha.h"
 #include "poke_handler.h"
+#include "perf_stats.h"
+#include "qheap.h"
+#include "qtrace.h"
+#include "weather/weather_screen.h"
+#include "power_governor.h"
+#include "ota_updater.h"
+#include "http_worker.h"
+#include "web_dashboard.h"
+#include "session_snapshot.h"
+#include "qlog.h"
 
 #include <WiFi.h>
 #include <WiFiClientSecure.h>
+#include <WiFiUdp.h>
 #include <HTTPClient.h>
 #include <NetWizard.h>
 #include <ESPmDNS.h>
+#include <Preferences.h>
 #include <ArduinoJson.h>
 #include <ArduinoWebsockets.h>
 #include <PubSubClient.h>
@@ -39,7 +51,14 @@
 #ifndef WS_API_KEY
 #define WS_API_KEY      ""
 #endif
-#define WS_RECONNECT_MS 5000
+// WS reconnect uses jittered exponential backoff: first retry is fast (a
+// router blip costs ~1s of cloud link), then doubles toward the ceiling so a
+// fleet that loses the server together does not hammer it back in lockstep.
+#define WS_RECONNECT_MIN_MS 1000
+#define WS_RECONNECT_MAX_MS 60000
+#define WS_PING_INTERVAL_MS   30000    // WS keepalive ping; pong time feeds /api/stats RTT
+#define WS_PONG_TIMEOUT_MS    10000    // no pong by then = half-dead link, reconnect now
+#define PERF_STATS_PUBLISH_MS 60000    // periodic MQTT telemetry interval
 #define WIFI_RECONNECT_TIMEOUT_MS 15000
 #define PORTAL_RETRY_INTERVAL_MS  30000    // while AP is up, retry saved WiFi in background every 30s
 // NetWizard stopPortal() forces WiFi.mode(STA)+reconnect; WL_CONNECTED can drop briefly. Skip
@@ -52,6 +71,24 @@
 #define POKE_BMP_MAX_WIDTH  512
 #define POKE_BMP_MAX_PAGES 8
 
+// Binary poke frame (server opts in after seeing "binProto":1 in
+// device.register; JSON pokes remain supported for older backends).
+// Bitmap bytes travel raw instead of base64, so receive is a single
+// exact-size allocation + memcpy with no decode step or String churn.
+//   [0]      uint8   msg type   (WS_BIN_POKE / WS_BIN_BROADCAST)
+//   [1]      uint8   senderLen  (bytes, not NUL-terminated)
+//   [2]      uint8   textLen
+//   [3]      uint8   titleLen   (0 for poke)
+//   [4..5]   uint16  senderBmpWidth (LE; 0 = text-only poke)
+//   [6..7]   uint16  senderBmpLen   (LE)
+//   [8..9]   uint16  textBmpWidth   (LE)
+//   [10..11] uint16  textBmpLen     (LE)
+//   [12..]   sender, text, title, senderBmp, textBmp  (packed, in order)
+#define WS_BINPROTO_VERSION 1
+#define WS_BIN_POKE         1
+#define WS_BIN_BROADCAST    2
+#define WS_BIN_HDR_SIZE     12
+
 // Validate decoded bitmap size matches claimed width (no integer overflow / OOB).
 static bool isValidBitmapSize(uint16_t width, size_t decodedLen) {
     if (width == 0 || width > POKE_BMP_MAX_WIDTH) return false;
@@ -61,6 +98,207 @@ static bool isValidBitmapSize(uint16_t width, size_t decodedLen) {
     return pages <= POKE_BMP_MAX_PAGES;
 }
 
+// ==========================================================================
+//  Poke burst coalescing
+// ==========================================================================
+// When the display task is pinned (mid-game, scroll render) the event queue
+// fills and pokes used to be dropped silently -- during a poke storm some
+// messages simply never arrived, and queued bitmap pokes pinned their heap
+// buffers while waiting.  A poke that fails to enqueue now lands here: the
+// {sender, text} pair is retained in a bounded ring and a single
+// POKE_SUMMARY event is retried until it fits, which the display task turns
+// into batched history inserts plus one "N NEW POKES" screen.  Bitmaps are
+// freed at coalesce time (the text fallback reaches history), so burst
+// memory is bounded by the ring, not the burst length.
+
+#define POKE_COALESCE_MAX 8   // retained pairs; older ones past this are counted as drops
+
+struct CoalescedPoke {
+    char sender[33];
+    char text[65];
+};
+static CoalescedPoke _pokeCoalesced[POKE_COALESCE_MAX];
+static uint8_t       _pokeCoalescedHead  = 0;
+static uint8_t       _pokeCoalescedCount = 0;
+static uint16_t      _pokeCoalescedTotal = 0;   // absorbed since last summary
+static portMUX_TYPE  _pokeCoalesceMux    = portMUX_INITIALIZER_UNLOCKED;
+
+static void pokeCoalesce(const char *sender, const char *text) {
+    bool evicted = false;
+    portENTER_CRITICAL(&_pokeCoalesceMux);
+    if (_pokeCoalescedCount >= POKE_COALESCE_MAX) {
+        // Keep the newest pokes; the evicted one is lost to history too.
+        _pokeCoalescedHead = (uint8_t)((_pokeCoalescedHead + 1) % POKE_COALESCE_MAX);
+        _pokeCoalescedCount--;
+        evicted = true;
+    }
+    CoalescedPoke &slot =
+        _pokeCoalesced[(_pokeCoalescedHead + _pokeCoalescedCount) % POKE_COALESCE_MAX];
+    strncpy(slot.sender, (sender && sender[0]) ? sender : "Someone",
+            sizeof(slot.sender) - 1);
+    slot.sender[sizeof(slot.sender) - 1] = '\0';
+    strncpy(slot.text, (text && text[0]) ? text : "Poke!", sizeof(slot.text) - 1);
+    slot.text[sizeof(slot.text) - 1] = '\0';
+    _pokeCoalescedCount++;
+    if (_pokeCoalescedTotal < 0xFFFF) _pokeCoalescedTotal++;
+    portEXIT_CRITICAL(&_pokeCoalesceMux);
+    perfStatsCountCoalescedPoke();
+    if (evicted) perfStatsCountEventDrop();
+}
+
+uint8_t networkCoalescedPokeCount() {
+    portENTER_CRITICAL(&_pokeCoalesceMux);
+    uint8_t n = _pokeCoalescedCount;
+    portEXIT_CRITICAL(&_pokeCoalesceMux);
+    return n;
+}
+
+bool networkCoalescedPokePop(char *sender, char *text) {
+    portENTER_CRITICAL(&_pokeCoalesceMux);
+    if (_pokeCoalescedCount == 0) {
+        portEXIT_CRITICAL(&_pokeCoalesceMux);
+        return false;
+    }
+    const CoalescedPoke &slot = _pokeCoalesced[_pokeCoalescedHead];
+    strcpy(sender, slot.sender);
+    strcpy(text, slot.text);
+    _pokeCoalescedHead = (uint8_t)((_pokeCoalescedHead + 1) % POKE_COALESCE_MAX);
+    _pokeCoalescedCount--;
+    portEXIT_CRITICAL(&_pokeCoalesceMux);
+    return true;
+}
+
+// Called from the network task loop: while pokes sit coalesced, keep trying
+// to hand the display task one summary event until the queue has room.
+static void pokeCoalesceTick() {
+    portENTER_CRITICAL(&_pokeCoalesceMux);
+    uint16_t total = _pokeCoalescedTotal;
+    portEXIT_CRITICAL(&_pokeCoalesceMux);
+    if (total == 0) return;
+
+    NetworkEvent *evt = networkEventAcquire();
+    if (!evt) return;   // pool exhausted; retry next pass
+    evt->kind  = NetworkEvent::POKE_SUMMARY;
+    evt->count = total;
+    if (xQueueSend(networkEventQueue, &evt, 0) != pdTRUE) {
+        networkEventRelease(evt);
+        return;         // queue still full; entries stay put
+    }
+    portENTER_CRITICAL(&_pokeCoalesceMux);
+    _pokeCoalescedTotal = 0;
+    portEXIT_CRITICAL(&_pokeCoalesceMux);
+}
+
+// ==========================================================================
+//  Pooled event send helpers
+// ==========================================================================
+// Acquire-fill-send for events without bitmaps; the slot is released when
+// the send fails so pool entries cannot leak.  Bitmap events are built
+// inline at their call sites because they attach heap buffers.
+//
+// Overflow policy: claim/friend/connectivity events are never dropped --
+// they retry while the display task drains the queue (it does so every
+// pass, so one retry normally suffices).  Pokes fall back to the burst
+// coalescer above; anything else lost is counted on the stats surface.
+
+#define EVENT_CRITICAL_RETRIES  20
+#define EVENT_CRITICAL_RETRY_MS 100
+
+static void sendSimpleEvent(NetworkEvent::Kind kind, const char *sender,
+                            const char *text, const char *title,
+                            TickType_t wait) {
+    const bool critical = (kind == NetworkEvent::CLAIM_REQUEST ||
+                           kind == NetworkEvent::FRIEND_REQUEST);
+    for (int attempt = 0; ; attempt++) {
+        NetworkEvent *evt = networkEventAcquire();
+        if (evt) {
+            evt->kind = kind;
+            if (sender) strncpy(evt->sender, sender, sizeof(evt->sender) - 1);
+            if (text)   strncpy(evt->text,   text,   sizeof(evt->text)   - 1);
+            if (title)  strncpy(evt->title,  title,  sizeof(evt->title)  - 1);
+            if (xQueueSend(networkEventQueue, &evt, wait) == pdTRUE) return;
+            networkEventRelease(evt);
+        }
+        if (!critical || attempt >= EVENT_CRITICAL_RETRIES) break;
+        vTaskDelay(pdMS_TO_TICKS(EVENT_CRITICAL_RETRY_MS));
+    }
+    if (kind == NetworkEvent::POKE)
+        pokeCoalesce(sender, text);
+    else
+        perfStatsCountEventDrop();
+}
+
+static void sendStatusEvent(NetworkEvent::Kind kind, bool connected) {
+    // Connectivity transitions drive the offline overlay and reconnect UI;
+    // losing one leaves the screen lying about the link state, so retry
+    // like the claim/friend path.
+    for (int attempt = 0; ; attempt++) {
+        NetworkEvent *evt = networkEventAcquire();
+        if (evt) {
+            evt->kind      = kind;
+            evt->connected = connected;
+            if (xQueueSend(networkEventQueue, &evt, 0) == pdTRUE) return;
+            networkEventRelease(evt);
+        }
+        if (attempt >= EVENT_CRITICAL_RETRIES) break;
+        vTaskDelay(pdMS_TO_TICKS(EVENT_CRITICAL_RETRY_MS));
+    }
+    perfStatsCountEventDrop();
+}
+
+// ==========================================================================
+//  LAN poke fast path (UDP)
+// ==========================================================================
+// Pokes normally traverse sender -> cloud WS -> server -> device, paying
+// an internet round trip and dying with the uplink.  Devices advertise
+// _qbitpoke._udp through the existing mDNS responder; one JSON datagram
+// {"type":"poke","sender":...,"text":...} then lands in the same
+// NetworkEvent::POKE path as a cloud poke, so display, melody, history
+// and burst coalescing behave identically.  The socket is polled from
+// the network loop (~10 ms cadence), which keeps same-room delivery in
+// the tens of milliseconds and working through ISP outages.  This device
+// only receives pokes (there is no device-side send UI); LAN senders --
+// peer firmware, a LAN backend, tools/qbit-ctl -- pick this path when
+// mDNS discovery finds us and fall back to the cloud when it does not.
+
+#define QBIT_POKE_UDP_PORT 4949
+#define QBIT_POKE_UDP_MAX  512   // text pokes only; bitmaps stay on the WS path
+
+static WiFiUDP _pokeUdp;
+static bool    _pokeUdpUp = false;
+
+static void lanPokeStart() {
+    if (_pokeUdpUp) return;
+    _pokeUdpUp = (_pokeUdp.begin(QBIT_POKE_UDP_PORT) == 1);
+    if (!_pokeUdpUp) qlogWarn("lanPoke: UDP bind failed");
+}
+
+static void lanPokeTick() {
+    if (!_pokeUdpUp) return;
+    int len = _pokeUdp.parsePacket();
+    if (len <= 0) return;
+    if (len > QBIT_POKE_UDP_MAX) {   // oversized: not one of ours
+        _pokeUdp.flush();
+        return;
+    }
+
+    char buf[QBIT_POKE_UDP_MAX + 1];
+    int n = _pokeUdp.read((uint8_t *)buf, len);
+    if (n <= 0) return;
+    buf[n] = '\0';
+
+    StaticJsonDocument<768> doc;
+    if (deserializeJson(doc, buf, (size_t)n)) return;
+    if (strcmp(doc["type"] | "", "poke") != 0) return;
+    const char *sender = doc["sender"] | "";
+    const char *text   = doc["text"]   | "";
+    if (!sender[0]) return;
+
+    qlogInfo("lanPoke: poke from %s (%s)", sender,
+             _pokeUdp.remoteIP().toString().c_str());
+    sendSimpleEvent(NetworkEvent::POKE, sender, text, nullptr, 0);
+}
+
 // ==========================================================================
 //  External objects (created in main.cpp)
 // ==========================================================================
@@ -78,6 +316,13 @@ static bool             _wsConnected = false;
 // esp_timer_get_time() (us) at last WS ConnectionOpened; 0 if disconnected. Avoids millis() ~49.7d wrap.
 static int64_t          _wsCloudConnectedAtUs = 0;
 static unsigned long    _wsLastReconnect = 0;
+static unsigned long    _wsBackoffMs     = WS_RECONNECT_MIN_MS;   // next delay (pre-jitter)
+static unsigned long    _wsRetryAfterMs  = WS_RECONNECT_MIN_MS;   // jittered copy of _wsBackoffMs
+static char             _wsSession[17]   = "";   // per-boot resume token, see wsSessionToken()
+static unsigned long    _wsLastPingMs    = 0;
+static int64_t          _wsPingSentUs    = 0;   // esp_timer at last ping; 0 = no ping in flight
+static volatile bool    _wsConnectInFlight = false;  // http worker owns _wsClient while set
+static unsigned long    _perfStatsLastPublishMs = 0;
 
 // _wsConnected + _wsCloudConnectedAtUs are read from AsyncWeb handlers and written from WS / WiFi
 // paths; take a short critical section so int64 + bool are not observed torn on 32-bit MCUs.
@@ -126,6 +371,84 @@ static unsigned long _mqttLastReconnect = 0;
 static char _mqttHostStable[MQTT_HOST_MAX_LEN + 1] = {0};
 #define MQTT_RECONNECT_MS 5000
 
+// --- Outbound publish queue ---
+// PubSubClient::publish() is a blocking socket write on whatever task calls
+// it -- and several helpers below are called from the display task (mute /
+// animation / touch state). Publishes are therefore queued here and drained
+// by the network task loop, so every mqttPublish* helper is fire-and-forget
+// and all broker socket I/O stays on one task. A wedged broker costs queue
+// slots, not caller latency.
+#define MQTT_PUB_QUEUE_LEN    8
+#define MQTT_PUB_TOPIC_MAX    96
+#define MQTT_PUB_PAYLOAD_MAX  704   // largest payload is the ~600-byte stats JSON
+#define MQTT_PUB_DRAIN_BUDGET 2     // publishes per loop pass
+
+struct MqttPub {
+    char topic[MQTT_PUB_TOPIC_MAX];
+    char payload[MQTT_PUB_PAYLOAD_MAX];
+    bool retained;
+};
+static MqttPub      _mqttPubQueue[MQTT_PUB_QUEUE_LEN];
+static MqttPub      _mqttPubScratch;       // drain-side copy; network task only
+static uint8_t      _mqttPubHead    = 0;
+static uint8_t      _mqttPubCount   = 0;
+static uint32_t     _mqttPubDropped = 0;   // overflow drops (oldest entry evicted)
+static portMUX_TYPE _mqttPubMux     = portMUX_INITIALIZER_UNLOCKED;
+
+// Connected-state mirror the publish helpers can read without touching
+// _mqttClient from another task.
+static volatile bool _mqttUp = false;
+// True while the HTTP worker runs the blocking broker connect; the network
+// loop must not touch _mqttClient until it clears.
+static volatile bool _mqttConnectInFlight = false;
+
+static void mqttQueuePublish(const char *topic, const char *payload, bool retained) {
+    portENTER_CRITICAL(&_mqttPubMux);
+    if (_mqttPubCount >= MQTT_PUB_QUEUE_LEN) {
+        // Evict the oldest entry: later state publishes supersede earlier ones.
+        _mqttPubHead = (uint8_t)((_mqttPubHead + 1) % MQTT_PUB_QUEUE_LEN);
+        _mqttPubCount--;
+        _mqttPubDropped++;
+    }
+    MqttPub &slot = _mqttPubQueue[(_mqttPubHead + _mqttPubCount) % MQTT_PUB_QUEUE_LEN];
+    strncpy(slot.topic, topic, sizeof(slot.topic) - 1);
+    slot.topic[sizeof(slot.topic) - 1] = '\0';
+    strncpy(slot.payload, payload, sizeof(slot.payload) - 1);
+    slot.payload[sizeof(slot.payload) - 1] = '\0';
+    slot.retained = retained;
+    _mqttPubCount++;
+    portEXIT_CRITICAL(&_mqttPubMux);
+}
+
+// Called from the network task loop while the client is connected.
+static void mqttPubDrain() {
+    for (int i = 0; i < MQTT_PUB_DRAIN_BUDGET; i++) {
+        portENTER_CRITICAL(&_mqttPubMux);
+        if (_mqttPubCount == 0) {
+            portEXIT_CRITICAL(&_mqttPubMux);
+            return;
+        }
+        _mqttPubScratch = _mqttPubQueue[_mqttPubHead];
+        _mqttPubHead = (uint8_t)((_mqttPubHead + 1) % MQTT_PUB_QUEUE_LEN);
+        _mqttPubCount--;
+        portEXIT_CRITICAL(&_mqttPubMux);
+        // The publish duration is the TCP write time to the broker -- use it
+        // as the MQTT latency sample for the next stats snapshot.
+        int64_t t0 = esp_timer_get_time();
+        _mqttClient.publish(_mqttPubScratch.topic, _mqttPubScratch.payload,
+                            _mqttPubScratch.retained);
+        perfStatsNoteMqttRtt((uint32_t)((esp_timer_get_time() - t0) / 1000));
+    }
+}
+
+// Discard queued publishes (on disconnect -- stale events must not replay
+// after a reconnect; the connect sequence republishes the retained states).
+static void mqttPubFlush() {
+    portENTER_CRITICAL(&_mqttPubMux);
+    _mqttPubCount = 0;
+    portEXIT_CRITICAL(&_mqttPubMux);
+}
+
 static bool          _wifiConnected = false;
 static unsigned long _wifiLostMs    = 0;
 // True after STA has connected at least once this boot. Used with NW.isConfigured() so we
@@ -139,6 +462,7 @@ static unsigned long _portalRetryAfterMs              = 0;  // when to stop port
 static unsigned long _portalProvisionStopAfterMs      = 0;
 static unsigned long _versionCheckAfterMs             = 0;  // run version check after this time
 static unsigned long _tzCheckAfterMs                  = 0;  // run timezone detection after this time
+static unsigned long _weatherPrefetchAfterMs          = 0;  // poll background weather prefetch after this time
 static unsigned long _wifiSuppressDisconnectUiUntilMs = 0;
 static bool          _wifiDisconnectUiPending         = false;
 static bool          _nwPrevPortalSuccess            = false;
@@ -149,10 +473,150 @@ static unsigned long _reopenSetupPortalAfterMs = 0;
 // (otherwise ESP logs: "sta is connecting, return error").
 static unsigned long _portalBgConnectEarliestMs = 0;
 
+// ==========================================================================
+//  Fast WiFi reconnect (cached BSSID + channel)
+// ==========================================================================
+// Enterprise APs force periodic roams, and every drop used to pay a full
+// all-channel scan before re-association (3-8 s of offline overlay). The
+// associated AP's BSSID and channel are cached after each successful connect
+// (persisted to NVS so the cache survives reboots) and a directed
+// single-channel connect is tried first on the next drop; the existing 15 s
+// portal fallback path is untouched and a failed directed attempt un-pins
+// the driver config so NetWizard's full-scan retries behave as before.
+
+#define WIFI_PERSIST_NS              "qbit-wifi"
+#define WIFI_FAST_RECONNECT_DELAY_MS 250    // let the drop settle before the directed attempt
+#define WIFI_FAST_RECONNECT_GAP_MS   3000   // spacing between directed attempts
+#define WIFI_FAST_RECONNECT_TRIES    2      // then un-pin and leave it to full scans
+
+static Preferences   _wifiPrefs;
+static uint8_t       _wifiApBssid[6]       = {0};
+static uint8_t       _wifiApChannel        = 0;
+static bool          _wifiApCacheValid     = false;
+static uint8_t       _wifiFastTries        = 0;
+static unsigned long _wifiFastAttemptAfterMs = 0;   // 0 = no directed attempt scheduled
+
+static void wifiFastCacheLoad() {
+    _wifiPrefs.begin(WIFI_PERSIST_NS, false);
+    uint8_t chan = (uint8_t)_wifiPrefs.getUChar("chan", 0);
+    if (chan >= 1 && chan <= 14 &&
+        _wifiPrefs.getBytes("bssid", _wifiApBssid, sizeof(_wifiApBssid)) ==
+            sizeof(_wifiApBssid)) {
+        _wifiApChannel    = chan;
+        _wifiApCacheValid = true;
+        Serial.printf("[WiFi] Fast-reconnect cache: %02X:%02X:%02X:%02X:%02X:%02X ch%u\n",
+                      _wifiApBssid[0], _wifiApBssid[1], _wifiApBssid[2],
+                      _wifiApBssid[3], _wifiApBssid[4], _wifiApBssid[5], chan);
+    }
+}
+
+// Called on every STA-up transition; writes NVS only when the AP changed
+// (steady association with one AP costs zero flash wear).
+static void wifiFastCacheStore() {
+    const uint8_t *bssid = WiFi.BSSID();
+    uint8_t chan = (uint8_t)WiFi.channel();
+    if (!bssid || chan < 1 || chan > 14) return;
+    if (_wifiApCacheValid && chan == _wifiApChannel &&
+        memcmp(bssid, _wifiApBssid, sizeof(_wifiApBssid)) == 0) {
+        return;
+    }
+    memcpy(_wifiApBssid, bssid, sizeof(_wifiApBssid));
+    _wifiApChannel    = chan;
+    _wifiApCacheValid = true;
+    _wifiPrefs.putBytes("bssid", _wifiApBssid, sizeof(_wifiApBssid));
+    _wifiPrefs.putUChar("chan", chan);
+    qlogInfo("WiFi AP cached %02X:%02X:%02X:%02X:%02X:%02X ch%u",
+             _wifiApBssid[0], _wifiApBssid[1], _wifiApBssid[2],
+             _wifiApBssid[3], _wifiApBssid[4], _wifiApBssid[5], chan);
+}
+
+// Pin (or un-pin) the driver's STA config to the cached BSSID/channel.
+// Requires credentials already present in the driver config, which holds
+// after the first NetWizard connect of this boot.
+static bool wifiStaConfigPin(bool pin) {
+    wifi_config_t cfg;
+    if (esp_wifi_get_config(WIFI_IF_STA, &cfg) != ESP_OK) return false;
+    if (cfg.sta.ssid[0] == 0) return false;   // driver has no creds yet
+    if (pin) {
+        memcpy(cfg.sta.bssid, _wifiApBssid, sizeof(_wifiApBssid));
+        cfg.sta.bssid_set   = 1;
+        cfg.sta.channel     = _wifiApChannel;
+        cfg.sta.scan_method = WIFI_FAST_SCAN;
+    } else {
+        memset(cfg.sta.bssid, 0, sizeof(cfg.sta.bssid));
+        cfg.sta.bssid_set = 0;
+        cfg.sta.channel   = 0;
+    }
+    return esp_wifi_set_config(WIFI_IF_STA, &cfg) == ESP_OK;
+}
+
+static void wifiFastReconnectTick() {
+    if (_wifiFastAttemptAfterMs == 0 || millis() < _wifiFastAttemptAfterMs)
+        return;
+    if (_wifiFastTries >= WIFI_FAST_RECONNECT_TRIES) {
+        // Directed attempts exhausted: un-pin so the portal-retry full scans
+        // can roam to any AP (the old BSSID may be gone for good).
+        _wifiFastAttemptAfterMs = 0;
+        wifiStaConfigPin(false);
+        return;
+    }
+    _wifiFastTries++;
+    _wifiFastAttemptAfterMs = millis() + WIFI_FAST_RECONNECT_GAP_MS;
+    if (!wifiStaConfigPin(true) || esp_wifi_connect() != ESP_OK) {
+        // Driver busy or no creds; keep the schedule, the next pass retries.
+        return;
+    }
+    qlogInfo("WiFi directed reconnect to ch%u (try %u)", _wifiApChannel,
+             (unsigned)_wifiFastTries);
+}
+
+// ==========================================================================
+//  WebSocket JSON scratch buffers
+// ==========================================================================
+// The steady-state WS path used to heap-allocate on every message: inbound
+// text was copied into a String before parsing and outbound messages were
+// serialized into a String per send.  This task shares the heap with poke
+// bitmaps and the async web server, so both directions now go through
+// fixed, reused scratch buffers sized for the largest protocol message.
+// Only the network task touches them (receive runs in _wsClient.poll(),
+// the one variable outbound message is sent on socket open); the fixed
+// claim/friend replies from the display task are string literals below
+// and never touch the scratch.
+
+static StaticJsonDocument<2048> _wsRxDoc;  // parse scratch (structure only; strings stay in the frame buffer)
+static StaticJsonDocument<512>  _wsTxDoc;  // serialize scratch
+static char                     _wsTxBuf[512];
+
+// Serialize _wsTxDoc straight into the send buffer and ship it.
+static void wsSendTxDoc() {
+    size_t n = serializeJson(_wsTxDoc, _wsTxBuf, sizeof(_wsTxBuf));
+    _wsClient.send(_wsTxBuf, n);
+}
+
 // ==========================================================================
 //  WebSocket helpers
 // ==========================================================================
 
+// Per-boot random token sent with device.register. The backend buffers pokes
+// for a device that drops its socket and replays them when the same session
+// re-registers within its grace window; a fresh boot gets a new token so
+// stale pokes are never replayed across a restart.
+static const char *wsSessionToken() {
+    if (_wsSession[0] == '\0') {
+        snprintf(_wsSession, sizeof(_wsSession), "%08x%08x",
+                 (unsigned)esp_random(), (unsigned)esp_random());
+    }
+    return _wsSession;
+}
+
+// Double the retry delay (capped) and jitter the next attempt by +/-25%.
+static void wsBackoffGrow() {
+    uint32_t jitter = _wsBackoffMs / 4;
+    _wsRetryAfterMs = _wsBackoffMs - jitter + esp_random() % (2 * jitter + 1);
+    _wsBackoffMs *= 2;
+    if (_wsBackoffMs > WS_RECONNECT_MAX_MS) _wsBackoffMs = WS_RECONNECT_MAX_MS;
+}
+
 static bool wsConnect() {
     if (_wsClient.available()) {
         _wsClient.close();
@@ -166,65 +630,67 @@ static bool wsConnect() {
         ok = _wsClient.connect(WS_HOST, WS_PORT, WS_PATH);
     }
     if (!ok) {
-        Serial.println("[WS] Connection failed");
+        qlogWarn("[WS] Connection failed");
     }
     return ok;
 }
 
+// Runs on the HTTP worker task: on the TLS port connectSecure() is a full
+// mbedTLS handshake -- multiple seconds of key-exchange math on this core --
+// that used to stall the network loop (LAN pokes, dashboard ticks, MQTT
+// keepalive) on every cloud reconnect.  Same ownership rule as the MQTT
+// connect job: the loop skips all _wsClient access while
+// _wsConnectInFlight is set, so the client is never touched from two
+// tasks at once.
+static void wsConnectJob() {
+    if (!wsConnect()) {
+        wsBackoffGrow();   // reset to MIN on ConnectionOpened
+    }
+    _wsConnectInFlight = false;
+}
+
 static void wsSendDeviceInfo() {
     if (!wsIsCloudConnected()) return;
-    StaticJsonDocument<384> doc;
-    doc["type"]    = "device.register";
-    doc["id"]      = getDeviceId();
-    doc["name"]    = getDeviceName();
-    doc["ip"]      = WiFi.localIP().toString();
-    doc["version"] = kQbitVersion;
-    String msg;
-    serializeJson(doc, msg);
-    _wsClient.send(msg);
+    _wsTxDoc.clear();
+    _wsTxDoc["type"]    = "device.register";
+    _wsTxDoc["id"]      = getDeviceId();
+    _wsTxDoc["name"]    = getDeviceName();
+    _wsTxDoc["ip"]      = WiFi.localIP().toString();
+    _wsTxDoc["version"] = kQbitVersion;
+    _wsTxDoc["binProto"] = WS_BINPROTO_VERSION;  // we accept binary poke frames
+    _wsTxDoc["session"] = wsSessionToken();      // resume token for poke replay
+    wsSendTxDoc();
 }
 
 void networkSendDeviceInfo() {
     wsSendDeviceInfo();
 }
 
+// The claim/friend replies below are called from the display task on user
+// gestures; their payloads are fixed, so literals keep them allocation-free
+// without sharing the serialize scratch across tasks.
+
 void networkSendClaimConfirm() {
     if (!wsIsCloudConnected()) return;
-    StaticJsonDocument<64> doc;
-    doc["type"] = "claim_confirm";
-    String msg;
-    serializeJson(doc, msg);
-    _wsClient.send(msg);
+    _wsClient.send("{\"type\":\"claim_confirm\"}");
     Serial.println("Claim confirmed");
 }
 
 void networkSendClaimReject() {
     if (!wsIsCloudConnected()) return;
-    StaticJsonDocument<64> doc;
-    doc["type"] = "claim_reject";
-    String msg;
-    serializeJson(doc, msg);
-    _wsClient.send(msg);
+    _wsClient.send("{\"type\":\"claim_reject\"}");
     Serial.println("Claim rejected (timeout)");
 }
 
 void networkSendFriendConfirm() {
     if (!wsIsCloudConnected()) return;
-    StaticJsonDocument<64> doc;
-    doc["type"] = "friend_confirm";
-    String msg;
-    serializeJson(doc, msg);
-    _wsClient.send(msg);
+    _wsClient.send("{\"type\":\"friend_confirm\"}");
     Serial.println("Friend confirmed");
 }
 
 void networkSendFriendReject() {
     if (!wsIsCloudConnected()) return;
-    StaticJsonDocument<64> doc;
-    doc["type"] = "friend_reject";
-    String msg;
-    serializeJson(doc, msg);
-    _wsClient.send(msg);
+    _wsClient.send("{\"type\":\"friend_reject\"}");
     Serial.println("Friend request rejected (timeout)");
 }
 
@@ -239,20 +705,19 @@ static void wsEvent(WebsocketsClient &client, WebsocketsEvent event, WSInterface
         case WebsocketsEvent::ConnectionOpened:
             wsCloudSet(true, esp_timer_get_time());
             xEventGroupSetBits(connectivityBits, WS_CONNECTED_BIT);
-            Serial.println("[WS] Connected to backend");
+            qlogInfo("[WS] Connected to backend");
+            _wsBackoffMs    = WS_RECONNECT_MIN_MS;   // fast first retry on the next drop
+            _wsRetryAfterMs = WS_RECONNECT_MIN_MS;
             wsSendDeviceInfo();
             mqttPublishServerConnectionState(true);
-            {
-                NetworkEvent evt = {};
-                evt.kind = NetworkEvent::WS_STATUS;
-                evt.connected = true;
-                xQueueSend(networkEventQueue, &evt, 0);
-            }
+            sendStatusEvent(NetworkEvent::WS_STATUS, true);
             break;
         case WebsocketsEvent::ConnectionClosed:
             wsCloudSet(false, 0);
+            _wsPingSentUs = 0;   // no pong is coming; don't time out the next connection
             xEventGroupClearBits(connectivityBits, WS_CONNECTED_BIT);
-            Serial.println("[WS] Disconnected");
+            qlogInfo("[WS] Disconnected");
+            wsBackoffGrow();   // covers accept-then-drop loops, not just refused connects
             mqttPublishServerConnectionState(false);
             // stopPortal() after captive provisioning tears down the link briefly; the socket closes
             // here then reconnects seconds later. Suppress OLED "Server Offline" in the same window
@@ -260,26 +725,119 @@ static void wsEvent(WebsocketsClient &client, WebsocketsEvent event, WSInterface
             {
                 const unsigned long until = _wifiSuppressDisconnectUiUntilMs;
                 if (until == 0 || millis() >= until) {
-                    NetworkEvent evt = {};
-                    evt.kind = NetworkEvent::WS_STATUS;
-                    evt.connected = false;
-                    xQueueSend(networkEventQueue, &evt, 0);
+                    sendStatusEvent(NetworkEvent::WS_STATUS, false);
                 }
             }
             break;
         case WebsocketsEvent::GotPing:
+            break;
         case WebsocketsEvent::GotPong:
+            if (_wsPingSentUs != 0) {
+                int64_t deltaUs = esp_timer_get_time() - _wsPingSentUs;
+                _wsPingSentUs = 0;
+                if (deltaUs >= 0) perfStatsNoteWsRtt((uint32_t)(deltaUs / 1000));
+            }
             break;
     }
 }
 
+// Parse a binary poke/broadcast frame (layout above).  Strings and bitmap
+// bytes are copied straight out of the frame -- no base64 decode, no JSON
+// document, and exactly one allocation per bitmap at its final size.
+static void wsHandleBinary(const uint8_t *data, size_t len) {
+    if (len < WS_BIN_HDR_SIZE) return;
+
+    uint8_t msgType = data[0];
+    if (msgType != WS_BIN_POKE && msgType != WS_BIN_BROADCAST) return;
+
+    uint8_t  senderLen = data[1];
+    uint8_t  textLen   = data[2];
+    uint8_t  titleLen  = data[3];
+    uint16_t senderW   = data[4]  | ((uint16_t)data[5]  << 8);
+    size_t   sLen      = data[6]  | ((uint16_t)data[7]  << 8);
+    uint16_t textW     = data[8]  | ((uint16_t)data[9]  << 8);
+    size_t   tLen      = data[10] | ((uint16_t)data[11] << 8);
+
+    if ((size_t)WS_BIN_HDR_SIZE + senderLen + textLen + titleLen + sLen + tLen != len)
+        return;
+
+    NetworkEvent *evt = networkEventAcquire();
+    if (!evt) return;
+    const uint8_t *p = data + WS_BIN_HDR_SIZE;
+
+    size_t n = (senderLen < sizeof(evt->sender) - 1) ? senderLen : sizeof(evt->sender) - 1;
+    memcpy(evt->sender, p, n);
+    p += senderLen;
+    n = (textLen < sizeof(evt->text) - 1) ? textLen : sizeof(evt->text) - 1;
+    memcpy(evt->text, p, n);
+    p += textLen;
+    n = (titleLen < sizeof(evt->title) - 1) ? titleLen : sizeof(evt->title) - 1;
+    memcpy(evt->title, p, n);
+    p += titleLen;
+
+    if (evt->sender[0] == '\0')
+        strcpy(evt->sender, (msgType == WS_BIN_BROADCAST) ? "QBIT-NETWORK" : "Someone");
+    if (evt->text[0] == '\0' && msgType == WS_BIN_POKE) strcpy(evt->text, "Poke!");
+    if (evt->title[0] == '\0' && msgType == WS_BIN_BROADCAST) strcpy(evt->title, "NOTIFY");
+
+    if (msgType == WS_BIN_POKE)
+        mqttPublishPokeEvent(evt->sender, evt->text);
+
+    bool withBitmaps = sLen > 0 && tLen > 0 &&
+                       isValidBitmapSize(senderW, sLen) &&
+                       isValidBitmapSize(textW, tLen);
+    if (withBitmaps) {
+        uint8_t *sBmp = (uint8_t *)pokeBitmapAlloc(sLen);
+        uint8_t *tBmp = (uint8_t *)pokeBitmapAlloc(tLen);
+        if (sBmp && tBmp) {
+            memcpy(sBmp, p, sLen);
+            memcpy(tBmp, p + sLen, tLen);
+            evt->kind = NetworkEvent::POKE_BITMAP;
+            evt->senderBmp      = sBmp;
+            evt->senderBmpWidth = senderW;
+            evt->senderBmpLen   = sLen;
+            evt->textBmp        = tBmp;
+            evt->textBmpWidth   = textW;
+            evt->textBmpLen     = tLen;
+        } else {
+            if (sBmp) pokeBitmapFree(sBmp);
+            if (tBmp) pokeBitmapFree(tBmp);
+            evt->kind = NetworkEvent::POKE;
+        }
+    } else {
+        evt->kind = NetworkEvent::POKE;
+    }
+
+    if (xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100)) != pdTRUE) {
+        pokeCoalesce(evt->sender, evt->text);
+        networkEventRelease(evt);  // also frees any attached bitmaps
+    }
+}
+
 static void wsMessage(WebsocketsClient &client, WebsocketsMessage message) {
     (void)client;
+    if (message.isBinary()) {
+        const WSString &raw = message.rawData();  // std::string, binary-safe
+        wsHandleBinary((const uint8_t *)raw.data(), raw.size());
+        return;
+    }
     if (!message.isText()) return;
 
-    String data = message.data();
-    StaticJsonDocument<2048> doc;
-    if (deserializeJson(doc, data)) return;
+    // Zero-copy parse: hand ArduinoJson the client's frame buffer as
+    // writable memory so string values -- including the multi-KB base64
+    // bitmap fields -- are unescaped in situ and referenced by pointer
+    // instead of being duplicated into the document pool. The 2 KB scratch
+    // then only holds structure, a maximal 512-wide bitmap poke parses
+    // instead of failing on pool exhaustion, and each bitmap is decoded
+    // once, straight from the arrival buffer into its final exact-size
+    // allocation. (ArduinoWebsockets reassembles fragments internally
+    // before this callback, so the frame buffer itself is the floor on
+    // peak usage; the binary poke protocol above avoids even that by
+    // shipping bitmap bytes raw.)
+    WSString &rawText = const_cast<WSString &>(message.rawData());
+    if (rawText.empty()) return;
+    JsonDocument &doc = _wsRxDoc;
+    if (deserializeJson(doc, &rawText[0], rawText.length())) return;
 
     const char *msgType = doc["type"];
     if (!msgType) return;
@@ -304,43 +862,34 @@ static void wsMessage(WebsocketsClient &client, WebsocketsMessage message) {
                              isValidBitmapSize(senderW, sLen) &&
                              isValidBitmapSize(textW, tLen);
 
-                if (valid) {
-                    NetworkEvent evt = {};
-                    evt.kind = NetworkEvent::POKE_BITMAP;
-                    strncpy(evt.sender, sender, sizeof(evt.sender) - 1);
-                    strncpy(evt.text, text, sizeof(evt.text) - 1);
-                    evt.senderBmp = sBmp;
-                    evt.senderBmpWidth = senderW;
-                    evt.senderBmpLen = sLen;
-                    evt.textBmp = tBmp;
-                    evt.textBmpWidth = textW;
-                    evt.textBmpLen = tLen;
+                NetworkEvent *evt = valid ? networkEventAcquire() : nullptr;
+                if (evt) {
+                    evt->kind = NetworkEvent::POKE_BITMAP;
+                    strncpy(evt->sender, sender, sizeof(evt->sender) - 1);
+                    strncpy(evt->text, text, sizeof(evt->text) - 1);
+                    evt->senderBmp = sBmp;
+                    evt->senderBmpWidth = senderW;
+                    evt->senderBmpLen = sLen;
+                    evt->textBmp = tBmp;
+                    evt->textBmpWidth = textW;
+                    evt->textBmpLen = tLen;
                     if (xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100)) != pdTRUE) {
-                        free(sBmp);
-                        free(tBmp);
+                        pokeCoalesce(evt->sender, evt->text);
+                        networkEventRelease(evt);  // frees the bitmaps too
                     }
                 } else {
-                    if (sBmp) free(sBmp);
-                    if (tBmp) free(tBmp);
-                    NetworkEvent evt = {};
-                    evt.kind = NetworkEvent::POKE;
-                    strncpy(evt.sender, sender, sizeof(evt.sender) - 1);
-                    strncpy(evt.text, text, sizeof(evt.text) - 1);
-                    xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+                    if (sBmp) pokeBitmapFree(sBmp);
+                    if (tBmp) pokeBitmapFree(tBmp);
+                    sendSimpleEvent(NetworkEvent::POKE, sender, text, nullptr,
+                                    pdMS_TO_TICKS(100));
                 }
             } else {
-                NetworkEvent evt = {};
-                evt.kind = NetworkEvent::POKE;
-                strncpy(evt.sender, sender, sizeof(evt.sender) - 1);
-                strncpy(evt.text, text, sizeof(evt.text) - 1);
-                xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+                sendSimpleEvent(NetworkEvent::POKE, sender, text, nullptr,
+                                pdMS_TO_TICKS(100));
             }
         } else {
-            NetworkEvent evt = {};
-            evt.kind = NetworkEvent::POKE;
-            strncpy(evt.sender, sender, sizeof(evt.sender) - 1);
-            strncpy(evt.text, text, sizeof(evt.text) - 1);
-            xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+            sendSimpleEvent(NetworkEvent::POKE, sender, text, nullptr,
+                            pdMS_TO_TICKS(100));
         }
 
         mqttPublishPokeEvent(sender, text);
@@ -367,76 +916,48 @@ static void wsMessage(WebsocketsClient &client, WebsocketsMessage message) {
                              isValidBitmapSize(senderW, sLen) &&
                              isValidBitmapSize(textW, tLen);
 
-                if (valid) {
-                    NetworkEvent evt = {};
-                    evt.kind = NetworkEvent::POKE_BITMAP;
-                    strncpy(evt.sender, sender, sizeof(evt.sender) - 1);
-                    evt.sender[sizeof(evt.sender) - 1] = '\0';
-                    strncpy(evt.text, text, sizeof(evt.text) - 1);
-                    evt.text[sizeof(evt.text) - 1] = '\0';
-                    strncpy(evt.title, title, sizeof(evt.title) - 1);
-                    evt.title[sizeof(evt.title) - 1] = '\0';
-                    evt.senderBmp = sBmp;
-                    evt.senderBmpWidth = senderW;
-                    evt.senderBmpLen = sLen;
-                    evt.textBmp = tBmp;
-                    evt.textBmpWidth = textW;
-                    evt.textBmpLen = tLen;
+                NetworkEvent *evt = valid ? networkEventAcquire() : nullptr;
+                if (evt) {
+                    evt->kind = NetworkEvent::POKE_BITMAP;
+                    strncpy(evt->sender, sender, sizeof(evt->sender) - 1);
+                    strncpy(evt->text, text, sizeof(evt->text) - 1);
+                    strncpy(evt->title, title, sizeof(evt->title) - 1);
+                    evt->senderBmp = sBmp;
+                    evt->senderBmpWidth = senderW;
+                    evt->senderBmpLen = sLen;
+                    evt->textBmp = tBmp;
+                    evt->textBmpWidth = textW;
+                    evt->textBmpLen = tLen;
                     if (xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100)) != pdTRUE) {
-                        free(sBmp);
-                        free(tBmp);
+                        pokeCoalesce(evt->sender, evt->text);
+                        networkEventRelease(evt);  // frees the bitmaps too
                     }
                 } else {
-                    if (sBmp) free(sBmp);
-                    if (tBmp) free(tBmp);
-                    NetworkEvent evt = {};
-                    evt.kind = NetworkEvent::POKE;
-                    strncpy(evt.sender, sender, sizeof(evt.sender) - 1);
-                    evt.sender[sizeof(evt.sender) - 1] = '\0';
-                    strncpy(evt.text, text, sizeof(evt.text) - 1);
-                    evt.text[sizeof(evt.text) - 1] = '\0';
-                    strncpy(evt.title, title, sizeof(evt.title) - 1);
-                    evt.title[sizeof(evt.title) - 1] = '\0';
-                    xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+                    if (sBmp) pokeBitmapFree(sBmp);
+                    if (tBmp) pokeBitmapFree(tBmp);
+                    sendSimpleEvent(NetworkEvent::POKE, sender, text, title,
+                                    pdMS_TO_TICKS(100));
                 }
             } else {
-                NetworkEvent evt = {};
-                evt.kind = NetworkEvent::POKE;
-                strncpy(evt.sender, sender, sizeof(evt.sender) - 1);
-                evt.sender[sizeof(evt.sender) - 1] = '\0';
-                strncpy(evt.text, text, sizeof(evt.text) - 1);
-                evt.text[sizeof(evt.text) - 1] = '\0';
-                strncpy(evt.title, title, sizeof(evt.title) - 1);
-                evt.title[sizeof(evt.title) - 1] = '\0';
-                xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+                sendSimpleEvent(NetworkEvent::POKE, sender, text, title,
+                                pdMS_TO_TICKS(100));
             }
         } else {
-            NetworkEvent evt = {};
-            evt.kind = NetworkEvent::POKE;
-            strncpy(evt.sender, sender, sizeof(evt.sender) - 1);
-            evt.sender[sizeof(evt.sender) - 1] = '\0';
-            strncpy(evt.text, text, sizeof(evt.text) - 1);
-            evt.text[sizeof(evt.text) - 1] = '\0';
-            strncpy(evt.title, title, sizeof(evt.title) - 1);
-            evt.title[sizeof(evt.title) - 1] = '\0';
-            xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+            sendSimpleEvent(NetworkEvent::POKE, sender, text, title,
+                            pdMS_TO_TICKS(100));
         }
     }
 
     if (strcmp(msgType, "claim_request") == 0) {
         const char *userName = doc["userName"] | "Unknown";
-        NetworkEvent evt = {};
-        evt.kind = NetworkEvent::CLAIM_REQUEST;
-        strncpy(evt.sender, userName, sizeof(evt.sender) - 1);
-        xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+        sendSimpleEvent(NetworkEvent::CLAIM_REQUEST, userName, nullptr, nullptr,
+                        pdMS_TO_TICKS(100));
     }
 
     if (strcmp(msgType, "friend_request") == 0) {
         const char *userName = doc["userName"] | "Unknown";
-        NetworkEvent evt = {};
-        evt.kind = NetworkEvent::FRIEND_REQUEST;
-        strncpy(evt.sender, userName, sizeof(evt.sender) - 1);
-        xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+        sendSimpleEvent(NetworkEvent::FRIEND_REQUEST, userName, nullptr, nullptr,
+                        pdMS_TO_TICKS(100));
     }
 }
 
@@ -444,9 +965,14 @@ static void wsMessage(WebsocketsClient &client, WebsocketsMessage message) {
 //  Firmware version check (HTTPS GET latest.json), deferred ~15s after WiFi
 // ==========================================================================
 #define VERSION_CHECK_URL "https://seanchangx.github.io/QBIT/latest.json"
+#define OTA_BIN_URL_DEFAULT "https://seanchangx.github.io/QBIT/firmware.bin"
 #define VERSION_CHECK_TIMEOUT_MS 45000  // HTTPClient uses ms (compare with millis())
 #define VERSION_RECHECK_INTERVAL_MS (6UL * 60UL * 60UL * 1000UL)  // periodic check while WiFi up
 
+// How often the network task polls weatherScreenPrefetchIfDue() (cheap freshness check;
+// the weather module decides when a real fetch is due).
+#define WEATHER_PREFETCH_POLL_MS (60UL * 1000UL)
+
 static void checkFirmwareVersion() {
     Serial.println("[Version] Checking...");
     WiFiClientSecure client;
@@ -491,6 +1017,11 @@ static void checkFirmwareVersion() {
     }
 }
 
+// HttpJobFn-shaped wrapper (weatherScreenPrefetchIfDue returns bool).
+static void weatherPrefetchJob() {
+    weatherScreenPrefetchIfDue();
+}
+
 // ==========================================================================
 //  MQTT helpers
 // ==========================================================================
@@ -527,20 +1058,28 @@ static void mqttCallback(char *topic, byte *payload, unsigned int length) {
         if (strcmp(cmd, "poke") == 0) {
             const char *sender = doc["sender"] | "Home Assistant";
             const char *text   = doc["text"]   | "Poke!";
-            NetworkEvent evt = {};
-            evt.kind = NetworkEvent::POKE;
-            sanitizePokeText(evt.sender, sizeof(evt.sender), sender, POKE_MQTT_TEXT_MAX);
-            if (evt.sender[0] == '\0') strcpy(evt.sender, "Home Assistant");
+            char senderBuf[33] = "";
+            char textBuf[65]   = "";
+            sanitizePokeText(senderBuf, sizeof(senderBuf), sender, POKE_MQTT_TEXT_MAX);
+            if (senderBuf[0] == '\0') strcpy(senderBuf, "Home Assistant");
             if (_haStoredPokeText[0] != '\0') {
-                strncpy(evt.text, _haStoredPokeText, sizeof(evt.text) - 1);
-                evt.text[sizeof(evt.text) - 1] = '\0';
+                strncpy(textBuf, _haStoredPokeText, sizeof(textBuf) - 1);
+                textBuf[sizeof(textBuf) - 1] = '\0';
             } else {
-                sanitizePokeText(evt.text, sizeof(evt.text), text, POKE_MQTT_TEXT_MAX);
-                if (evt.text[0] == '\0') strcpy(evt.text, "Poke!");
+                sanitizePokeText(textBuf, sizeof(textBuf), text, POKE_MQTT_TEXT_MAX);
+                if (textBuf[0] == '\0') strcpy(textBuf, "Poke!");
             }
-            xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
-            mqttPublishPokeEvent(evt.sender, evt.text);
-            Serial.printf("[MQTT] Poke from %s: %s\n", evt.sender, evt.text);
+            sendSimpleEvent(NetworkEvent::POKE, senderBuf, textBuf, nullptr,
+                            pdMS_TO_TICKS(100));
+            mqttPublishPokeEvent(senderBuf, textBuf);
+            Serial.printf("[MQTT] Poke from %s: %s\n", senderBuf, textBuf);
+        }
+        // Fleet OTA: {"command":"ota_update"[,"url":...,"md5":...,"reboot":false]}
+        if (strcmp(cmd, "ota_update") == 0) {
+            const char *url = doc["url"] | OTA_BIN_URL_DEFAULT;
+            const char *md5 = doc["md5"] | "";
+            bool reboot     = doc["reboot"] | true;
+            otaUpdaterStart(url, md5, reboot);
         }
         return;
     }
@@ -564,20 +1103,15 @@ static void mqttCallback(char *topic, byte *payload, unsigned int length) {
 
     // Mute set (plain text: ON/OFF)
     if (topicStr == prefix + "/" + id + "/mute/set") {
-        NetworkEvent evt = {};
-        evt.kind = NetworkEvent::MQTT_COMMAND;
-        strncpy(evt.sender, "mute", sizeof(evt.sender) - 1);
-        strncpy(evt.text, rawPayload.c_str(), sizeof(evt.text) - 1);
-        xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+        sendSimpleEvent(NetworkEvent::MQTT_COMMAND, "mute", rawPayload.c_str(),
+                        nullptr, pdMS_TO_TICKS(100));
         return;
     }
 
     // Animation next (no payload needed)
     if (topicStr == prefix + "/" + id + "/animation/next") {
-        NetworkEvent evt = {};
-        evt.kind = NetworkEvent::MQTT_COMMAND;
-        strncpy(evt.sender, "animation_next", sizeof(evt.sender) - 1);
-        xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(100));
+        sendSimpleEvent(NetworkEvent::MQTT_COMMAND, "animation_next", nullptr,
+                        nullptr, pdMS_TO_TICKS(100));
         return;
     }
 }
@@ -634,6 +1168,7 @@ static void mqttReconnect() {
     if (ok) {
         Serial.printf("[MQTT] Connected to %s:%u\n", _mqttHostStable, mqttPort);
         xEventGroupSetBits(connectivityBits, MQTT_CONNECTED_BIT);
+        _mqttUp = true;
 
         // Publish online + info
         _mqttClient.publish(statusTopic.c_str(), "online", true);
@@ -661,6 +1196,16 @@ static void mqttReconnect() {
     }
 }
 
+// Runs on the HTTP worker task: the broker connect is a blocking socket
+// handshake (DNS + TCP + CONNACK) that used to stall the network loop for
+// seconds against an unreachable or wedged broker. The loop skips all
+// _mqttClient access while _mqttConnectInFlight is set, so the client is
+// never touched from two tasks at once.
+static void mqttConnectJob() {
+    mqttReconnect();
+    _mqttConnectInFlight = false;
+}
+
 // ==========================================================================
 //  Network task main loop
 // ==========================================================================
@@ -668,6 +1213,39 @@ static void mqttReconnect() {
 void networkTask(void *param) {
     (void)param;
 
+    // Dashboard bring-up runs here instead of setup(): route registration +
+    // LittleFS touch-points are off the boot-to-interactive path, and
+    // AsyncWebServer accepts routes added after begin() so the NetWizard
+    // portal (started in setup) is unaffected.
+    {
+        uint32_t t0 = millis();
+        webDashboardInit(server);
+        // Wire cam WebSocket connect/disconnect → display task state machine
+        webCamSetCallbacks(
+            []() {
+                NetworkEvent *evt = networkEventAcquire();
+                if (!evt) return;
+                evt->kind = NetworkEvent::CAM_START;
+                if (xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(10)) != pdPASS) {
+                    networkEventRelease(evt);
+                    qlogWarn("failed to enqueue CAM_START");
+                }
+            },
+            []() {
+                NetworkEvent *evt = networkEventAcquire();
+                if (!evt) return;
+                evt->kind = NetworkEvent::CAM_STOP;
+                if (xQueueSend(networkEventQueue, &evt, pdMS_TO_TICKS(10)) != pdPASS) {
+                    networkEventRelease(evt);
+                    qlogWarn("failed to enqueue CAM_STOP");
+                }
+            }
+        );
+        server.begin();
+        perfStatsNoteBootStage("dashboard", millis() - t0);
+        Serial.println("Web server started");
+    }
+
     // Wait a bit for WiFi to initialize
     vTaskDelay(pdMS_TO_TICKS(500));
 
@@ -676,10 +1254,15 @@ void networkTask(void *param) {
         _wsClient.addHeader("Authorization", "Bearer " + String(WS_API_KEY));
     }
     _wsClient.onEvent(wsEvent);
-    _wsClient.onMessage(wsMessage);
+    _wsClient.onMessage([](WebsocketsClient &c, WebsocketsMessage m) {
+        int64_t t0 = qtraceNow();
+        wsMessage(c, m);
+        qtraceSpan("ws.msg", t0);
+    });
 
     // Initial NTP sync
     timeManagerInit();
+    wifiFastCacheLoad();
 
     for (;;) {
         // --- NetWizard loop ---
@@ -746,13 +1329,16 @@ void networkTask(void *param) {
                 xEventGroupClearBits(connectivityBits, WIFI_CONNECTED_BIT | WS_CONNECTED_BIT);
                 if (wasStaUp) {
                     Serial.println("[WiFi] Connection lost");
+                    // Schedule a directed reconnect to the cached BSSID/channel
+                    // before the full-scan fallback machinery gets involved.
+                    if (_wifiApCacheValid) {
+                        _wifiFastTries         = 0;
+                        _wifiFastAttemptAfterMs = millis() + WIFI_FAST_RECONNECT_DELAY_MS;
+                    }
                     const bool suppressUi = (_wifiSuppressDisconnectUiUntilMs != 0 &&
                                              millis() < _wifiSuppressDisconnectUiUntilMs);
                     if (!suppressUi) {
-                        NetworkEvent evt = {};
-                        evt.kind = NetworkEvent::WIFI_STATUS;
-                        evt.connected = false;
-                        xQueueSend(networkEventQueue, &evt, 0);
+                        sendStatusEvent(NetworkEvent::WIFI_STATUS, false);
                     } else {
                         _wifiDisconnectUiPending = true;
                     }
@@ -762,11 +1348,10 @@ void networkTask(void *param) {
                         millis() >= _wifiSuppressDisconnectUiUntilMs)) {
                 _wifiDisconnectUiPending = false;
                 _wifiSuppressDisconnectUiUntilMs = 0;
-                NetworkEvent evt = {};
-                evt.kind = NetworkEvent::WIFI_STATUS;
-                evt.connected = false;
-                xQueueSend(networkEventQueue, &evt, 0);
+                sendStatusEvent(NetworkEvent::WIFI_STATUS, false);
             }
+            // Directed fast-reconnect attempts (no-op unless scheduled above)
+            wifiFastReconnectTick();
             // Open AP + background retries when STA is unavailable, but not during first-time
             // captive setup (no saved creds yet): there "not connected" is normal until the
             // user submits SSID; isConfigured()==false avoids the old bug where stopPortal ran
@@ -800,6 +1385,18 @@ void networkTask(void *param) {
             // STA up: latch first-connect + clear loss timer (must not gate portal/stopPortal below).
             if (_wifiLostMs > 0 || !_wifiConnected) {
                 if (!_wifiConnected) {
+                    // Outage length for the stats surface (first boot connect
+                    // is not a reconnect and is not counted).
+                    if (_hadStaConnection && _wifiLostMs > 0) {
+                        perfStatsNoteWifiReconnect(millis() - _wifiLostMs,
+                                                   _wifiFastTries > 0);
+                    }
+                    // Refresh the fast-reconnect cache, then un-pin the driver
+                    // config so AP-initiated roams are not fought next time.
+                    wifiFastCacheStore();
+                    if (_wifiFastTries > 0) wifiStaConfigPin(false);
+                    _wifiFastTries          = 0;
+                    _wifiFastAttemptAfterMs = 0;
                     _wifiConnected = true;
                     _hadStaConnection = true;
                     wifiRestoreStaTxPower();
@@ -807,15 +1404,31 @@ void networkTask(void *param) {
                     _wifiDisconnectUiPending         = false;
                     _wifiSuppressDisconnectUiUntilMs = 0;
 
-                    NetworkEvent evt = {};
-                    evt.kind = NetworkEvent::WIFI_STATUS;
-                    evt.connected = true;
-                    xQueueSend(networkEventQueue, &evt, 0);
+                    sendStatusEvent(NetworkEvent::WIFI_STATUS, true);
+
+                    // Deferred mDNS: started on first STA connect instead of
+                    // setup() -- the responder is useless before there is an
+                    // IP, and its begin() cost sat on the boot path.
+                    static bool s_mdnsStarted = false;
+                    if (!s_mdnsStarted && MDNS.begin("qbit")) {
+                        MDNS.addService("http", "tcp", 80);
+                        // LAN poke fast path: advertise the UDP listener so
+                        // peers and tools can discover us by name/id.
+                        MDNS.addService("qbitpoke", "udp", QBIT_POKE_UDP_PORT);
+                        MDNS.addServiceTxt("qbitpoke", "udp", "name",
+                                           getDeviceName().c_str());
+                        MDNS.addServiceTxt("qbitpoke", "udp", "id",
+                                           getDeviceId().c_str());
+                        s_mdnsStarted = true;
+                    }
+                    lanPokeStart();
 
                     // Defer IP-based timezone/weather bootstrap (same HTTP as time_manager)
                     if (getTimezoneIANA().length() == 0 || !getWeatherManual())
                         _tzCheckAfterMs = millis() + 5000;
                     _versionCheckAfterMs = millis() + 15000;
+                    // First prefetch after tz detect + version check have settled
+                    _weatherPrefetchAfterMs = millis() + 30000;
                 }
                 _wifiLostMs = 0;
             }
@@ -862,40 +1475,103 @@ void networkTask(void *param) {
         }
 
         // --- WebSocket ---
-        if (wsIsCloudConnected()) {
+        if (_wsConnectInFlight) {
+            // The HTTP worker owns _wsClient until the connect job clears
+            // the flag; keep this loop off the client meanwhile.
+        } else if (wsIsCloudConnected()) {
             _wsClient.poll();
+            if (_wsPingSentUs != 0 &&
+                esp_timer_get_time() - _wsPingSentUs >=
+                    (int64_t)WS_PONG_TIMEOUT_MS * 1000) {
+                // Half-dead link (NAT entry dropped, AP rebooted): the TCP
+                // stack would take minutes to notice.  Close now; backoff
+                // was reset to MIN at open, so the retry follows in ~1 s.
+                qlogWarn("[WS] Pong timeout, reconnecting");
+                _wsPingSentUs = 0;
+                _wsClient.close();
+            } else if (millis() - _wsLastPingMs >= WS_PING_INTERVAL_MS) {
+                _wsLastPingMs = millis();
+                _wsPingSentUs = esp_timer_get_time();
+                _wsClient.ping();
+            }
         } else if (_wifiConnected) {
             unsigned long now = millis();
-            if (now - _wsLastReconnect >= WS_RECONNECT_MS) {
+            if (now - _wsLastReconnect >= _wsRetryAfterMs) {
                 _wsLastReconnect = now;
-                wsConnect();
+                _wsConnectInFlight = true;
+                if (!httpWorkerEnqueue(wsConnectJob))
+                    _wsConnectInFlight = false;   // queue full; retry next pass
             }
         }
 
         // --- MQTT ---
         // Only manage MQTT when WiFi is connected; otherwise skip to avoid connection errors.
         if (getMqttEnabled() && _wifiConnected && WiFi.status() == WL_CONNECTED) {
-            if (!_mqttClient.connected()) {
+            if (_mqttConnectInFlight) {
+                // The HTTP worker owns _mqttClient until the connect job clears
+                // the flag; keep this loop off the client meanwhile.
+            } else if (!_mqttClient.connected()) {
+                _mqttUp = false;
+                mqttPubFlush();
                 xEventGroupClearBits(connectivityBits, MQTT_CONNECTED_BIT);
-                mqttReconnect();
+                if (millis() - _mqttLastReconnect >= MQTT_RECONNECT_MS) {
+                    _mqttConnectInFlight = true;
+                    if (!httpWorkerEnqueue(mqttConnectJob))
+                        _mqttConnectInFlight = false;   // queue full; retry next pass
+                }
+            } else {
+                _mqttClient.loop();
+                mqttPubDrain();
+                if (millis() - _perfStatsLastPublishMs >= PERF_STATS_PUBLISH_MS) {
+                    _perfStatsLastPublishMs = millis();
+                    mqttPublishPerfStats();
+                    mqttPublishHeapStats();
+                }
             }
-            _mqttClient.loop();
+        } else if (_mqttUp) {
+            _mqttUp = false;   // WiFi dropped or MQTT disabled; stop helpers enqueueing
         }
 
         // --- Deferred timezone detection (~5s after WiFi connect) ---
+        // The blocking fetches below run on the HTTP worker task so a slow
+        // origin (ip-api has been seen sitting on its 5s timeout) never
+        // stalls the WS poll / MQTT keepalive cadence of this loop.
         if (_tzCheckAfterMs > 0 && millis() >= _tzCheckAfterMs) {
             _tzCheckAfterMs = 0;
             if (getTimezoneIANA().length() == 0 || !getWeatherManual())
-                timeManagerDetectTimezone();
+                httpWorkerEnqueue(timeManagerDetectTimezone);
         }
         // --- Deferred version check (~15s after WiFi connect, then every 6h while STA up) ---
         if (_versionCheckAfterMs > 0 && millis() >= _versionCheckAfterMs) {
-            checkFirmwareVersion();
+            httpWorkerEnqueue(checkFirmwareVersion);
             if (_wifiConnected && WiFi.status() == WL_CONNECTED)
                 _versionCheckAfterMs = millis() + VERSION_RECHECK_INTERVAL_MS;
             else
                 _versionCheckAfterMs = 0;
         }
+        // --- Background weather prefetch (~30s after WiFi connect, then polled every minute;
+        //     actual fetch runs ~5 min before cache expiry so WEATHER_SCREEN entry stays warm) ---
+        if (_weatherPrefetchAfterMs > 0 && millis() >= _weatherPrefetchAfterMs) {
+            httpWorkerEnqueue(weatherPrefetchJob);
+            _weatherPrefetchAfterMs = millis() + WEATHER_PREFETCH_POLL_MS;
+        }
+        // --- Deferred settings flush (one packed-blob commit after writes go quiet) ---
+        settingsFlushTick();
+        // --- WiFi power governor (drops the upload boost once traffic stops) ---
+        powerGovernorTick();
+        // --- Warm-boot clock persistence (slow-cadence epoch writes) ---
+        timeManagerPersistTick();
+        // --- Background OTA download (one throttled chunk per pass) ---
+        otaUpdaterTick();
+        // --- Retry delivery of coalesced poke bursts (see pokeCoalesce) ---
+        lanPokeTick();
+        pokeCoalesceTick();
+        // --- Dashboard state push (playback/storage deltas to /ws_state) ---
+        webStateTick();
+        // --- Screen mirror push (panel XOR deltas to /ws_screen) ---
+        webScreenTick();
+        // --- Drain buffered log lines to the UART (bounded by TX FIFO room) ---
+        qlogDrainTick();
 
         vTaskDelay(pdMS_TO_TICKS(10));
     }
@@ -934,6 +1610,9 @@ unsigned long networkGetCloudWsUptimeSeconds() {
 }
 
 void networkWifiReset() {
+    // The restart below is a software reset; drop the session snapshot so
+    // the next boot shows the provisioning QR instead of resuming playback.
+    sessionSnapshotClear();
     NW.reset();
 #if defined(ESP32)
     vTaskDelay(pdMS_TO_TICKS(800));
@@ -949,7 +1628,7 @@ void networkWifiReset() {
 // ==========================================================================
 
 void mqttPublishPokeEvent(const char *sender, const char *text) {
-    if (!getMqttEnabled() || !_mqttClient.connected()) return;
+    if (!getMqttEnabled() || !_mqttUp) return;
     String topic = getMqttPrefix() + "/" + getDeviceId() + "/poke";
     StaticJsonDocument<384> doc;
     doc["sender"] = sender;
@@ -957,17 +1636,17 @@ void mqttPublishPokeEvent(const char *sender, const char *text) {
     doc["time"]   = timeManagerGetISO8601();
     String payload;
     serializeJson(doc, payload);
-    _mqttClient.publish(topic.c_str(), payload.c_str(), true);
+    mqttQueuePublish(topic.c_str(), payload.c_str(), true);
 }
 
 void mqttPublishMuteState(bool muted) {
-    if (!getMqttEnabled() || !_mqttClient.connected()) return;
+    if (!getMqttEnabled() || !_mqttUp) return;
     String topic = getMqttPrefix() + "/" + getDeviceId() + "/mute/state";
-    _mqttClient.publish(topic.c_str(), muted ? "ON" : "OFF", true);
+    mqttQueuePublish(topic.c_str(), muted ? "ON" : "OFF", true);
 }
 
 void mqttPublishTouchEvent(GestureType type) {
-    if (!getMqttEnabled() || !_mqttClient.connected()) return;
+    if (!getMqttEnabled() || !_mqttUp) return;
     String topic = getMqttPrefix() + "/" + getDeviceId() + "/touch";
     const char *typeStr = "none";
     switch (type) {
@@ -983,19 +1662,39 @@ void mqttPublishTouchEvent(GestureType type) {
     doc["time"] = timeManagerGetISO8601();
     String payload;
     serializeJson(doc, payload);
-    _mqttClient.publish(topic.c_str(), payload.c_str(), false);
+    mqttQueuePublish(topic.c_str(), payload.c_str(), false);
 }
 
 void mqttPublishAnimationState(const String &filename) {
-    if (!getMqttEnabled() || !_mqttClient.connected()) return;
+    if (!getMqttEnabled() || !_mqttUp) return;
     String topic = getMqttPrefix() + "/" + getDeviceId() + "/animation/state";
-    _mqttClient.publish(topic.c_str(), filename.c_str(), true);
+    mqttQueuePublish(topic.c_str(), filename.c_str(), true);
 }
 
 void mqttPublishServerConnectionState(bool connected) {
-    if (!getMqttEnabled() || !_mqttClient.connected()) return;
+    if (!getMqttEnabled() || !_mqttUp) return;
     String topic = getMqttPrefix() + "/" + getDeviceId() + "/server/status";
-    _mqttClient.publish(topic.c_str(), connected ? "online" : "offline", true);
+    mqttQueuePublish(topic.c_str(), connected ? "online" : "offline", true);
+}
+
+void mqttPublishPerfStats() {
+    if (!getMqttEnabled() || !_mqttUp) return;
+    String topic = getMqttPrefix() + "/" + getDeviceId() + "/stats";
+    StaticJsonDocument<768> doc;
+    perfStatsFillJson(doc);
+    String payload;
+    serializeJson(doc, payload);
+    mqttQueuePublish(topic.c_str(), payload.c_str(), false);
+}
+
+void mqttPublishHeapStats() {
+    if (!getMqttEnabled() || !_mqttUp) return;
+    String topic = getMqttPrefix() + "/" + getDeviceId() + "/heap";
+    StaticJsonDocument<512> doc;
+    qheapFillJson(doc);
+    String payload;
+    serializeJson(doc, payload);
+    mqttQueuePublish(topic.c_str(), payload.c_str(), false);
 }
 
 // Apply AP RF settings for ESP32-C3 PCB antenna boards (fixes #2): lower TX power and HT20.
@@ -19,6 +19,12 @@ void networkSendClaimReject();
 void networkSendFriendConfirm();
 void networkSendFriendReject();
 
+// Coalesced poke burst access (display task, on POKE_SUMMARY): number of
+// retained {sender, text} pairs, and oldest-first pop into caller buffers
+// (sender >= 33 bytes, text >= 65 bytes; sized like NetworkEvent's fields).
+uint8_t networkCoalescedPokeCount();
+bool    networkCoalescedPokePop(char *sender, char *text);
+
 // Time when WiFi was declared lost (0 if connected or not yet lost). Used for AP countdown.
 unsigned long networkGetWifiLostMs();
 
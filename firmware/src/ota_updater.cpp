@@ -0,0 +1,299 @@
+// ==========================================================================
+//  QBIT -- Background chunked OTA updater
+// ==========================================================================
+#include "ota_updater.h"
+#include <WiFi.h>
+#include <WiFiClientSecure.h>
+#include <HTTPClient.h>
+#include <Preferences.h>
+#include <MD5Builder.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+
+// One chunk per tick keeps the network loop responsive; 8 KB every 200 ms
+// is ~40 KB/s -- a full 1.4 MB image in under a minute without the display
+// task ever noticing.
+#define OTA_CHUNK_SIZE        8192
+#define OTA_CHUNK_INTERVAL_MS 200
+#define OTA_ERASE_AHEAD       0x10000   // erase 64 KB blocks just ahead of the writes
+#define OTA_PERSIST_EVERY     0x10000   // NVS offset checkpoint cadence (wear)
+#define OTA_URL_MAX           160
+#define OTA_MD5_MAX           33
+#define OTA_PREFS_NS          "qbit-ota"
+
+enum OtaPhase { OTA_IDLE, OTA_CONNECT, OTA_DOWNLOAD, OTA_READY, OTA_FAILED };
+
+static OtaPhase _phase = OTA_IDLE;
+static char     _url[OTA_URL_MAX]  = "";
+static char     _md5[OTA_MD5_MAX]  = "";
+static bool     _rebootWhenDone    = false;
+static uint32_t _offset            = 0;   // bytes staged so far
+static uint32_t _total             = 0;   // image size (0 until known)
+static uint32_t _erasedUntil       = 0;
+static uint32_t _lastCheckpoint    = 0;
+static unsigned long _nextChunkMs  = 0;
+static bool     _resumeChecked     = false;
+
+static const esp_partition_t *_target = nullptr;
+static WiFiClientSecure _otaTls;
+static HTTPClient       _otaHttp;
+static Preferences      _otaPrefs;
+static bool             _otaPrefsOpen = false;
+static uint8_t          _chunkBuf[OTA_CHUNK_SIZE];
+
+static void otaPrefsEnsure() {
+    if (!_otaPrefsOpen) {
+        _otaPrefs.begin(OTA_PREFS_NS, false);
+        _otaPrefsOpen = true;
+    }
+}
+
+static void otaPersistState() {
+    _otaPrefs.putString("url", _url);
+    _otaPrefs.putString("md5", _md5);
+    _otaPrefs.putUInt("off", _offset);
+    _otaPrefs.putUInt("total", _total);
+    _otaPrefs.putUChar("reboot", _rebootWhenDone ? 1 : 0);
+}
+
+static void otaClearState() {
+    _otaPrefs.clear();
+}
+
+static void otaFail(const char *why) {
+    Serial.printf("[OTA] Failed: %s (at %u/%u)\n", why,
+                  (unsigned)_offset, (unsigned)_total);
+    _otaHttp.end();
+    _phase = OTA_FAILED;
+    // Keep the NVS checkpoint: a later start with the same URL resumes.
+}
+
+// Open (or reopen) the HTTP stream at the current offset.
+static bool otaOpenStream() {
+    _otaHttp.end();
+    bool ok;
+    if (strncmp(_url, "https:", 6) == 0) {
+        _otaTls.setInsecure();
+        ok = _otaHttp.begin(_otaTls, _url);
+    } else {
+        ok = _otaHttp.begin(_url);
+    }
+    if (!ok) return false;
+    _otaHttp.setTimeout(10000);
+    if (_offset > 0) {
+        char range[40];
+        snprintf(range, sizeof(range), "bytes=%u-", (unsigned)_offset);
+        _otaHttp.addHeader("Range", range);
+    }
+    int code = _otaHttp.GET();
+    if (code == 200 && _offset > 0) {
+        // Server ignored the Range header -- start over.
+        Serial.println("[OTA] Server does not resume, restarting download");
+        _offset = 0;
+        _erasedUntil = 0;
+    } else if (code != 200 && code != 206) {
+        Serial.printf("[OTA] GET failed: %d\n", code);
+        _otaHttp.end();
+        return false;
+    }
+    uint32_t remaining = (uint32_t)_otaHttp.getSize();
+    uint32_t total = _offset + remaining;
+    if (_total != 0 && total != _total) {
+        // Image changed on the server mid-download -- restart clean.  The
+        // open stream is still positioned at the old offset of the new
+        // image, so it cannot be reused: drop it and reopen from byte 0
+        // (with _total cleared this branch cannot trigger again).
+        Serial.println("[OTA] Size changed upstream, restarting download");
+        _otaHttp.end();
+        _offset      = 0;
+        _erasedUntil = 0;
+        _total       = 0;
+        return otaOpenStream();
+    }
+    _total = total;
+    if (_total == 0 || _total > _target->size) {
+        Serial.printf("[OTA] Bad image size %u (slot %u)\n",
+                      (unsigned)_total, (unsigned)_target->size);
+        _otaHttp.end();
+        return false;
+    }
+    return true;
+}
+
+// Read back the staged image and compare its MD5 to latest.json's.
+static bool otaVerifyMd5() {
+    if (_md5[0] == '\0') return true;
+    MD5Builder md5;
+    md5.begin();
+    for (uint32_t off = 0; off < _total; off += sizeof(_chunkBuf)) {
+        uint32_t n = _total - off;
+        if (n > sizeof(_chunkBuf)) n = sizeof(_chunkBuf);
+        if (esp_partition_read(_target, off, _chunkBuf, n) != ESP_OK)
+            return false;
+        md5.add(_chunkBuf, n);
+    }
+    md5.calculate();
+    String got = md5.toString();
+    if (!got.equalsIgnoreCase(_md5)) {
+        Serial.printf("[OTA] MD5 mismatch: got %s want %s\n", got.c_str(), _md5);
+        return false;
+    }
+    return true;
+}
+
+static void otaComplete() {
+    _otaHttp.end();
+    if (!otaVerifyMd5()) {
+        otaClearState();
+        _offset = 0;
+        _phase = OTA_FAILED;
+        return;
+    }
+    esp_err_t err = esp_ota_set_boot_partition(_target);
+    if (err != ESP_OK) {
+        // set_boot_partition validates the image header, so a truncated or
+        // corrupt download is rejected here instead of bricking the boot.
+        Serial.printf("[OTA] set_boot_partition failed: %d\n", (int)err);
+        otaClearState();
+        _offset = 0;
+        _phase = OTA_FAILED;
+        return;
+    }
+    otaClearState();
+    _phase = OTA_READY;
+    Serial.printf("[OTA] Image staged in %s and set for next boot\n", _target->label);
+    if (_rebootWhenDone) {
+        Serial.println("[OTA] Rebooting into new firmware");
+        delay(250);  // let the log line drain
+        ESP.restart();
+    }
+}
+
+bool otaUpdaterStart(const char *url, const char *md5, bool rebootWhenDone) {
+    if (_phase == OTA_CONNECT || _phase == OTA_DOWNLOAD) {
+        Serial.println("[OTA] Download already in progress");
+        return false;
+    }
+    if (!url || url[0] == '\0') return false;
+
+    _target = esp_ota_get_next_update_partition(nullptr);
+    if (!_target) {
+        Serial.println("[OTA] No inactive app slot (old partition table?)");
+        return false;
+    }
+
+    otaPrefsEnsure();
+
+    // Same URL as the persisted checkpoint: resume; otherwise start clean.
+    String savedUrl = _otaPrefs.getString("url", "");
+    if (savedUrl == url && _otaPrefs.getUInt("total", 0) > 0) {
+        _offset = _otaPrefs.getUInt("off", 0);
+        _total  = _otaPrefs.getUInt("total", 0);
+        Serial.printf("[OTA] Resuming at %u/%u\n", (unsigned)_offset, (unsigned)_total);
+    } else {
+        _offset = 0;
+        _total  = 0;
+    }
+    // Round the erase watermark UP: the previous run erased ahead of its
+    // writes, so the whole block containing _offset is already erased and
+    // still 0xFF past _offset.  Rounding down would re-erase that block,
+    // wiping staged bytes below _offset that the Range request (which asks
+    // for bytes=_offset-) never re-downloads.
+    _erasedUntil = (_offset + OTA_ERASE_AHEAD - 1) & ~(uint32_t)(OTA_ERASE_AHEAD - 1);
+    if (_erasedUntil > _target->size) _erasedUntil = _target->size;
+    _lastCheckpoint = _offset;
+    strlcpy(_url, url, sizeof(_url));
+    strlcpy(_md5, md5 ? md5 : "", sizeof(_md5));
+    _rebootWhenDone = rebootWhenDone;
+    _nextChunkMs    = 0;
+    _phase          = OTA_CONNECT;
+    Serial.printf("[OTA] Downloading %s into %s\n", _url, _target->label);
+    return true;
+}
+
+void otaUpdaterTick() {
+    // Resume a download cut off by a reboot (checkpoint left in NVS).
+    if (!_resumeChecked) {
+        _resumeChecked = true;
+        otaPrefsEnsure();
+        String savedUrl = _otaPrefs.getString("url", "");
+        if (savedUrl.length() > 0 && _otaPrefs.getUInt("total", 0) > 0 &&
+            _otaPrefs.getUInt("off", 0) < _otaPrefs.getUInt("total", 0)) {
+            otaUpdaterStart(savedUrl.c_str(),
+                            _otaPrefs.getString("md5", "").c_str(),
+                            _otaPrefs.getUChar("reboot", 0) != 0);
+        }
+    }
+
+    if (_phase != OTA_CONNECT && _phase != OTA_DOWNLOAD) return;
+    if (WiFi.status() != WL_CONNECTED) return;
+    if (millis() < _nextChunkMs) return;
+    _nextChunkMs = millis() + OTA_CHUNK_INTERVAL_MS;
+
+    if (_phase == OTA_CONNECT) {
+        if (!otaOpenStream()) {
+            otaFail("connect");
+            return;
+        }
+        otaPersistState();
+        _phase = OTA_DOWNLOAD;
+        return;  // first data chunk next tick
+    }
+
+    WiFiClient *stream = _otaHttp.getStreamPtr();
+    if (!stream || !_otaHttp.connected()) {
+        // Connection dropped -- go back to CONNECT and resume via Range.
+        Serial.printf("[OTA] Stream lost at %u/%u, reconnecting\n",
+                      (unsigned)_offset, (unsigned)_total);
+        otaPersistState();
+        _otaHttp.end();
+        _phase = OTA_CONNECT;
+        return;
+    }
+
+    size_t avail = stream->available();
+    if (avail == 0) return;  // let TCP refill; timeout handled by connected()
+    size_t want = avail < sizeof(_chunkBuf) ? avail : sizeof(_chunkBuf);
+    if (_offset + want > _total) want = _total - _offset;
+    int got = stream->readBytes(_chunkBuf, want);
+    if (got <= 0) return;
+
+    // Erase just ahead of the write so the one-time cost is spread out
+    // instead of a multi-second whole-partition erase up front.
+    while (_offset + (uint32_t)got > _erasedUntil) {
+        uint32_t n = OTA_ERASE_AHEAD;
+        if (_erasedUntil + n > _target->size) n = _target->size - _erasedUntil;
+        if (esp_partition_erase_range(_target, _erasedUntil, n) != ESP_OK) {
+            otaFail("erase");
+            return;
+        }
+        _erasedUntil += n;
+    }
+
+    if (esp_partition_write(_target, _offset, _chunkBuf, (size_t)got) != ESP_OK) {
+        otaFail("write");
+        return;
+    }
+    _offset += (uint32_t)got;
+
+    if (_offset - _lastCheckpoint >= OTA_PERSIST_EVERY) {
+        _lastCheckpoint = _offset;
+        _otaPrefs.putUInt("off", _offset);
+    }
+
+    if (_offset >= _total) {
+        Serial.printf("[OTA] Download complete: %u bytes\n", (unsigned)_total);
+        otaComplete();
+    }
+}
+
+bool otaUpdaterActive() {
+    return _phase == OTA_CONNECT || _phase == OTA_DOWNLOAD;
+}
+
+bool otaUpdaterReady() {
+    return _phase == OTA_READY;
+}
+
+uint32_t otaUpdaterBytesDone()  { return _offset; }
+uint32_t otaUpdaterBytesTotal() { return _total; }
@@ -0,0 +1,37 @@
+// ==========================================================================
+//  QBIT -- Background chunked OTA updater
+// ==========================================================================
+// Streams a firmware image into the inactive app slot (dual-app partition
+// layout) one small chunk per network-task tick, so GIF playback and input
+// stay untouched while the download runs.  Progress is persisted to NVS,
+// making the download resumable across disconnects and even reboots; the
+// new image is applied by switching the boot partition once it verifies.
+#ifndef OTA_UPDATER_H
+#define OTA_UPDATER_H
+
+#include <Arduino.h>
+
+// Begin (or restart) a background download.  'url' must be an absolute
+// http(s) URL to the raw app image; 'md5' is the expected hex digest from
+// latest.json ("" skips the checksum and relies on the image header
+// validation in esp_ota_set_boot_partition).  When 'rebootWhenDone' is
+// set the device restarts into the new image as soon as it verifies;
+// otherwise it applies at the next natural reboot.
+bool otaUpdaterStart(const char *url, const char *md5, bool rebootWhenDone);
+
+// Download pump -- call from the network task loop.  Fetches at most one
+// chunk per OTA_CHUNK_INTERVAL_MS; also resumes a download interrupted by
+// a reboot on the first call.
+void otaUpdaterTick();
+
+// True while a download is in flight.
+bool otaUpdaterActive();
+
+// True once a verified image is staged and set as the boot partition.
+bool otaUpdaterReady();
+
+// Progress for status reporting: bytes staged / total (0 when unknown).
+uint32_t otaUpdaterBytesDone();
+uint32_t otaUpdaterBytesTotal();
+
+#endif // OTA_UPDATER_H
@@ -0,0 +1,202 @@
+// ==========================================================================
+//  QBIT -- Performance telemetry
+// ==========================================================================
+#include "perf_stats.h"
+#include "app_state.h"
+
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// ==========================================================================
+//  Counters (display task writes, network task reads -> portMUX)
+// ==========================================================================
+
+static portMUX_TYPE _statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t _frameTotal       = 0;
+static uint32_t _droppedFrames    = 0;
+static uint32_t _skippedFrames    = 0;
+static uint32_t _eventDrops       = 0;
+static uint32_t _pokesCoalesced   = 0;
+static uint32_t _fpsWindowStartMs = 0;
+static uint16_t _fpsWindowFrames  = 0;
+static uint16_t _fpsX10           = 0;   // FPS * 10, folded once per second
+
+static uint32_t _wsRttLastMs    = 0;
+static uint32_t _wsRttAvgMs     = 0;   // EMA, alpha = 1/4
+static uint32_t _mqttPubLastMs  = 0;
+static uint32_t _mqttPubAvgMs   = 0;
+
+#define PERF_BOOT_STAGE_MAX 8
+static struct {
+    const char *name;   // string literal supplied by the caller
+    uint32_t    ms;
+} _bootStages[PERF_BOOT_STAGE_MAX];
+static uint8_t  _bootStageCount    = 0;
+static uint32_t _bootInteractiveMs = 0;
+
+static uint16_t _wifiReconnects        = 0;
+static uint16_t _wifiDirectedReconnects = 0;   // carried by the cached-BSSID fast path
+static uint32_t _wifiReconnectLastMs   = 0;
+static uint32_t _wifiReconnectWorstMs  = 0;
+
+// ==========================================================================
+//  Hot-path hooks
+// ==========================================================================
+
+void perfStatsCountFrame() {
+    uint32_t now = millis();
+    portENTER_CRITICAL(&_statsMux);
+    _frameTotal++;
+    _fpsWindowFrames++;
+    if (_fpsWindowStartMs == 0) {
+        _fpsWindowStartMs = now;
+    } else if (now - _fpsWindowStartMs >= 1000) {
+        _fpsX10 = (uint16_t)(((uint32_t)_fpsWindowFrames * 10000UL) /
+                             (now - _fpsWindowStartMs));
+        _fpsWindowFrames  = 0;
+        _fpsWindowStartMs = now;
+    }
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void perfStatsCountDroppedFrame() {
+    portENTER_CRITICAL(&_statsMux);
+    _droppedFrames++;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void perfStatsCountSkippedFrame() {
+    portENTER_CRITICAL(&_statsMux);
+    _skippedFrames++;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void perfStatsCountEventDrop() {
+    portENTER_CRITICAL(&_statsMux);
+    _eventDrops++;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void perfStatsCountCoalescedPoke() {
+    portENTER_CRITICAL(&_statsMux);
+    _pokesCoalesced++;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void perfStatsNoteWsRtt(uint32_t ms) {
+    portENTER_CRITICAL(&_statsMux);
+    _wsRttLastMs = ms;
+    _wsRttAvgMs  = (_wsRttAvgMs == 0) ? ms : (_wsRttAvgMs * 3 + ms) / 4;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void perfStatsNoteMqttRtt(uint32_t ms) {
+    portENTER_CRITICAL(&_statsMux);
+    _mqttPubLastMs = ms;
+    _mqttPubAvgMs  = (_mqttPubAvgMs == 0) ? ms : (_mqttPubAvgMs * 3 + ms) / 4;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void perfStatsNoteBootStage(const char *name, uint32_t ms) {
+    portENTER_CRITICAL(&_statsMux);
+    if (_bootStageCount < PERF_BOOT_STAGE_MAX) {
+        _bootStages[_bootStageCount].name = name;
+        _bootStages[_bootStageCount].ms   = ms;
+        _bootStageCount++;
+    }
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void perfStatsNoteBootInteractive(uint32_t ms) {
+    _bootInteractiveMs = ms;
+}
+
+void perfStatsNoteWifiReconnect(uint32_t ms, bool directed) {
+    portENTER_CRITICAL(&_statsMux);
+    _wifiReconnects++;
+    if (directed) _wifiDirectedReconnects++;
+    _wifiReconnectLastMs = ms;
+    if (ms > _wifiReconnectWorstMs) _wifiReconnectWorstMs = ms;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+// ==========================================================================
+//  Snapshot
+// ==========================================================================
+
+// Per-task CPU shares need CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS, which
+// the Arduino core does not enable; stack headroom is the next best signal
+// for "this task is close to the edge".
+static void fillTaskStats(JsonDocument &doc) {
+    static const char *taskNames[] = { "display", "network", "input" };
+    JsonArray tasks = doc["tasks"].to<JsonArray>();
+    for (size_t i = 0; i < sizeof(taskNames) / sizeof(taskNames[0]); i++) {
+        TaskHandle_t h = xTaskGetHandle(taskNames[i]);
+        if (!h) continue;
+        JsonObject t = tasks.add<JsonObject>();
+        t["name"]            = taskNames[i];
+        t["stackHighWater"]  = (uint32_t)uxTaskGetStackHighWaterMark(h);
+    }
+}
+
+void perfStatsFillJson(JsonDocument &doc) {
+    portENTER_CRITICAL(&_statsMux);
+    uint32_t frames   = _frameTotal;
+    uint32_t dropped  = _droppedFrames;
+    uint32_t skipped  = _skippedFrames;
+    uint16_t fpsX10   = _fpsX10;
+    uint32_t wsLast   = _wsRttLastMs;
+    uint32_t wsAvg    = _wsRttAvgMs;
+    uint32_t mqttLast = _mqttPubLastMs;
+    uint32_t mqttAvg  = _mqttPubAvgMs;
+    uint32_t evDrops  = _eventDrops;
+    uint32_t coalesced = _pokesCoalesced;
+    uint16_t wifiRe   = _wifiReconnects;
+    uint16_t wifiDir  = _wifiDirectedReconnects;
+    uint32_t wifiLast = _wifiReconnectLastMs;
+    uint32_t wifiWorst = _wifiReconnectWorstMs;
+    portEXIT_CRITICAL(&_statsMux);
+
+    doc["uptime"] = (uint32_t)(esp_timer_get_time() / 1000000LL);
+
+    JsonObject heap = doc["heap"].to<JsonObject>();
+    heap["free"]         = (uint32_t)esp_get_free_heap_size();
+    heap["min"]          = (uint32_t)esp_get_minimum_free_heap_size();
+    heap["largestBlock"] = (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+
+    JsonObject disp = doc["display"].to<JsonObject>();
+    disp["fps"]     = fpsX10 / 10.0f;
+    disp["frames"]  = frames;
+    disp["dropped"] = dropped;
+    disp["skipped"] = skipped;
+
+    JsonObject net = doc["net"].to<JsonObject>();
+    net["wsRttMs"]         = wsLast;
+    net["wsRttAvgMs"]      = wsAvg;
+    net["mqttPubMs"]       = mqttLast;
+    net["mqttPubAvgMs"]    = mqttAvg;
+    net["eventPoolMisses"] = networkEventPoolMisses();
+    net["eventDrops"]      = evDrops;
+    net["pokesCoalesced"]  = coalesced;
+    net["wifiReconnects"]         = wifiRe;
+    net["wifiDirectedReconnects"] = wifiDir;
+    net["wifiReconnectMs"]        = wifiLast;
+    net["wifiReconnectWorstMs"]   = wifiWorst;
+
+    JsonObject boot = doc["boot"].to<JsonObject>();
+    boot["interactiveMs"] = _bootInteractiveMs;
+    JsonArray stages = boot["stages"].to<JsonArray>();
+    portENTER_CRITICAL(&_statsMux);
+    uint8_t stageCount = _bootStageCount;
+    portEXIT_CRITICAL(&_statsMux);
+    for (uint8_t i = 0; i < stageCount; i++) {
+        JsonObject s = stages.add<JsonObject>();
+        s["name"] = _bootStages[i].name;
+        s["ms"]   = _bootStages[i].ms;
+    }
+
+    fillTaskStats(doc);
+}
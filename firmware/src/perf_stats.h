@@ -0,0 +1,60 @@
+// ==========================================================================
+//  QBIT -- Performance telemetry (/api/stats + MQTT)
+// ==========================================================================
+// Cheap counters fed from the hot paths (display flush, GIF tick, network
+// loop) plus an on-demand snapshot that serializes heap, frame-rate and
+// latency numbers into JSON for the dashboard and Home Assistant.
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// --- Hot-path hooks (counter increments only; safe from any task) ---
+
+// One display frame actually transmitted over I2C.
+void perfStatsCountFrame();
+
+// A frame that rendered past its deadline budget (player fell behind).
+void perfStatsCountDroppedFrame();
+
+// A frame the playback governor skipped to keep the GIF wall-clock
+// accurate after a stall.
+void perfStatsCountSkippedFrame();
+
+// A network event that was lost for good (queue full past all retries,
+// or a coalesced poke evicted past the retention ring).
+void perfStatsCountEventDrop();
+
+// A poke absorbed by the burst coalescer instead of being queued
+// individually (it still reaches history via the summary event).
+void perfStatsCountCoalescedPoke();
+
+// Measured WebSocket ping -> pong round trip.
+void perfStatsNoteWsRtt(uint32_t ms);
+
+// Duration of a blocking MQTT publish call (TCP write time).
+void perfStatsNoteMqttRtt(uint32_t ms);
+
+// A completed WiFi reconnect: outage length in ms, and whether the
+// directed (cached BSSID/channel) attempt carried it.
+void perfStatsNoteWifiReconnect(uint32_t ms, bool directed);
+
+// --- Boot profiling ---
+
+// Record one named setup() stage duration. 'name' must be a string literal
+// (only the pointer is stored). Silently ignored once the table is full.
+void perfStatsNoteBootStage(const char *name, uint32_t ms);
+
+// millis() at which input + network tasks were running (gestures handled,
+// boot-critical init done).
+void perfStatsNoteBootInteractive(uint32_t ms);
+
+// --- Snapshot ---
+
+// Fill 'doc' with the current stats: uptime, heap (free/min/largest
+// block), display FPS + frame/drop counters, WS/MQTT latency, network
+// event pool misses and per-task stack headroom.
+void perfStatsFillJson(JsonDocument &doc);
+
+#endif // PERF_STATS_H
@@ -7,6 +7,7 @@
 #include "time_manager.h"
 #include "settings.h"
 #include "mbedtls/base64.h"
+#include <LittleFS.h>
 
 // ==========================================================================
 //  Internal state
@@ -39,21 +40,30 @@ static uint16_t _pokeTextSenderWidth         = 0;
 static uint16_t _pokeTextMessageWidth        = 0;
 static uint16_t _pokeTextMaxWidth            = 0;
 
-// History ring buffer (3 entries)
-#define POKE_HISTORY_SIZE 3
-static PokeRecord _pokeHistory[POKE_HISTORY_SIZE];
-static uint8_t    _pokeHistoryCount = 0;
+// Persistent history ring file (fixed slots; see "History ring file" below).
+// Only the 8-byte meta header and one lazily-loaded record live in RAM.
+#define POKE_HIST_PATH      "/.poke.hist"
+#define POKE_HIST_SLOTS     32
+#define POKE_HIST_BMP_MAX   1024   // per-bitmap cap; larger pokes stored text-only
+#define POKE_HIST_HDR_SIZE  8      // magic 'QPH1' + head + count + pad[2]
+#define POKE_HIST_SLOT_HDR  128
+#define POKE_HIST_SLOT_SIZE (POKE_HIST_SLOT_HDR + 2 * POKE_HIST_BMP_MAX)
+static uint8_t    _pokeHistoryCount = 0;   // mirrors the file meta header
 static uint8_t    _pokeHistoryHead  = 0;
+static PokeRecord _histView;               // single cached record (lazy load)
+static int16_t    _histViewIndex    = -1;  // logical index held in _histView
 
 // ==========================================================================
 //  Init
 // ==========================================================================
 
+static void pokeHistoryLoadMeta();
+
 void pokeHandlerInit() {
     _pokeActive = false;
     _pokeBitmapMode = false;
-    _pokeHistoryCount = 0;
-    _pokeHistoryHead = 0;
+    _histViewIndex = -1;
+    pokeHistoryLoadMeta();   // history survives reboots
 }
 
 // ==========================================================================
@@ -87,14 +97,14 @@ uint8_t* decodeBase64Alloc(const char *b64, size_t *outLen) {
     if (b64Len == 0 || b64Len > BASE64_MAX_INPUT_LEN)
         return nullptr;
     size_t maxOut = (b64Len * 3) / 4 + 4;
-    uint8_t *buf = (uint8_t *)malloc(maxOut);
+    uint8_t *buf = (uint8_t *)pokeBitmapAlloc(maxOut);
     if (!buf) return nullptr;
 
     size_t actualLen = 0;
     int ret = mbedtls_base64_decode(buf, maxOut, &actualLen,
                                      (const unsigned char *)b64, b64Len);
     if (ret != 0) {
-        free(buf);
+        pokeBitmapFree(buf);
         return nullptr;
     }
     *outLen = actualLen;
@@ -106,8 +116,8 @@ uint8_t* decodeBase64Alloc(const char *b64, size_t *outLen) {
 // ==========================================================================
 
 void freePokeBitmaps() {
-    if (_pokeSenderBmp) { free(_pokeSenderBmp); _pokeSenderBmp = nullptr; }
-    if (_pokeTextBmp)   { free(_pokeTextBmp);   _pokeTextBmp   = nullptr; }
+    if (_pokeSenderBmp) { pokeBitmapFree(_pokeSenderBmp); _pokeSenderBmp = nullptr; }
+    if (_pokeTextBmp)   { pokeBitmapFree(_pokeTextBmp);   _pokeTextBmp   = nullptr; }
     _pokeSenderWidth  = 0;
     _pokeSenderHeight = 0;
     _pokeTextWidth    = 0;
@@ -157,40 +167,210 @@ static void drawBitmapToBuffer(const uint8_t *bmpData, uint16_t bmpWidth,
 }
 
 // ==========================================================================
-//  Show the bitmap poke frame
+//  Pre-rendered scroll strips
 // ==========================================================================
+// Wide (>128 px) rows used to be re-rendered from glyphs or per-pixel
+// bitmap blits on every POKE_SCROLL_INTERVAL_MS tick.  Instead, each
+// scrolling row is rendered once (on poke arrival or history-entry
+// change) into a page-packed off-screen strip, and the static parts of
+// the screen into a base frame.  A scroll tick is then one base-frame
+// memcpy plus a 128-column windowed OR-blit per strip -- no glyph or
+// per-pixel work on the hot path.
+
+// Text rows use the same layout as the live poke screen
+#define POKE_ROW_SENDER_Y  28
+#define POKE_ROW_MESSAGE_Y 55   // one blank line below sender (6x13 + gap)
 
-void showPokeBitmap() {
-    u8g2.clearBuffer();
+#define POKE_STRIP_MAX_W  (512 + 64)   // widest validated bitmap + wrap gap
+#define POKE_STRIP_PAGES  3            // a 16 px row spans at most 3 pages shifted
 
-    // Row 1: title header (e.g. ">> Poke! <<" or ">> Broadcast <<")
-    u8g2.setFont(u8g2_font_6x13_tr);
-    u8g2.drawStr(4, 13, _pokeTitleLine[0] ? _pokeTitleLine : ">> Poke! <<");
+struct PokeStrip {
+    uint8_t  startPage;   // first framebuffer page the row touches
+    uint8_t  pages;       // page span (<= POKE_STRIP_PAGES)
+    uint16_t virtualW;    // content + wrap gap; 0 = row not cached
+    uint8_t  data[POKE_STRIP_PAGES * POKE_STRIP_MAX_W];
+};
 
-    // Row 2: sender name bitmap
-    const int16_t senderY = 15;
-    uint16_t senderH = _pokeSenderHeight > 0 ? _pokeSenderHeight : 16;
-    if (_pokeSenderBmp && _pokeSenderWidth > 0) {
-        int16_t senderScroll = 0;
-        if (_pokeSenderWidth > 128) {
-            senderScroll = _pokeScrollOffset;
+enum StripOwner { STRIP_NONE, STRIP_LIVE, STRIP_HISTORY };
+
+static PokeStrip        _stripSender;
+static PokeStrip        _stripMessage;
+static uint8_t          _pokeBaseFrame[1024];
+static StripOwner       _stripOwner   = STRIP_NONE;
+static const PokeRecord *_stripHistRec = nullptr;
+
+// Invalidate the cache (new poke arrived or view changed).
+static void stripInvalidate() {
+    _stripOwner   = STRIP_NONE;
+    _stripHistRec = nullptr;
+}
+
+// Render 'str' once into 'st' by sliding a 128-px window through the
+// u8g2 buffer (used as scratch; the base frame is rebuilt afterwards).
+// Column layout matches the old live draw: 4 px left margin, 64 px gap
+// between wrap repeats.
+static void _stripBuildTextRow(PokeStrip &st, const char *str, const uint8_t *font,
+                               int16_t baselineY, uint8_t startPage, uint8_t pages,
+                               uint16_t strW) {
+    st.startPage = startPage;
+    st.pages     = pages;
+    st.virtualW  = strW + 64;
+    if (st.virtualW > POKE_STRIP_MAX_W) st.virtualW = POKE_STRIP_MAX_W;
+    memset(st.data, 0, (size_t)pages * st.virtualW);
+
+    uint16_t contentW = strW + 4;   // glyphs start at x=4 inside the strip
+    if (contentW > st.virtualW) contentW = st.virtualW;
+    for (uint16_t xoff = 0; xoff < contentW; xoff += 128) {
+        u8g2.clearBuffer();
+        u8g2.setFont(font);
+        u8g2.drawStr(4 - (int16_t)xoff, baselineY, str);
+        const uint8_t *buf = u8g2.getBufferPtr();
+        uint16_t cols = contentW - xoff;
+        if (cols > 128) cols = 128;
+        for (uint8_t p = 0; p < pages; p++) {
+            memcpy(&st.data[(size_t)p * st.virtualW + xoff],
+                   &buf[(size_t)(startPage + p) * 128], cols);
         }
-        drawBitmapToBuffer(_pokeSenderBmp, _pokeSenderWidth, senderH, senderY, senderScroll);
     }
+}
 
-    // Row 3-4: message text bitmap
-    const int16_t textY = senderY + senderH + 1;
-    uint16_t textH = _pokeTextHeight > 0 ? _pokeTextHeight : 16;
-    if (_pokeTextBmp && _pokeTextWidth > 0) {
-        int16_t textScroll = 0;
-        if (_pokeTextWidth > 128) {
-            textScroll = _pokeScrollOffset;
+// Convert a page-major poke bitmap into 'st', pre-shifted for its pixel
+// row so the blit needs no bit work.
+static void _stripBuildBitmapRow(PokeStrip &st, const uint8_t *bmp, uint16_t bmpW,
+                                 uint16_t bmpH, int16_t yTop,
+                                 uint8_t startPage, uint8_t pages) {
+    st.startPage = startPage;
+    st.pages     = pages;
+    st.virtualW  = bmpW + 64;
+    if (st.virtualW > POKE_STRIP_MAX_W) st.virtualW = POKE_STRIP_MAX_W;
+    memset(st.data, 0, (size_t)pages * st.virtualW);
+
+    uint8_t  bmpPages = (bmpH + 7) / 8;
+    uint16_t cols     = bmpW;
+    if (cols > st.virtualW) cols = st.virtualW;   // clamp out-of-spec widths
+    int16_t rel0 = yTop - (int16_t)startPage * 8;
+
+    for (uint16_t x = 0; x < cols; x++) {
+        for (uint8_t sp = 0; sp < bmpPages; sp++) {
+            uint8_t b = bmp[(size_t)sp * bmpW + x];
+            if (b == 0) continue;
+            int16_t rel   = rel0 + (int16_t)sp * 8;
+            int16_t page  = rel >> 3;
+            uint8_t shift = (uint8_t)(rel & 7);
+            if (page >= 0 && page < pages)
+                st.data[(size_t)page * st.virtualW + x] |= (uint8_t)(b << shift);
+            if (shift != 0 && page + 1 >= 0 && page + 1 < pages)
+                st.data[(size_t)(page + 1) * st.virtualW + x] |= (uint8_t)(b >> (8 - shift));
         }
-        drawBitmapToBuffer(_pokeTextBmp, _pokeTextWidth, textH, textY, textScroll);
     }
+}
 
+// OR a 128-column window of the strip into the u8g2 buffer (circular).
+static void _stripBlit(const PokeStrip &st, int16_t scroll) {
+    if (st.virtualW == 0) return;
+    uint8_t *fb = u8g2.getBufferPtr();
+    const uint16_t vw  = st.virtualW;
+    const uint16_t off = (uint16_t)(((scroll % (int16_t)vw) + vw) % vw);
+
+    for (uint8_t p = 0; p < st.pages; p++) {
+        const uint8_t *src = &st.data[(size_t)p * vw];
+        uint8_t *dst = &fb[(size_t)(st.startPage + p) * 128];
+        uint16_t first = vw - off;
+        if (first > 128) first = 128;
+        for (uint16_t i = 0; i < first; i++) dst[i] |= src[off + i];
+        for (uint16_t i = first; i < 128; i++) dst[i] |= src[i - first];
+    }
+}
+
+// Base frame + strip windows -> display.
+static void _pokeComposeFrame(int16_t senderScroll, int16_t messageScroll) {
+    memcpy(u8g2.getBufferPtr(), _pokeBaseFrame, sizeof(_pokeBaseFrame));
+    _stripBlit(_stripSender, senderScroll);
+    _stripBlit(_stripMessage, messageScroll);
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
+}
+
+// Pre-render a bitmap poke/history screen: wide rows into strips, title
+// and narrow rows into the base frame.
+static void _pokePrerenderBitmap(const char *title,
+                                 const uint8_t *sBmp, uint16_t sW, uint16_t sH,
+                                 const uint8_t *tBmp, uint16_t tW, uint16_t tH) {
+    _stripSender.virtualW  = 0;
+    _stripMessage.virtualW = 0;
+
+    const int16_t senderY = 15;
+    uint16_t senderH = sH > 0 ? sH : 16;
+    const int16_t textY = senderY + senderH + 1;
+    uint16_t textH = tH > 0 ? tH : 16;
+
+    if (sBmp && sW > 128) {
+        uint8_t sp = (uint8_t)(senderY / 8);
+        uint8_t ep = (uint8_t)((senderY + senderH - 1) / 8);
+        if (ep > 7) ep = 7;
+        uint8_t pg = ep - sp + 1;
+        if (pg > POKE_STRIP_PAGES) pg = POKE_STRIP_PAGES;
+        _stripBuildBitmapRow(_stripSender, sBmp, sW, senderH, senderY, sp, pg);
+    }
+    if (tBmp && tW > 128) {
+        uint8_t sp = (uint8_t)(textY / 8);
+        uint8_t ep = (uint8_t)((textY + textH - 1) / 8);
+        if (ep > 7) ep = 7;
+        uint8_t pg = ep - sp + 1;
+        if (pg > POKE_STRIP_PAGES) pg = POKE_STRIP_PAGES;
+        _stripBuildBitmapRow(_stripMessage, tBmp, tW, textH, textY, sp, pg);
+    }
+
+    u8g2.clearBuffer();
+    u8g2.setFont(u8g2_font_6x13_tr);
+    u8g2.drawStr(4, 13, title);
+    if (sBmp && sW > 0 && sW <= 128)
+        drawBitmapToBuffer(sBmp, sW, senderH, senderY, 0);
+    if (tBmp && tW > 0 && tW <= 128)
+        drawBitmapToBuffer(tBmp, tW, textH, textY, 0);
+    memcpy(_pokeBaseFrame, u8g2.getBufferPtr(), sizeof(_pokeBaseFrame));
+}
+
+// Pre-render a text poke/history screen.  Page spans are generous enough
+// for the fonts at their fixed baselines (6x13 at y=28 -> pages 1..3,
+// 7x14 at y=55 -> pages 5..7).
+static void _pokePrerenderText(const char *title, const char *senderStr,
+                               const char *messageStr,
+                               uint16_t senderW, uint16_t messageW) {
+    _stripSender.virtualW  = 0;
+    _stripMessage.virtualW = 0;
+
+    if (senderW > 128)
+        _stripBuildTextRow(_stripSender, senderStr, u8g2_font_6x13_tr,
+                           POKE_ROW_SENDER_Y, 1, 3, senderW);
+    if (messageW > 128)
+        _stripBuildTextRow(_stripMessage, messageStr, u8g2_font_7x14_tr,
+                           POKE_ROW_MESSAGE_Y, 5, 3, messageW);
+
+    u8g2.clearBuffer();
+    u8g2.setFont(u8g2_font_6x13_tr);
+    u8g2.drawStr(4, 13, title);
+    if (senderW <= 128) u8g2.drawStr(4, POKE_ROW_SENDER_Y, senderStr);
+    if (messageW <= 128) {
+        u8g2.setFont(u8g2_font_7x14_tr);
+        u8g2.drawStr(4, POKE_ROW_MESSAGE_Y, messageStr);
+    }
+    memcpy(_pokeBaseFrame, u8g2.getBufferPtr(), sizeof(_pokeBaseFrame));
+}
+
+// ==========================================================================
+//  Show the bitmap poke frame
+// ==========================================================================
+
+void showPokeBitmap() {
+    if (_stripOwner != STRIP_LIVE) {
+        _pokePrerenderBitmap(_pokeTitleLine[0] ? _pokeTitleLine : ">> Poke! <<",
+                             _pokeSenderBmp, _pokeSenderWidth, _pokeSenderHeight,
+                             _pokeTextBmp, _pokeTextWidth, _pokeTextHeight);
+        _stripOwner = STRIP_LIVE;
+    }
+    // Rows narrower than 128 px have no strip; the blit skips them.
+    _pokeComposeFrame(_pokeScrollOffset, _pokeScrollOffset);
 }
 
 // ==========================================================================
@@ -239,30 +419,14 @@ bool pokeAdvanceScroll() {
 // ==========================================================================
 
 void showPokeHistoryBitmap(const PokeRecord *rec, const char *header, int16_t scrollX) {
-    u8g2.clearBuffer();
-
-    // Row 1: header (timestamp)
-    u8g2.setFont(u8g2_font_6x13_tr);
-    u8g2.drawStr(4, 13, header);
-
-    // Row 2: sender bitmap (only scroll if wider than 128)
-    const int16_t senderY = 15;
-    uint16_t senderH = rec->senderBmpH > 0 ? rec->senderBmpH : 16;
-    if (rec->senderBmp && rec->senderBmpW > 0) {
-        int16_t senderScroll = (rec->senderBmpW > 128) ? scrollX : 0;
-        drawBitmapToBuffer(rec->senderBmp, rec->senderBmpW, senderH, senderY, senderScroll);
+    if (_stripOwner != STRIP_HISTORY || _stripHistRec != rec) {
+        _pokePrerenderBitmap(header,
+                             rec->senderBmp, rec->senderBmpW, rec->senderBmpH,
+                             rec->textBmp, rec->textBmpW, rec->textBmpH);
+        _stripOwner   = STRIP_HISTORY;
+        _stripHistRec = rec;
     }
-
-    // Row 3-4: text bitmap (only scroll if wider than 128)
-    const int16_t textY = senderY + senderH + 1;
-    uint16_t textH = rec->textBmpH > 0 ? rec->textBmpH : 16;
-    if (rec->textBmp && rec->textBmpW > 0) {
-        int16_t textScroll = (rec->textBmpW > 128) ? scrollX : 0;
-        drawBitmapToBuffer(rec->textBmp, rec->textBmpW, textH, textY, textScroll);
-    }
-
-    rotateBuffer180();
-    u8g2.sendBuffer();
+    _pokeComposeFrame(scrollX, scrollX);
 }
 
 void pokeGetHistoryTextWidths(const PokeRecord *rec, uint16_t *outSenderW, uint16_t *outMessageW) {
@@ -273,65 +437,32 @@ void pokeGetHistoryTextWidths(const PokeRecord *rec, uint16_t *outSenderW, uint1
 }
 
 void showPokeHistoryText(const PokeRecord *rec, const char *header, int16_t senderScroll, int16_t messageScroll) {
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x13_tr);
-    u8g2.drawStr(4, 13, header);
-    const char *sStr = rec->sender.length() ? rec->sender.c_str() : "-";
-    const char *tStr = rec->text.length()   ? rec->text.c_str()   : "Poke!";
-    uint16_t senderW  = (uint16_t)u8g2.getStrWidth(sStr);
-    u8g2.setFont(u8g2_font_7x14_tr);
-    uint16_t messageW = (uint16_t)u8g2.getStrWidth(tStr);
-
-    u8g2.setFont(u8g2_font_6x13_tr);
-    int16_t sx = 4 - senderScroll;
-    u8g2.drawStr(sx, 28, sStr);
-    if (senderW > 128) {
-        uint16_t vw = senderW + 64;
-        u8g2.drawStr(sx + (int16_t)vw, 28, sStr);
+    if (_stripOwner != STRIP_HISTORY || _stripHistRec != rec) {
+        const char *sStr = rec->sender.length() ? rec->sender.c_str() : "-";
+        const char *tStr = rec->text.length()   ? rec->text.c_str()   : "Poke!";
+        u8g2.setFont(u8g2_font_6x13_tr);
+        uint16_t senderW  = (uint16_t)u8g2.getStrWidth(sStr);
+        u8g2.setFont(u8g2_font_7x14_tr);
+        uint16_t messageW = (uint16_t)u8g2.getStrWidth(tStr);
+        _pokePrerenderText(header, sStr, tStr, senderW, messageW);
+        _stripOwner   = STRIP_HISTORY;
+        _stripHistRec = rec;
     }
-    // Blank line between sender and message
-    u8g2.setFont(u8g2_font_7x14_tr);
-    int16_t mx = 4 - messageScroll;
-    u8g2.drawStr(mx, 55, tStr);
-    if (messageW > 128) {
-        uint16_t vw = messageW + 64;
-        u8g2.drawStr(mx + (int16_t)vw, 55, tStr);
-    }
-
-    rotateBuffer180();
-    u8g2.sendBuffer();
+    _pokeComposeFrame(senderScroll, messageScroll);
 }
 
 // ==========================================================================
 //  Text-only poke: title fixed; sender and message scroll separately with wrap (like bitmap)
 // ==========================================================================
-#define POKE_ROW_SENDER_Y  28
-#define POKE_ROW_MESSAGE_Y 55   // one blank line below sender (6x13 + gap)
 
 static void showPokeText(int16_t senderScroll, int16_t messageScroll) {
-    u8g2.clearBuffer();
-    u8g2.setFont(u8g2_font_6x13_tr);
-    u8g2.drawStr(4, 13, _pokeTitleLine[0] ? _pokeTitleLine : ">> Poke! <<");
-
-    // Sender row (6x13)
-    int16_t sx = 4 - senderScroll;
-    u8g2.drawStr(sx, POKE_ROW_SENDER_Y, _pokeTextSender);
-    if (_pokeTextSenderWidth > 128) {
-        uint16_t vw = _pokeTextSenderWidth + 64;
-        u8g2.drawStr(sx + (int16_t)vw, POKE_ROW_SENDER_Y, _pokeTextSender);
+    if (_stripOwner != STRIP_LIVE) {
+        _pokePrerenderText(_pokeTitleLine[0] ? _pokeTitleLine : ">> Poke! <<",
+                           _pokeTextSender, _pokeTextMessage,
+                           _pokeTextSenderWidth, _pokeTextMessageWidth);
+        _stripOwner = STRIP_LIVE;
     }
-
-    // Message row: one size larger font (7x14), one blank line below sender
-    u8g2.setFont(u8g2_font_7x14_tr);
-    int16_t mx = 4 - messageScroll;
-    u8g2.drawStr(mx, POKE_ROW_MESSAGE_Y, _pokeTextMessage);
-    if (_pokeTextMessageWidth > 128) {
-        uint16_t vw = _pokeTextMessageWidth + 64;
-        u8g2.drawStr(mx + (int16_t)vw, POKE_ROW_MESSAGE_Y, _pokeTextMessage);
-    }
-
-    rotateBuffer180();
-    u8g2.sendBuffer();
+    _pokeComposeFrame(senderScroll, messageScroll);
 }
 
 // ==========================================================================
@@ -345,6 +476,7 @@ static bool isEmptyOrNaN(const char *s) {
 
 void handlePoke(const char *sender, const char *text, const char *title) {
     freePokeBitmaps();
+    stripInvalidate();
     _pokeActive  = true;
     _pokeStartMs = millis();
     _pokeScrollOffset = 0;
@@ -389,6 +521,7 @@ void handlePokeBitmap(const char *sender, const char *text,
                       const char *senderBmp64, uint16_t senderW,
                       const char *textBmp64, uint16_t textW) {
     freePokeBitmaps();
+    stripInvalidate();
     snprintf(_pokeTitleLine, sizeof(_pokeTitleLine), ">> Poke! <<");
 
     // Decode sender bitmap
@@ -432,6 +565,7 @@ void handlePokeBitmapFromPtrs(const char *sender, const char *text,
                               uint8_t *textBmp, uint16_t textW, size_t textLen,
                               const char *title) {
     freePokeBitmaps();
+    stripInvalidate();
     if (title && strcmp(title, "NOTIFY") == 0) {
         snprintf(_pokeTitleLine, sizeof(_pokeTitleLine), "[ NOTIFY ]");
     } else {
@@ -467,71 +601,202 @@ void handlePokeBitmapFromPtrs(const char *sender, const char *text,
 }
 
 // ==========================================================================
-//  History ring buffer
+//  History ring file
 // ==========================================================================
+//  History lives in a fixed-slot ring file on LittleFS so it survives the
+//  nightly power-schedule reboots and is no longer capped by keeping every
+//  bitmap resident.  Layout:
+//    [0..7]   meta: 'QPH1', head, count, pad[2]
+//    then POKE_HIST_SLOTS slots of POKE_HIST_SLOT_SIZE bytes:
+//      [0..127]      PokeHistSlotHdr (zero-padded)
+//      [128..1151]   sender bitmap area (POKE_HIST_BMP_MAX)
+//      [1152..2175]  text bitmap area
+//  Slots are written in head order, so the file only ever grows by whole
+//  slots at the end and every slot offset stays valid.  Steady-state RAM
+//  is the 8-byte meta mirror plus one lazily loaded record (_histView);
+//  bitmaps are pulled from flash only when the user scrolls to an entry.
+//  All access happens on the display task, so no locking is needed --
+//  same as the old in-RAM ring.
+
+// On-flash slot header (memcpy'd into the first POKE_HIST_SLOT_HDR bytes)
+struct PokeHistSlotHdr {
+    uint32_t timestamp;
+    char     sender[POKE_TEXT_SENDER_LEN];
+    char     text[POKE_TEXT_MESSAGE_LEN];
+    uint16_t senderW, senderH, senderLen;
+    uint16_t textW, textH, textLen;
+};
+
+static void pokeHistorySaveMeta(File &f) {
+    uint8_t hdr[POKE_HIST_HDR_SIZE] = {
+        'Q', 'P', 'H', '1', _pokeHistoryHead, _pokeHistoryCount, 0, 0
+    };
+    f.seek(0);
+    f.write(hdr, sizeof(hdr));
+}
 
-void pokeAddToHistory(const char *sender, const char *text, time_t timestamp) {
-    PokeRecord &rec = _pokeHistory[_pokeHistoryHead];
-    rec.freeBitmaps();  // free previous bitmap data if any
-    rec.sender    = String(sender);
-    rec.text      = String(text);
-    rec.timestamp = timestamp;
-    rec.hasBitmaps = false;
-
-    _pokeHistoryHead = (_pokeHistoryHead + 1) % POKE_HISTORY_SIZE;
-    if (_pokeHistoryCount < POKE_HISTORY_SIZE) {
-        _pokeHistoryCount++;
+static void pokeHistoryLoadMeta() {
+    _pokeHistoryHead  = 0;
+    _pokeHistoryCount = 0;
+    File f = LittleFS.open(POKE_HIST_PATH, "r");
+    if (!f) return;
+    uint8_t hdr[POKE_HIST_HDR_SIZE];
+    bool ok = f.read(hdr, sizeof(hdr)) == sizeof(hdr) &&
+              memcmp(hdr, "QPH1", 4) == 0 &&
+              hdr[4] < POKE_HIST_SLOTS && hdr[5] <= POKE_HIST_SLOTS;
+    f.close();
+    if (ok) {
+        _pokeHistoryHead  = hdr[4];
+        _pokeHistoryCount = hdr[5];
+    } else {
+        Serial.println("pokeHistory: bad meta, resetting");
+        LittleFS.remove(POKE_HIST_PATH);
     }
 }
 
-void pokeAddToHistoryWithBitmaps(const char *sender, const char *text, time_t timestamp,
-                                  const uint8_t *sBmp, uint16_t sW, uint16_t sH,
-                                  const uint8_t *tBmp, uint16_t tW, uint16_t tH) {
-    PokeRecord &rec = _pokeHistory[_pokeHistoryHead];
-    rec.freeBitmaps();  // free previous bitmap data if any
-    rec.sender    = String(sender);
-    rec.text      = String(text);
-    rec.timestamp = timestamp;
+// Write one bitmap area: payload (if any) followed by zero padding up to
+// POKE_HIST_BMP_MAX, so the next slot offset is always on disk.
+static void pokeHistoryWriteBmpArea(File &f, const uint8_t *bmp, size_t len) {
+    uint8_t zpad[128] = { 0 };
+    size_t written = 0;
+    if (bmp && len > 0) {
+        f.write(bmp, len);
+        written = len;
+    }
+    while (written < POKE_HIST_BMP_MAX) {
+        size_t n = min(sizeof(zpad), (size_t)POKE_HIST_BMP_MAX - written);
+        f.write(zpad, n);
+        written += n;
+    }
+}
 
-    // Copy sender bitmap
-    if (sBmp && sW > 0 && sH > 0) {
-        size_t sSize = (size_t)(sH / 8) * sW;
-        if (sSize == 0) sSize = sW;  // at least 1 page
-        rec.senderBmp = (uint8_t *)malloc(sSize);
-        if (rec.senderBmp) {
-            memcpy(rec.senderBmp, sBmp, sSize);
-            rec.senderBmpW = sW;
-            rec.senderBmpH = sH;
+static void pokeHistoryWriteSlot(const char *sender, const char *text, time_t timestamp,
+                                 const uint8_t *sBmp, uint16_t sW, uint16_t sH, size_t sLen,
+                                 const uint8_t *tBmp, uint16_t tW, uint16_t tH, size_t tLen) {
+    // Bitmaps above the per-slot cap are dropped; the entry replays as text
+    if (sLen > POKE_HIST_BMP_MAX || tLen > POKE_HIST_BMP_MAX) {
+        sBmp = tBmp = nullptr;
+        sLen = tLen = 0;
+    }
+    if (!sBmp) sLen = 0;
+    if (!tBmp) tLen = 0;
+
+    File f = LittleFS.open(POKE_HIST_PATH, "r+");
+    if (!f) {
+        f = LittleFS.open(POKE_HIST_PATH, "w+");
+        if (!f) {
+            Serial.println("pokeHistory: open failed");
+            return;
         }
+        pokeHistorySaveMeta(f);   // fresh file: meta first so offsets line up
     }
 
-    // Copy text bitmap
-    if (tBmp && tW > 0 && tH > 0) {
-        size_t tSize = (size_t)(tH / 8) * tW;
-        if (tSize == 0) tSize = tW;
-        rec.textBmp = (uint8_t *)malloc(tSize);
-        if (rec.textBmp) {
-            memcpy(rec.textBmp, tBmp, tSize);
-            rec.textBmpW = tW;
-            rec.textBmpH = tH;
+    uint8_t slot[POKE_HIST_SLOT_HDR] = { 0 };
+    PokeHistSlotHdr h = {};
+    h.timestamp = (uint32_t)timestamp;
+    strlcpy(h.sender, sender ? sender : "", sizeof(h.sender));
+    strlcpy(h.text, text ? text : "", sizeof(h.text));
+    if (sLen > 0) { h.senderW = sW; h.senderH = sH; h.senderLen = (uint16_t)sLen; }
+    if (tLen > 0) { h.textW = tW; h.textH = tH; h.textLen = (uint16_t)tLen; }
+    memcpy(slot, &h, sizeof(h));
+
+    f.seek(POKE_HIST_HDR_SIZE + (uint32_t)_pokeHistoryHead * POKE_HIST_SLOT_SIZE);
+    f.write(slot, sizeof(slot));
+    pokeHistoryWriteBmpArea(f, sBmp, sLen);
+    pokeHistoryWriteBmpArea(f, tBmp, tLen);
+
+    _pokeHistoryHead = (_pokeHistoryHead + 1) % POKE_HIST_SLOTS;
+    if (_pokeHistoryCount < POKE_HIST_SLOTS) _pokeHistoryCount++;
+    pokeHistorySaveMeta(f);
+    f.close();
+
+    _histViewIndex = -1;   // logical indices shifted by one
+}
+
+// Load the slot at logical index (0 = most recent) into 'out'.
+static bool pokeHistoryReadSlot(uint8_t index, PokeRecord *out) {
+    int pos = (int)_pokeHistoryHead - 1 - (int)index;
+    if (pos < 0) pos += POKE_HIST_SLOTS;
+
+    File f = LittleFS.open(POKE_HIST_PATH, "r");
+    if (!f) return false;
+
+    uint32_t base = POKE_HIST_HDR_SIZE + (uint32_t)pos * POKE_HIST_SLOT_SIZE;
+    uint8_t slot[POKE_HIST_SLOT_HDR];
+    if (!f.seek(base) || f.read(slot, sizeof(slot)) != sizeof(slot)) {
+        f.close();
+        return false;
+    }
+    PokeHistSlotHdr h;
+    memcpy(&h, slot, sizeof(h));
+    h.sender[sizeof(h.sender) - 1] = '\0';
+    h.text[sizeof(h.text) - 1]     = '\0';
+
+    out->freeBitmaps();
+    out->sender    = String(h.sender);
+    out->text      = String(h.text);
+    out->timestamp = (time_t)h.timestamp;
+
+    if (h.senderLen > 0 && h.senderLen <= POKE_HIST_BMP_MAX) {
+        out->senderBmp = (uint8_t *)pokeBitmapAlloc(h.senderLen);
+        if (out->senderBmp &&
+            f.seek(base + POKE_HIST_SLOT_HDR) &&
+            f.read(out->senderBmp, h.senderLen) == h.senderLen) {
+            out->senderBmpW = h.senderW;
+            out->senderBmpH = h.senderH;
+        } else if (out->senderBmp) {
+            pokeBitmapFree(out->senderBmp);
+            out->senderBmp = nullptr;
         }
     }
+    if (h.textLen > 0 && h.textLen <= POKE_HIST_BMP_MAX) {
+        out->textBmp = (uint8_t *)pokeBitmapAlloc(h.textLen);
+        if (out->textBmp &&
+            f.seek(base + POKE_HIST_SLOT_HDR + POKE_HIST_BMP_MAX) &&
+            f.read(out->textBmp, h.textLen) == h.textLen) {
+            out->textBmpW = h.textW;
+            out->textBmpH = h.textH;
+        } else if (out->textBmp) {
+            pokeBitmapFree(out->textBmp);
+            out->textBmp = nullptr;
+        }
+    }
+    out->hasBitmaps = (out->senderBmp != nullptr || out->textBmp != nullptr);
 
-    rec.hasBitmaps = (rec.senderBmp != nullptr || rec.textBmp != nullptr);
+    f.close();
+    return true;
+}
 
-    _pokeHistoryHead = (_pokeHistoryHead + 1) % POKE_HISTORY_SIZE;
-    if (_pokeHistoryCount < POKE_HISTORY_SIZE) {
-        _pokeHistoryCount++;
+void pokeAddToHistory(const char *sender, const char *text, time_t timestamp) {
+    pokeHistoryWriteSlot(sender, text, timestamp,
+                         nullptr, 0, 0, 0, nullptr, 0, 0, 0);
+}
+
+void pokeAddToHistoryWithBitmaps(const char *sender, const char *text, time_t timestamp,
+                                  const uint8_t *sBmp, uint16_t sW, uint16_t sH,
+                                  const uint8_t *tBmp, uint16_t tW, uint16_t tH) {
+    size_t sLen = 0;
+    if (sBmp && sW > 0 && sH > 0) {
+        sLen = (size_t)(sH / 8) * sW;
+        if (sLen == 0) sLen = sW;  // at least 1 page
     }
+    size_t tLen = 0;
+    if (tBmp && tW > 0 && tH > 0) {
+        tLen = (size_t)(tH / 8) * tW;
+        if (tLen == 0) tLen = tW;
+    }
+    pokeHistoryWriteSlot(sender, text, timestamp,
+                         sBmp, sW, sH, sLen, tBmp, tW, tH, tLen);
 }
 
 PokeRecord* pokeGetHistory(uint8_t index) {
     if (index >= _pokeHistoryCount) return nullptr;
+    if ((int16_t)index == _histViewIndex) return &_histView;
 
-    // index 0 = most recent
-    int pos = (int)_pokeHistoryHead - 1 - (int)index;
-    if (pos < 0) pos += POKE_HISTORY_SIZE;
-    return &_pokeHistory[pos];
+    if (!pokeHistoryReadSlot(index, &_histView)) return nullptr;
+    _histViewIndex = index;
+    stripInvalidate();   // the cached scroll strips belong to the old record
+    return &_histView;
 }
 
 uint8_t pokeHistoryCount() {
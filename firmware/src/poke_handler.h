@@ -50,12 +50,14 @@ unsigned long pokeStartMs();
 // Current message (read-only; non-null only when active and text-only). Use to avoid overwriting custom text with "Poke!".
 const char* pokeGetCurrentMessage();
 
-// --- History ring buffer ---
+// --- History (persistent fixed-slot ring file on LittleFS) ---
 void        pokeAddToHistory(const char *sender, const char *text, time_t timestamp);
 void        pokeAddToHistoryWithBitmaps(const char *sender, const char *text, time_t timestamp,
                                         const uint8_t *sBmp, uint16_t sW, uint16_t sH,
                                         const uint8_t *tBmp, uint16_t tW, uint16_t tH);
-PokeRecord* pokeGetHistory(uint8_t index);  // 0 = most recent
+// 0 = most recent.  Returns the single lazily-loaded cached record; the
+// pointer stays valid until the next pokeGetHistory() or incoming poke.
+PokeRecord* pokeGetHistory(uint8_t index);
 uint8_t     pokeHistoryCount();
 
 // Decode base64 and allocate buffer. Returns nullptr on failure.
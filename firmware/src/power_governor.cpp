@@ -0,0 +1,71 @@
+// ==========================================================================
+//  QBIT -- WiFi power governor
+// ==========================================================================
+#include "power_governor.h"
+#include <esp_wifi.h>
+
+// Keep the radio at full performance this long after the last upload
+// chunk before dropping back to the state-mapped sleep mode.
+#define UPLOAD_BOOST_MS 10000
+
+static wifi_ps_type_t _psApplied = WIFI_PS_MIN_MODEM;  // Arduino core default
+static DisplayState   _psState   = BOOT_ANIM;
+static volatile unsigned long _uploadBoostUntilMs = 0;
+
+// State -> power-save mapping.
+//  - CAM_VIEW streams frames continuously and wants minimum latency.
+//  - Ambient states sit for hours; WIFI_PS_MAX_MODEM wakes only at the
+//    listen interval (3 beacons, ~300 ms) which is far inside the 15 s
+//    MQTT keepalive and 30 s WS ping, so pokes still arrive -- just with
+//    beacon-interval latency, which these screens don't care about.
+//  - Everything else (menus, games, prompts, portal) keeps DTIM sleep:
+//    near-full responsiveness at a fraction of the always-on draw.
+static wifi_ps_type_t psModeFor(DisplayState s) {
+    switch (s) {
+        case CAM_VIEW:
+            return WIFI_PS_NONE;
+        case GIF_PLAYBACK:
+        case HISTORY_TIME:
+        case HISTORY_POKE:
+        case WEATHER_SCREEN:
+        case TIMER_SET:
+        case TIMER_RUNNING:
+        case OFFLINE_STATUS:
+            return WIFI_PS_MAX_MODEM;
+        default:
+            return WIFI_PS_MIN_MODEM;
+    }
+}
+
+// Apply the mode for the current state + boost.  esp_wifi_set_ps() takes
+// the WiFi driver's own lock, so this is safe from any task; a cross-task
+// race here costs at most one redundant (idempotent) set call.  Before
+// the WiFi driver is up the call fails and _psApplied stays put, so the
+// next state change retries.
+static void psApply() {
+    wifi_ps_type_t want = psModeFor(_psState);
+    unsigned long boostUntil = _uploadBoostUntilMs;
+    if (boostUntil != 0 && millis() < boostUntil) want = WIFI_PS_NONE;
+
+    if (want == _psApplied) return;
+    if (esp_wifi_set_ps(want) == ESP_OK) {
+        _psApplied = want;
+        Serial.printf("[Power] WiFi PS -> %s\n",
+                      want == WIFI_PS_NONE ? "none" :
+                      want == WIFI_PS_MIN_MODEM ? "min modem" : "max modem");
+    }
+}
+
+void powerGovernorOnState(DisplayState s) {
+    _psState = s;
+    psApply();
+}
+
+void powerGovernorNoteUpload() {
+    _uploadBoostUntilMs = millis() + UPLOAD_BOOST_MS;
+    psApply();
+}
+
+void powerGovernorTick() {
+    psApply();
+}
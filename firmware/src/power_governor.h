@@ -0,0 +1,28 @@
+// ==========================================================================
+//  QBIT -- WiFi power governor
+// ==========================================================================
+// Maps the display state machine onto esp_wifi modem-sleep modes.  Idle
+// ambient states (GIF loop, clock, weather) run the deepest modem sleep,
+// interactive states use DTIM sleep, and CAM streaming plus dashboard
+// uploads force full radio performance.  The existing keepalives (30 s WS
+// ping, 15 s MQTT) are orders of magnitude above the beacon listen
+// interval, so connections ride through the sleep windows untouched.
+#ifndef POWER_GOVERNOR_H
+#define POWER_GOVERNOR_H
+
+#include "app_state.h"
+
+// Re-evaluate the power-save mode for a display state change.  Called
+// from enterState(); cheap no-op when the resulting mode is unchanged.
+void powerGovernorOnState(DisplayState s);
+
+// Note dashboard upload traffic: forces full WiFi performance until
+// shortly after the last chunk (covers aborted uploads whose final
+// callback never fires).  Safe to call per chunk.
+void powerGovernorNoteUpload();
+
+// Periodic re-evaluation (upload boost expiry); call from the network
+// task loop.
+void powerGovernorTick();
+
+#endif // POWER_GOVERNOR_H
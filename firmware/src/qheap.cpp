@@ -0,0 +1,109 @@
+// ==========================================================================
+//  QBIT -- Tagged heap accounting
+// ==========================================================================
+#include "qheap.h"
+
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <string.h>
+
+// Every qheapAlloc carries an 8-byte header so qheapFree can attribute
+// the release without a lookup table.  Payloads stay 4-byte aligned.
+struct QHeapHdr {
+    uint32_t size;
+    uint8_t  tag;
+    uint8_t  magic;
+    uint8_t  pad[2];
+};
+#define QHEAP_MAGIC 0x5A
+
+static const char *_tagNames[QHEAP_TAG_COUNT] = { "poke", "gif", "web" };
+
+// Alloc and free run from the display task, network task and async web
+// callbacks -- same short-critical-section discipline as perf_stats.
+static portMUX_TYPE _heapMux = portMUX_INITIALIZER_UNLOCKED;
+
+static struct {
+    uint32_t liveBytes;
+    uint32_t peakBytes;
+    uint32_t allocs;
+    uint32_t frees;
+} _tags[QHEAP_TAG_COUNT];
+
+static volatile uint32_t _failedAllocs   = 0;
+static volatile uint32_t _failedLastSize = 0;
+
+// Runs on whatever task just exhausted the heap -- counters only, no
+// logging (qlog itself might need to allocate).
+static void failedAllocHook(size_t size, uint32_t caps, const char *fn) {
+    (void)caps;
+    (void)fn;
+    _failedAllocs++;
+    _failedLastSize = (uint32_t)size;
+}
+
+void qheapInit() {
+    heap_caps_register_failed_alloc_callback(failedAllocHook);
+}
+
+void *qheapAlloc(QHeapTag tag, size_t size) {
+    if (tag >= QHEAP_TAG_COUNT || size == 0) return nullptr;
+
+    QHeapHdr *h = (QHeapHdr *)malloc(sizeof(QHeapHdr) + size);
+    if (!h) return nullptr;
+    h->size  = (uint32_t)size;
+    h->tag   = tag;
+    h->magic = QHEAP_MAGIC;
+
+    portENTER_CRITICAL(&_heapMux);
+    _tags[tag].liveBytes += (uint32_t)size;
+    _tags[tag].allocs++;
+    if (_tags[tag].liveBytes > _tags[tag].peakBytes)
+        _tags[tag].peakBytes = _tags[tag].liveBytes;
+    portEXIT_CRITICAL(&_heapMux);
+
+    return (void *)(h + 1);
+}
+
+void qheapFree(void *ptr) {
+    if (!ptr) return;
+
+    QHeapHdr *h = (QHeapHdr *)ptr - 1;
+    if (h->magic != QHEAP_MAGIC || h->tag >= QHEAP_TAG_COUNT) {
+        free(ptr);   // not one of ours: best effort
+        return;
+    }
+
+    portENTER_CRITICAL(&_heapMux);
+    _tags[h->tag].liveBytes -= h->size;
+    _tags[h->tag].frees++;
+    portEXIT_CRITICAL(&_heapMux);
+
+    h->magic = 0;   // turn a double free into the plain-free path above
+    free(h);
+}
+
+void qheapFillJson(JsonDocument &doc) {
+    doc["free"]           = (uint32_t)esp_get_free_heap_size();
+    doc["min"]            = (uint32_t)esp_get_minimum_free_heap_size();
+    doc["largestBlock"]   = (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    doc["failedAllocs"]   = _failedAllocs;
+    doc["failedLastSize"] = _failedLastSize;
+
+    JsonArray tags = doc["tags"].to<JsonArray>();
+    for (uint8_t i = 0; i < QHEAP_TAG_COUNT; i++) {
+        portENTER_CRITICAL(&_heapMux);
+        uint32_t live   = _tags[i].liveBytes;
+        uint32_t peak   = _tags[i].peakBytes;
+        uint32_t allocs = _tags[i].allocs;
+        uint32_t frees  = _tags[i].frees;
+        portEXIT_CRITICAL(&_heapMux);
+
+        JsonObject t = tags.add<JsonObject>();
+        t["name"]   = _tagNames[i];
+        t["live"]   = live;
+        t["peak"]   = peak;
+        t["allocs"] = allocs;
+        t["frees"]  = frees;
+    }
+}
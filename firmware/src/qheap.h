@@ -0,0 +1,42 @@
+// ==========================================================================
+//  QBIT -- Tagged heap accounting
+// ==========================================================================
+#ifndef QHEAP_H
+#define QHEAP_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Fragmentation hunts used to be blind: poke bitmaps, the GIF playback
+// cache and dashboard scratch buffers all share one heap, and when the
+// largest free block collapses nothing says who did it.  qheapAlloc is a
+// thin malloc wrapper that attributes every allocation to a subsystem
+// tag; live bytes, peak bytes and alloc/free counts per tag are exposed
+// over GET /api/heap and the periodic MQTT stats publish.  A heap-caps
+// failed-alloc hook additionally counts exhaustions from untagged
+// allocators (ArduinoJson, AsyncTCP, String).
+//
+// Add a tag (and its name in qheap.cpp) when a new subsystem starts
+// making non-pooled heap allocations.
+enum QHeapTag : uint8_t {
+    QHEAP_POKE = 0,   // poke bitmaps (arena-overflow fallback, app_state)
+    QHEAP_GIF,        // gif_player whole-file playback cache
+    QHEAP_WEB,        // dashboard request scratch (web_dashboard)
+    QHEAP_TAG_COUNT
+};
+
+// Register the heap-caps failed-alloc hook.  Call once from setup().
+void qheapInit();
+
+// malloc with attribution.  Returns nullptr on exhaustion like malloc.
+void *qheapAlloc(QHeapTag tag, size_t size);
+
+// Release a qheapAlloc'd buffer (nullptr-safe).  Pointers that did not
+// come from qheapAlloc are detected by header magic and passed straight
+// to free().
+void qheapFree(void *ptr);
+
+// Fill doc with the global heap numbers plus the per-tag table.
+void qheapFillJson(JsonDocument &doc);
+
+#endif // QHEAP_H
@@ -0,0 +1,85 @@
+// ==========================================================================
+//  QBIT -- Ring-buffer logger
+// ==========================================================================
+#include "qlog.h"
+#include <stdarg.h>
+
+#define QLOG_RING_SIZE 4096   // retained tail; also the /api/log window
+#define QLOG_LINE_MAX  160
+
+static char          _ring[QLOG_RING_SIZE];
+static uint32_t      _head  = 0;   // monotonic write index
+static uint32_t      _drain = 0;   // monotonic UART drain index
+static portMUX_TYPE  _ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char _levelChar[] = {'E', 'W', 'I'};
+
+void qlogWrite(uint8_t level, const char *fmt, ...) {
+    char line[QLOG_LINE_MAX];
+    if (level > QLOG_INFO) level = QLOG_INFO;
+    int at = snprintf(line, sizeof(line), "%8lu %c ",
+                      millis(), _levelChar[level]);
+
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(line + at, sizeof(line) - at - 1, fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    at += n;
+    if (at > (int)sizeof(line) - 2) at = (int)sizeof(line) - 2;
+    line[at++] = '\n';
+
+    portENTER_CRITICAL(&_ringMux);
+    for (int i = 0; i < at; i++) {
+        _ring[(_head + i) % QLOG_RING_SIZE] = line[i];
+    }
+    _head += at;
+    // Writer overran undrained bytes: drop the oldest rather than wait.
+    if (_head - _drain > QLOG_RING_SIZE) {
+        _drain = _head - QLOG_RING_SIZE;
+    }
+    portEXIT_CRITICAL(&_ringMux);
+}
+
+void qlogDrainTick() {
+    uint32_t head, drain;
+    portENTER_CRITICAL(&_ringMux);
+    head  = _head;
+    drain = _drain;
+    portEXIT_CRITICAL(&_ringMux);
+
+    uint32_t pending = head - drain;
+    if (pending == 0) return;
+    int room = Serial.availableForWrite();
+    if (room <= 0) return;
+    if (pending > (uint32_t)room) pending = (uint32_t)room;
+
+    // Write in at most two contiguous segments around the wrap point.
+    while (pending > 0) {
+        uint32_t pos   = drain % QLOG_RING_SIZE;
+        uint32_t chunk = QLOG_RING_SIZE - pos;
+        if (chunk > pending) chunk = pending;
+        Serial.write((const uint8_t *)&_ring[pos], chunk);
+        drain   += chunk;
+        pending -= chunk;
+    }
+
+    portENTER_CRITICAL(&_ringMux);
+    // Only advance if the writer has not already dropped past us.
+    if (drain > _drain) _drain = drain;
+    portEXIT_CRITICAL(&_ringMux);
+}
+
+size_t qlogSnapshot(char *dst, size_t cap) {
+    portENTER_CRITICAL(&_ringMux);
+    uint32_t head  = _head;
+    uint32_t avail = head > QLOG_RING_SIZE ? QLOG_RING_SIZE : head;
+    if (avail > cap) avail = cap;
+    uint32_t start = head - avail;
+    for (uint32_t i = 0; i < avail; i++) {
+        dst[i] = _ring[(start + i) % QLOG_RING_SIZE];
+    }
+    portEXIT_CRITICAL(&_ringMux);
+    dst[avail] = '\0';
+    return avail;
+}
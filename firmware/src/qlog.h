@@ -0,0 +1,36 @@
+// ==========================================================================
+//  QBIT -- Ring-buffer logger
+// ==========================================================================
+// Log lines are formatted into a RAM ring and drained to the UART later,
+// only as fast as the TX FIFO will take them -- a log call from a hot path
+// (render loop, WS poll) costs a vsnprintf plus a short critical-section
+// copy, never a 115200-baud stall.  The ring doubles as a retained tail
+// that /api/log serves, so ops can read recent logs without a serial
+// cable.  Direct Serial use stays fine for cold paths (boot, handlers).
+#ifndef QLOG_H
+#define QLOG_H
+
+#include <Arduino.h>
+
+#define QLOG_ERROR 0
+#define QLOG_WARN  1
+#define QLOG_INFO  2
+
+// Format a line into the ring (truncated to one UART-friendly line).
+// Safe from any task; never blocks on the UART.
+void qlogWrite(uint8_t level, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+#define qlogError(...) qlogWrite(QLOG_ERROR, __VA_ARGS__)
+#define qlogWarn(...)  qlogWrite(QLOG_WARN, __VA_ARGS__)
+#define qlogInfo(...)  qlogWrite(QLOG_INFO, __VA_ARGS__)
+
+// Push buffered bytes to the UART, bounded by availableForWrite().
+// Call from the network task loop.
+void qlogDrainTick();
+
+// Copy the retained tail (oldest first) into dst; returns bytes written.
+// dst must hold at least cap+1 bytes; output is NUL-terminated.
+size_t qlogSnapshot(char *dst, size_t cap);
+
+#endif // QLOG_H
@@ -6,7 +6,27 @@
 #include "display_helpers.h"
 #include "qrcode.h"
 
+// ==========================================================================
+//  Rendered-screen cache
+// ==========================================================================
+// QR generation is Reed-Solomon heavy (tens of ms on the C3) and the setup
+// screen redraws on every QR/text toggle.  The fully rendered screen is
+// cached pre-rotation for the current SSID/password pair, so repeat draws
+// are a 1 KB memcpy (the 180 deg rotate stays at draw time because flip
+// mode can change between draws).
+static uint8_t _qrCache[1024];
+static String  _qrCacheSsid;
+static String  _qrCachePass;
+static bool    _qrCacheValid = false;
+
 void showWifiQR(const char *ssid, const char *password) {
+    if (_qrCacheValid && _qrCacheSsid == ssid && _qrCachePass == password) {
+        memcpy(u8g2.getBufferPtr(), _qrCache, sizeof(_qrCache));
+        rotateBuffer180();
+        displayFlushDirty();
+        return;
+    }
+
     // Build WiFi QR content string
     String content = "WIFI:T:WPA;S:";
     content += ssid;
@@ -47,6 +67,12 @@ void showWifiQR(const char *ssid, const char *password) {
     uint8_t labelW = u8g2.getStrWidth(label);
     u8g2.drawStr((128 - labelW) / 2, 64, label);
 
+    // Cache the rendered screen before rotation for instant re-draws
+    memcpy(_qrCache, u8g2.getBufferPtr(), sizeof(_qrCache));
+    _qrCacheSsid  = ssid;
+    _qrCachePass  = password;
+    _qrCacheValid = true;
+
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
@@ -0,0 +1,74 @@
+// ==========================================================================
+//  QBIT -- Hot-path span tracer
+// ==========================================================================
+#include "qtrace.h"
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <stdio.h>
+#include <string.h>
+
+#define QTRACE_RING   128
+#define QTRACE_MIN_US 200   // noise floor: drop spans shorter than this
+
+struct TraceEvent {
+    const char *name;    // string literal supplied by the caller
+    uint32_t    tsUs;    // span start, us since boot (wraps at ~71 min)
+    uint32_t    durUs;
+};
+
+// Writers are the display task, network task and async web callbacks --
+// same short-critical-section discipline as perf_stats.
+static portMUX_TYPE _traceMux = portMUX_INITIALIZER_UNLOCKED;
+
+static TraceEvent _ring[QTRACE_RING];
+static uint16_t   _head  = 0;   // next slot to write
+static uint16_t   _count = 0;
+
+int64_t qtraceNow() {
+    return esp_timer_get_time();
+}
+
+void qtraceSpan(const char *name, int64_t startUs) {
+    int64_t dur = esp_timer_get_time() - startUs;
+    if (dur < QTRACE_MIN_US) return;
+
+    portENTER_CRITICAL(&_traceMux);
+    _ring[_head].name  = name;
+    _ring[_head].tsUs  = (uint32_t)startUs;
+    _ring[_head].durUs = (uint32_t)dur;
+    _head = (uint16_t)((_head + 1) % QTRACE_RING);
+    if (_count < QTRACE_RING) _count++;
+    portEXIT_CRITICAL(&_traceMux);
+}
+
+size_t qtraceSnapshotJson(char *out, size_t cap) {
+    if (cap < 2) {
+        if (cap) out[0] = '\0';
+        return 0;
+    }
+
+    // Copy under the mux, format outside it.  Only the async web event
+    // loop calls this, so one static scratch copy is enough.
+    static TraceEvent snap[QTRACE_RING];
+    portENTER_CRITICAL(&_traceMux);
+    uint16_t n    = _count;
+    uint16_t head = _head;
+    memcpy(snap, _ring, sizeof(_ring));
+    portEXIT_CRITICAL(&_traceMux);
+
+    size_t len = 0;
+    out[len++] = '[';
+    for (uint16_t i = 0; i < n; i++) {
+        const TraceEvent &e = snap[(head + QTRACE_RING - n + i) % QTRACE_RING];
+        int w = snprintf(out + len, cap - len,
+                         "%s{\"name\":\"%s\",\"ts\":%lu,\"us\":%lu}",
+                         i ? "," : "", e.name,
+                         (unsigned long)e.tsUs, (unsigned long)e.durUs);
+        if (w < 0 || (size_t)w >= cap - len) break;  // buffer full
+        len += (size_t)w;
+    }
+    if (len < cap) out[len++] = ']';
+    out[len] = '\0';
+    return len;
+}
@@ -0,0 +1,29 @@
+// ==========================================================================
+//  QBIT -- Hot-path span tracer
+// ==========================================================================
+// Aggregate stats (perf_stats) say a frame was late; they cannot say why.
+// qtraceSpan records named, timestamped durations into a fixed RAM ring --
+// a span costs one esp_timer read plus a short critical-section write, so
+// the hot paths (display state handlers, gifPlayerTick phases, WS message
+// handling, NVS commits) stay instrumented permanently.  GET /api/trace
+// dumps the ring as JSON, oldest first, for offline timeline viewing.
+#ifndef QTRACE_H
+#define QTRACE_H
+
+#include <Arduino.h>
+
+// Span start timestamp (us since boot; esp_timer_get_time passthrough).
+int64_t qtraceNow();
+
+// Record the span that started at startUs (from qtraceNow()) and ends
+// now.  name must be a string literal (the ring stores the pointer).
+// Spans under the noise floor are dropped so idle passes through an
+// instrumented section cost nothing but the timer read.
+void qtraceSpan(const char *name, int64_t startUs);
+
+// Render the ring as a JSON array [{"name","ts","us"}], oldest first;
+// ts is the span start in us since boot, truncated to 32 bits.  Returns
+// bytes written; out must hold at least cap+1 bytes.
+size_t qtraceSnapshotJson(char *out, size_t cap);
+
+#endif // QTRACE_H
@@ -0,0 +1,188 @@
+// ==========================================================================
+//  QBIT -- Session snapshot implementation
+// ==========================================================================
+//  A reboot used to reset every unit to the full boot sequence: boot
+//  animation, Wi-Fi splash, fresh shuffle -- visibly, even for the nightly
+//  scheduled restart.  This module keeps a small snapshot of where the UI
+//  was (display-state family, playing GIF plus shuffle-bag order, a running
+//  timer's absolute end time) in NVS, written on change with debounce, and
+//  displayTask restores it on warm resets instead of replaying the boot
+//  sequence.  Combined with warm-boot time persistence (time_manager) the
+//  device is back on its previous screen within a second.
+
+#include "session_snapshot.h"
+#include "gif_player.h"
+#include <Preferences.h>
+#include <esp_system.h>
+#include <time.h>
+
+#define SESS_NS                "qbit-sess"
+#define SESS_STATE_DEBOUNCE_MS 3000
+// Playing-file cadence: auto-advance changes the file every few GIF loops,
+// so per-change writes would chew through NVS (wear: ~1440 writes/day
+// worst case at this cadence; resume is then at most a minute behind).
+#define SESS_GIF_PERSIST_MS    (60UL * 1000UL)
+#define SESS_EPOCH_SANE        1735689600UL  // 2025-01-01; matches time_manager
+
+static Preferences   _sessPrefs;
+static bool          _warmResume = false;
+static DisplayState  _savedState = GIF_PLAYBACK;
+
+// Pending (RAM) values; tick writes them out once they settle.
+static DisplayState  _pendState      = GIF_PLAYBACK;
+static bool          _stateDirty     = false;
+static unsigned long _stateChangedMs = 0;
+static uint64_t      _pendTimerEnd   = 0;
+static bool          _timerDirty     = false;
+static String        _writtenGif;
+static unsigned long _lastGifPersistMs = 0;
+
+// Collapse transient states onto the screen the user would expect back
+// after a reboot.  Pokes, prompts, menus and games all resume as playback;
+// pre-UI states keep whatever was recorded before.
+static DisplayState _familyOf(DisplayState s) {
+    switch (s) {
+        case HISTORY_TIME:   return HISTORY_TIME;
+        case WEATHER_SCREEN: return WEATHER_SCREEN;
+        case TIMER_RUNNING:  return TIMER_RUNNING;
+        case BOOT_ANIM:
+        case WIFI_SETUP:
+        case CONNECTED_INFO: return _pendState;
+        default:             return GIF_PLAYBACK;
+    }
+}
+
+void sessionSnapshotInit() {
+    _sessPrefs.begin(SESS_NS, false);
+
+    esp_reset_reason_t r = esp_reset_reason();
+    bool warm = (r == ESP_RST_SW || r == ESP_RST_PANIC ||
+                 r == ESP_RST_INT_WDT || r == ESP_RST_TASK_WDT ||
+                 r == ESP_RST_WDT);
+
+    _savedState = (DisplayState)_sessPrefs.getUChar("state",
+                                                    (uint8_t)GIF_PLAYBACK);
+    _warmResume = warm && _sessPrefs.isKey("state");
+    _pendState  = _warmResume ? _savedState : GIF_PLAYBACK;
+    // First boot: make sure the "state" key exists so the next warm reset
+    // can resume at all.
+    _stateDirty     = !_sessPrefs.isKey("state");
+    _stateChangedMs = millis();
+    _pendTimerEnd   = _sessPrefs.getULong64("tend", 0);
+
+    if (_warmResume) {
+        Serial.printf("[Sess] Warm reset (reason %d): resuming state %d\n",
+                      (int)r, (int)_savedState);
+    }
+}
+
+bool sessionSnapshotWarmBoot() {
+    return _warmResume;
+}
+
+DisplayState sessionSnapshotState() {
+    return _savedState;
+}
+
+bool sessionSnapshotRestorePlayback() {
+    if (!gifPlayerHasFiles()) return false;
+
+    uint8_t order[GIF_INDEX_MAX];
+    size_t  n   = _sessPrefs.getBytes("bag", order, sizeof(order));
+    uint8_t pos = _sessPrefs.getUChar("bagpos", 0);
+    if (n == 0 || !gifPlayerShuffleRestore(order, (uint8_t)n, pos)) {
+        gifPlayerBuildShuffleBag();  // file set changed since the snapshot
+    }
+    gifPlayerSetAutoAdvance(1);
+
+    String gif = _sessPrefs.getString("gif", "");
+    bool known = false;
+    if (gif.length() > 0) {
+        char name[48];
+        uint8_t count = gifPlayerIndexCount();
+        for (uint8_t i = 0; i < count; i++) {
+            if (gifPlayerIndexEntry(i, name, sizeof(name)) && gif == name) {
+                known = true;
+                break;
+            }
+        }
+    }
+    gifPlayerSetFile(known ? gif : gifPlayerNextShuffle());
+    return true;
+}
+
+uint32_t sessionSnapshotTimerRemain() {
+    uint64_t end = _sessPrefs.getULong64("tend", 0);
+    if (end == 0) return 0;
+    time_t now = time(nullptr);
+    if ((unsigned long)now < SESS_EPOCH_SANE) return 0;  // clock not restored
+    if ((uint64_t)now >= end) return 0;                  // fired while down
+    return (uint32_t)(end - (uint64_t)now);
+}
+
+void sessionSnapshotNoteState(DisplayState s) {
+    DisplayState fam = _familyOf(s);
+    if (fam == _pendState) return;
+    _pendState      = fam;
+    _stateDirty     = true;
+    _stateChangedMs = millis();
+}
+
+void sessionSnapshotNoteTimer(uint32_t remainSec) {
+    uint64_t end = 0;
+    if (remainSec > 0) {
+        time_t now = time(nullptr);
+        // Without a sane clock there is nothing to anchor the end time to;
+        // the timer then simply does not survive a reboot.
+        if ((unsigned long)now >= SESS_EPOCH_SANE) {
+            end = (uint64_t)now + remainSec;
+        }
+    }
+    if (end != _pendTimerEnd) {
+        _pendTimerEnd = end;
+        _timerDirty   = true;
+    }
+}
+
+void sessionSnapshotTick() {
+    unsigned long now = millis();
+
+    if (_stateDirty && now - _stateChangedMs >= SESS_STATE_DEBOUNCE_MS) {
+        _stateDirty = false;
+        _sessPrefs.putUChar("state", (uint8_t)_pendState);
+    }
+
+    if (_timerDirty) {
+        _timerDirty = false;
+        if (_pendTimerEnd == 0) {
+            _sessPrefs.remove("tend");
+        } else {
+            _sessPrefs.putULong64("tend", _pendTimerEnd);
+        }
+    }
+
+    // Playing file + bag, on the slow cadence (cadence check first so the
+    // steady state costs no String allocation per wake).
+    if (_pendState == GIF_PLAYBACK &&
+        now - _lastGifPersistMs >= SESS_GIF_PERSIST_MS) {
+        _lastGifPersistMs = now;
+        String cur = gifPlayerGetCurrentFile();
+        if (cur.length() > 0 && cur != _writtenGif) {
+            _writtenGif = cur;
+            _sessPrefs.putString("gif", cur);
+            uint8_t order[GIF_INDEX_MAX];
+            uint8_t pos   = 0;
+            uint8_t total = gifPlayerShuffleSnapshot(order, &pos);
+            if (total > 0) {
+                _sessPrefs.putBytes("bag", order, total);
+                _sessPrefs.putUChar("bagpos", pos);
+            }
+        }
+    }
+}
+
+void sessionSnapshotClear() {
+    _sessPrefs.clear();
+    _stateDirty = false;
+    _timerDirty = false;
+}
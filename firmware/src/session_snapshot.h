@@ -0,0 +1,48 @@
+// ==========================================================================
+//  QBIT -- Session snapshot (instant resume after reboot)
+// ==========================================================================
+#ifndef SESSION_SNAPSHOT_H
+#define SESSION_SNAPSHOT_H
+
+#include <Arduino.h>
+#include "app_state.h"
+
+// Open the NVS namespace and classify the reset.  Call from displayTask
+// before the boot animation (gifPlayerInit must already have run).
+void sessionSnapshotInit();
+
+// True when this boot is a warm restart (software reset, panic, watchdog)
+// and a snapshot exists: skip the boot animation and Wi-Fi splash and
+// restore the saved state instead.
+bool sessionSnapshotWarmBoot();
+
+// The persisted display-state family (GIF_PLAYBACK, HISTORY_TIME,
+// WEATHER_SCREEN or TIMER_RUNNING).  Only meaningful on a warm boot.
+DisplayState sessionSnapshotState();
+
+// Restore GIF playback: shuffle-bag order and position, auto-advance, and
+// the file that was playing (falls back to the next shuffle pick when the
+// file set changed).  Returns false when no .qgif files exist -- the
+// caller starts the idle animation instead.
+bool sessionSnapshotRestorePlayback();
+
+// Seconds left on a persisted running timer, 0 when none was running,
+// it fired while the device was down, or the clock is not yet sane.
+uint32_t sessionSnapshotTimerRemain();
+
+// Record a display-state change (called from enterState); persisted after
+// a short debounce.  Transient states map onto their family.
+void sessionSnapshotNoteState(DisplayState s);
+
+// Record that a countdown started (remainSec > 0, stored as an absolute
+// end epoch -- one write, no per-second churn) or was dismissed (0).
+void sessionSnapshotNoteTimer(uint32_t remainSec);
+
+// Debounced NVS writes; call once per display-loop wake.
+void sessionSnapshotTick();
+
+// Drop the snapshot (Wi-Fi reset: the next boot must show provisioning,
+// not resume playback).
+void sessionSnapshotClear();
+
+#endif // SESSION_SNAPSHOT_H
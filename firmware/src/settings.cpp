@@ -3,6 +3,7 @@
 // ==========================================================================
 #include "settings.h"
 #include "gif_player.h"
+#include "qtrace.h"
 
 extern void weatherScreenInvalidateCache();
 
@@ -20,6 +21,52 @@ static SemaphoreHandle_t _prefsMutex = NULL;
 
 #define TZ_IANA_MAX_LEN 64
 
+// ==========================================================================
+//  Packed settings blob
+// ==========================================================================
+// Everything except the GPIO pin config (which is needed before hardware
+// init and keeps its own keys) persists as ONE packed struct under a
+// single NVS entry.  Boot is one getBytes() instead of ~25 keyed lookups,
+// and every save is one flash commit instead of one per key.  Runtime
+// setters (game high scores, weather location) only mark the blob dirty;
+// settingsFlushTick() commits after writes go quiet, so a game-over
+// never stalls on a synchronous NVS write.
+
+#define SETTINGS_BLOB_KEY       "cfg"
+#define SETTINGS_BLOB_VERSION   1
+#define SETTINGS_FLUSH_QUIET_MS 2000  // commit this long after the last change
+
+#define CFG_FLAG_FLIP    0x01
+#define CFG_FLAG_NEG_GIF 0x02
+#define CFG_FLAG_TIME24H 0x04
+#define CFG_FLAG_MQTT_ON 0x08
+#define CFG_FLAG_WT_MAN  0x10
+
+struct __attribute__((packed)) SettingsBlob {
+    uint8_t  version;
+    uint8_t  brightness;
+    uint8_t  volume;
+    uint8_t  flags;
+    uint16_t speed;
+    uint16_t mqttPort;
+    uint32_t trexHi;
+    uint32_t flappyHi;
+    uint32_t carHi;
+    float    wtLat;
+    float    wtLon;
+    char     devName[48];
+    char     mqttHost[MQTT_HOST_MAX_LEN + 1];
+    char     mqttUser[MQTT_USER_MAX_LEN + 1];
+    char     mqttPass[MQTT_PASS_MAX_LEN + 1];
+    char     mqttPrefix[MQTT_PREFIX_MAX_LEN + 1];
+    char     tzName[TZ_IANA_MAX_LEN + 1];
+    char     wtCity[WEATHER_CITY_MAX_LEN + 1];
+    char     wtName[WEATHER_NAME_MAX_LEN + 1];
+};
+
+static volatile bool _settingsDirty   = false;
+static unsigned long _settingsDirtyMs = 0;
+
 // GPIO pin defaults (ESP32-C3 Super Mini)
 static uint8_t _pinTouch  = 1;
 static uint8_t _pinBuzzer = 2;
@@ -135,12 +182,105 @@ void settingsInit() {
                   _pinTouch, _pinBuzzer, _pinSDA, _pinSCL);
 }
 
+// Copy the RAM settings into a blob ready for putBytes().
+static void blobFromRam(SettingsBlob &b) {
+    memset(&b, 0, sizeof(b));
+    b.version    = SETTINGS_BLOB_VERSION;
+    b.brightness = _brightness;
+    b.volume     = _buzzerVolume;
+    b.flags      = (_flipMode      ? CFG_FLAG_FLIP    : 0) |
+                   (_negativeGif   ? CFG_FLAG_NEG_GIF : 0) |
+                   (_timeFormat24h ? CFG_FLAG_TIME24H : 0) |
+                   (_mqttEnabled   ? CFG_FLAG_MQTT_ON : 0) |
+                   (_weatherManual ? CFG_FLAG_WT_MAN  : 0);
+    b.speed      = gifPlayerGetSpeed();
+    b.mqttPort   = _mqttPort;
+    b.trexHi     = _trexHighScore;
+    b.flappyHi   = _flappyHighScore;
+    b.carHi      = _carHighScore;
+    b.wtLat      = _weatherLat;
+    b.wtLon      = _weatherLon;
+    strlcpy(b.devName,    _deviceName.c_str(),         sizeof(b.devName));
+    strlcpy(b.mqttHost,   _mqttHost.c_str(),           sizeof(b.mqttHost));
+    strlcpy(b.mqttUser,   _mqttUser.c_str(),           sizeof(b.mqttUser));
+    strlcpy(b.mqttPass,   _mqttPass.c_str(),           sizeof(b.mqttPass));
+    strlcpy(b.mqttPrefix, _mqttPrefix.c_str(),         sizeof(b.mqttPrefix));
+    strlcpy(b.tzName,     _tzIANA.c_str(),             sizeof(b.tzName));
+    strlcpy(b.wtCity,     _weatherCity.c_str(),        sizeof(b.wtCity));
+    strlcpy(b.wtName,     _weatherDisplayName.c_str(), sizeof(b.wtName));
+}
+
+// Populate the RAM settings from a loaded blob (already size/version checked).
+static void blobToRam(SettingsBlob &b) {
+    // Defensive NUL termination in case the stored blob was truncated/corrupt
+    b.devName[sizeof(b.devName) - 1]       = '\0';
+    b.mqttHost[sizeof(b.mqttHost) - 1]     = '\0';
+    b.mqttUser[sizeof(b.mqttUser) - 1]     = '\0';
+    b.mqttPass[sizeof(b.mqttPass) - 1]     = '\0';
+    b.mqttPrefix[sizeof(b.mqttPrefix) - 1] = '\0';
+    b.tzName[sizeof(b.tzName) - 1]         = '\0';
+    b.wtCity[sizeof(b.wtCity) - 1]         = '\0';
+    b.wtName[sizeof(b.wtName) - 1]         = '\0';
+
+    _brightness      = b.brightness;
+    _buzzerVolume    = b.volume;
+    _savedVolume     = _buzzerVolume > 0 ? _buzzerVolume : 100;
+    _flipMode        = (b.flags & CFG_FLAG_FLIP)    != 0;
+    _negativeGif     = (b.flags & CFG_FLAG_NEG_GIF) != 0;
+    _timeFormat24h   = (b.flags & CFG_FLAG_TIME24H) != 0;
+    _mqttEnabled     = (b.flags & CFG_FLAG_MQTT_ON) != 0;
+    _weatherManual   = (b.flags & CFG_FLAG_WT_MAN)  != 0;
+    _mqttPort        = b.mqttPort;
+    _trexHighScore   = b.trexHi;
+    _flappyHighScore = b.flappyHi;
+    _carHighScore    = b.carHi;
+    _weatherLat      = b.wtLat;
+    _weatherLon      = b.wtLon;
+    _deviceName         = String(b.devName);
+    _mqttHost           = String(b.mqttHost);
+    _mqttUser           = String(b.mqttUser);
+    _mqttPass           = String(b.mqttPass);
+    _mqttPrefix         = String(b.mqttPrefix);
+    _tzIANA             = String(b.tzName);
+    _weatherCity        = String(b.wtCity);
+    _weatherDisplayName = String(b.wtName);
+
+    if (_deviceName.length() == 0)
+        _deviceName = "QBIT-" + getDeviceId().substring(0, 4);
+    if (_mqttPrefix.length() == 0) _mqttPrefix = "qbit";
+    if (_mqttPort < MQTT_PORT_MIN || _mqttPort > MQTT_PORT_MAX) _mqttPort = MQTT_PORT_DEFAULT;
+}
+
 void loadSettings() {
     if (!_prefsReady) {
         settingsInit();
     }
     if (xSemaphoreTake(_prefsMutex, portMAX_DELAY) != pdTRUE) return;
 
+    // Fast path: one NVS read for the whole packed blob
+    static SettingsBlob blob;  // ~700 B; static to keep it off task stacks
+    size_t n = _prefs.getBytes(SETTINGS_BLOB_KEY, &blob, sizeof(blob));
+    bool blobValid = (n == sizeof(blob) && blob.version == SETTINGS_BLOB_VERSION);
+    if (blobValid) {
+        blobToRam(blob);
+        xSemaphoreGive(_prefsMutex);
+
+        gifPlayerSetSpeed(blob.speed);
+
+        Serial.printf("Settings loaded: bright=%u vol=%u speed=%u\n",
+                      _brightness, _buzzerVolume, blob.speed);
+        Serial.printf("Device ID: %s  Name: %s\n",
+                      getDeviceId().c_str(), _deviceName.c_str());
+        if (_mqttEnabled && _mqttHost.length() > 0) {
+            Serial.printf("MQTT: %s:%u (prefix: %s)\n",
+                          _mqttHost.c_str(), _mqttPort, _mqttPrefix.c_str());
+        }
+        return;
+    }
+
+    // Legacy keyed settings (pre-blob firmware) -- read once, then migrate
+    // by writing the blob below.  The old keys are left in place; they are
+    // simply never read again.
     _brightness   = _prefs.getUChar("bright", 0x80);
     _buzzerVolume = _prefs.getUChar("volume", 100);
     _savedVolume  = _buzzerVolume > 0 ? _buzzerVolume : 100;
@@ -208,41 +348,39 @@ void loadSettings() {
         Serial.printf("MQTT: %s:%u (prefix: %s)\n",
                       _mqttHost.c_str(), _mqttPort, _mqttPrefix.c_str());
     }
+
+    // One-time migration: persist the blob so the next boot takes the fast path
+    saveSettings();
 }
 
 void saveSettings() {
     if (!_prefsReady) return;
     if (xSemaphoreTake(_prefsMutex, portMAX_DELAY) != pdTRUE) return;
 
-    _prefs.putUShort("speed",    gifPlayerGetSpeed());
-    _prefs.putUChar("bright",    _brightness);
-    _prefs.putUChar("volume",    _buzzerVolume);
-    _prefs.putString("devname",  _deviceName);
-    _prefs.putString("mqttHost", _mqttHost);
-    _prefs.putUShort("mqttPort", _mqttPort);
-    _prefs.putString("mqttUser", _mqttUser);
-    _prefs.putString("mqttPass", _mqttPass);
-    _prefs.putString("mqttPfx",  _mqttPrefix);
-    _prefs.putBool("mqttOn",     _mqttEnabled);
-    _prefs.putUChar("pinTouch",  _pinTouch);
-    _prefs.putUChar("pinBuzzer", _pinBuzzer);
-    _prefs.putUChar("pinSDA",    _pinSDA);
-    _prefs.putUChar("pinSCL",    _pinSCL);
-    _prefs.putString("tzName",   _tzIANA);
-    _prefs.putBool("flipMode",   _flipMode);
-    _prefs.putBool("negGif",     _negativeGif);
-    _prefs.putBool("time24h",    _timeFormat24h);
-    _prefs.putUInt("trexHi",     _trexHighScore);
-    _prefs.putUInt("flappyHi",   _flappyHighScore);
-    _prefs.putUInt("carHi",      _carHighScore);
-    // Weather location
-    _prefs.putString("wtCity",   _weatherCity);
-    _prefs.putFloat("wtLat",     _weatherLat);
-    _prefs.putFloat("wtLon",     _weatherLon);
-    _prefs.putString("wtName",   _weatherDisplayName);
-    _prefs.putBool("wtMan",      _weatherManual);
+    static SettingsBlob blob;  // protected by _prefsMutex
+    blobFromRam(blob);
+    int64_t tSpan = qtraceNow();
+    size_t n = _prefs.putBytes(SETTINGS_BLOB_KEY, &blob, sizeof(blob));
+    qtraceSpan("nvs.commit", tSpan);
+    _settingsDirty = false;
     xSemaphoreGive(_prefsMutex);
-    Serial.println("Settings saved to NVS");
+
+    if (n != sizeof(blob))
+        Serial.println("Settings save FAILED (NVS putBytes)");
+    else
+        Serial.println("Settings saved to NVS");
+}
+
+void settingsMarkDirty() {
+    _settingsDirty   = true;
+    _settingsDirtyMs = millis();
+}
+
+void settingsFlushTick() {
+    if (!_settingsDirty) return;
+    if ((unsigned long)(millis() - _settingsDirtyMs) < SETTINGS_FLUSH_QUIET_MS)
+        return;
+    saveSettings();
 }
 
 // ==========================================================================
@@ -350,14 +488,13 @@ void    setTimezoneIANA(const String &tz) {
 //  Game high scores
 // ==========================================================================
 // T-Rex Runner
+// High scores only mark the blob dirty -- the deferred flush commits them a
+// couple of seconds later, so game-over never blocks on a flash write.
 uint32_t getTrexHighScore()          { return _trexHighScore; }
 void     setTrexHighScore(uint32_t s) {
     if (s > _trexHighScore) {
         _trexHighScore = s;
-        if (_prefsReady && xSemaphoreTake(_prefsMutex, portMAX_DELAY) == pdTRUE) {
-            _prefs.putUInt("trexHi", _trexHighScore);
-            xSemaphoreGive(_prefsMutex);
-        }
+        settingsMarkDirty();
     }
 }
 
@@ -366,11 +503,7 @@ uint32_t getFlappyHighScore()           { return _flappyHighScore; }
 void     setFlappyHighScore(uint32_t s) {
     if (s > _flappyHighScore) {
         _flappyHighScore = s;
-        // Persist immediately so it survives power-off
-        if (_prefsReady && xSemaphoreTake(_prefsMutex, portMAX_DELAY) == pdTRUE) {
-            _prefs.putUInt("flappyHi", _flappyHighScore);
-            xSemaphoreGive(_prefsMutex);
-        }
+        settingsMarkDirty();
     }
 }
 
@@ -379,10 +512,7 @@ uint32_t getCarHighScore()           { return _carHighScore; }
 void     setCarHighScore(uint32_t s) {
     if (s > _carHighScore) {
         _carHighScore = s;
-        if (_prefsReady && xSemaphoreTake(_prefsMutex, portMAX_DELAY) == pdTRUE) {
-            _prefs.putUInt("carHi", _carHighScore);
-            xSemaphoreGive(_prefsMutex);
-        }
+        settingsMarkDirty();
     }
 }
 
@@ -405,13 +535,7 @@ void setWeatherLocation(float lat, float lon,
     _weatherLon         = lon;
     _weatherCity        = city.length()        > WEATHER_CITY_MAX_LEN ? city.substring(0, WEATHER_CITY_MAX_LEN)               : city;
     _weatherDisplayName = displayName.length() > WEATHER_NAME_MAX_LEN ? displayName.substring(0, WEATHER_NAME_MAX_LEN) : displayName;
-    if (_prefsReady && xSemaphoreTake(_prefsMutex, portMAX_DELAY) == pdTRUE) {
-        _prefs.putFloat("wtLat",   _weatherLat);
-        _prefs.putFloat("wtLon",   _weatherLon);
-        _prefs.putString("wtCity", _weatherCity);
-        _prefs.putString("wtName", _weatherDisplayName);
-        xSemaphoreGive(_prefsMutex);
-    }
+    settingsMarkDirty();
     weatherScreenInvalidateCache();
 }
 
@@ -419,8 +543,5 @@ bool getWeatherManual() { return _weatherManual; }
 
 void setWeatherManual(bool manual) {
     _weatherManual = manual;
-    if (_prefsReady && xSemaphoreTake(_prefsMutex, portMAX_DELAY) == pdTRUE) {
-        _prefs.putBool("wtMan", _weatherManual);
-        xSemaphoreGive(_prefsMutex);
-    }
+    settingsMarkDirty();
 }
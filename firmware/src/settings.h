@@ -10,12 +10,22 @@
 // Must be called before any other settings function.
 void settingsInit();
 
-// Load all settings from NVS into RAM variables.
+// Load all settings from NVS into RAM variables.  Reads the packed
+// settings blob in one NVS lookup; falls back to the legacy per-key
+// layout once (pre-blob firmware) and migrates it.
 void loadSettings();
 
-// Persist current RAM settings to NVS.
+// Persist current RAM settings to NVS now (single packed-blob commit).
 void saveSettings();
 
+// Mark the RAM settings as changed without touching flash.  The change is
+// committed by settingsFlushTick() after a short quiet period.
+void settingsMarkDirty();
+
+// Call periodically (network task loop): commits the packed blob once no
+// settingsMarkDirty() has happened for a couple of seconds.
+void settingsFlushTick();
+
 // --- Device identity ---
 String getDeviceId();
 String getDeviceName();
@@ -0,0 +1,145 @@
+// ==========================================================================
+//  QBIT -- System animations (boot/idle) from the 'anim' flash partition
+// ==========================================================================
+//  The boot and idle animations used to be compiled in as ~360 KB of PROGMEM
+//  arrays (sys_scx.h / sys_idle.h), bloating the app image and every OTA.
+//  They now live in a dedicated data partition packed by
+//  tools/pack_sys_anims.py: a small TOC followed by plain v1 .qgif blobs.
+//  The partition is memory-mapped once at boot and AnimatedGIF structs are
+//  built pointing straight into the mapped region, so the existing
+//  PROGMEM-style playback code in display_task / gif_player is unchanged.
+//
+//  Delay tables are copied to RAM because the blob layout leaves them
+//  unaligned; frame data (1024-byte arrays) is referenced in place and read
+//  through the flash cache exactly like the old PROGMEM arrays were.
+//
+//  Dev boards without the partition flashed can build with
+//  -DQBIT_SYS_ANIM_EMBEDDED to keep the PROGMEM arrays as a fallback.
+#include "sys_anim.h"
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <new>
+#include <string.h>
+
+#ifdef QBIT_SYS_ANIM_EMBEDDED
+#include "sys_scx.h"
+#include "sys_idle.h"
+#endif
+
+// Partition image layout (written by tools/pack_sys_anims.py):
+//   [0..3]   magic 'QANM'
+//   [4]      version (1)
+//   [5]      entry count
+//   then per entry (24 bytes):
+//   [0..15]  name, NUL-padded ("boot", "idle")
+//   [16..19] uint32 blob offset from partition start (LE)
+//   [20..23] uint32 blob length (LE)
+#define SYS_ANIM_PARTITION   "anim"
+#define SYS_ANIM_SUBTYPE     ((esp_partition_subtype_t)0x40)
+#define SYS_ANIM_MAGIC       "QANM"
+#define SYS_ANIM_VERSION     1
+#define SYS_ANIM_TOC_HDR     6
+#define SYS_ANIM_ENTRY_SIZE  24
+#define SYS_ANIM_NAME_LEN    16
+
+static const uint8_t *_animBase  = nullptr;   // mmap'd partition start
+static AnimatedGIF    _bootAnim  = { 0, 0, 0, nullptr, nullptr };
+static AnimatedGIF    _idleAnim  = { 0, 0, 0, nullptr, nullptr };
+static bool           _bootValid = false;
+static bool           _idleValid = false;
+static uint16_t       _bootDelays[QGIF_MAX_FRAMES];
+static uint16_t       _idleDelays[QGIF_MAX_FRAMES];
+
+static uint32_t readLE32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Build an AnimatedGIF over a v1 .qgif blob inside the mapped partition.
+static bool animFromBlob(const uint8_t *blob, uint32_t len,
+                         uint16_t *delaysOut, AnimatedGIF *out) {
+    if (len < QGIF_HEADER_SIZE) return false;
+    uint8_t  fc = blob[0];
+    uint16_t w  = (uint16_t)blob[1] | ((uint16_t)blob[2] << 8);
+    uint16_t h  = (uint16_t)blob[3] | ((uint16_t)blob[4] << 8);
+    if (fc == 0 || w != QGIF_FRAME_WIDTH || h != QGIF_FRAME_HEIGHT) return false;
+    uint32_t need = QGIF_HEADER_SIZE + (uint32_t)fc * 2 +
+                    (uint32_t)fc * QGIF_FRAME_SIZE;
+    if (len < need) return false;
+
+    for (uint8_t i = 0; i < fc; i++) {
+        delaysOut[i] = (uint16_t)blob[QGIF_HEADER_SIZE + i * 2] |
+                       ((uint16_t)blob[QGIF_HEADER_SIZE + i * 2 + 1] << 8);
+    }
+    const uint8_t (*frames)[QGIF_FRAME_SIZE] =
+        (const uint8_t (*)[QGIF_FRAME_SIZE])(blob + QGIF_HEADER_SIZE + (uint32_t)fc * 2);
+    // AnimatedGIF has const members, so rebuild it in place
+    new (out) AnimatedGIF{ fc, w, h, delaysOut, frames };
+    return true;
+}
+
+bool sysAnimInit() {
+    const esp_partition_t *part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, SYS_ANIM_SUBTYPE, SYS_ANIM_PARTITION);
+    if (!part) {
+        Serial.println("sysAnim: no 'anim' partition");
+        return false;
+    }
+
+    const void *base = nullptr;
+    esp_partition_mmap_handle_t handle;
+    if (esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA,
+                           &base, &handle) != ESP_OK) {
+        Serial.println("sysAnim: mmap failed");
+        return false;
+    }
+    _animBase = (const uint8_t *)base;
+
+    if (memcmp(_animBase, SYS_ANIM_MAGIC, 4) != 0 ||
+        _animBase[4] != SYS_ANIM_VERSION) {
+        Serial.println("sysAnim: bad TOC (partition not flashed?)");
+        return false;
+    }
+
+    uint8_t count = _animBase[5];
+    for (uint8_t i = 0; i < count; i++) {
+        const uint8_t *e = _animBase + SYS_ANIM_TOC_HDR +
+                           (uint32_t)i * SYS_ANIM_ENTRY_SIZE;
+        char name[SYS_ANIM_NAME_LEN + 1];
+        memcpy(name, e, SYS_ANIM_NAME_LEN);
+        name[SYS_ANIM_NAME_LEN] = '\0';
+        uint32_t off = readLE32(e + SYS_ANIM_NAME_LEN);
+        uint32_t len = readLE32(e + SYS_ANIM_NAME_LEN + 4);
+        if (off > part->size || len > part->size - off) continue;
+
+        if (strcmp(name, "boot") == 0) {
+            _bootValid = animFromBlob(_animBase + off, len, _bootDelays, &_bootAnim);
+        } else if (strcmp(name, "idle") == 0) {
+            _idleValid = animFromBlob(_animBase + off, len, _idleDelays, &_idleAnim);
+        }
+    }
+
+    Serial.printf("sysAnim: boot=%s idle=%s\n",
+                  _bootValid ? "ok" : "missing",
+                  _idleValid ? "ok" : "missing");
+    return _bootValid || _idleValid;
+}
+
+const AnimatedGIF *sysAnimBoot() {
+    if (_bootValid) return &_bootAnim;
+#ifdef QBIT_SYS_ANIM_EMBEDDED
+    return &sys_scx_gif;
+#else
+    return nullptr;
+#endif
+}
+
+const AnimatedGIF *sysAnimIdle() {
+    if (_idleValid) return &_idleAnim;
+#ifdef QBIT_SYS_ANIM_EMBEDDED
+    return &sys_idle_gif;
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,21 @@
+// ==========================================================================
+//  QBIT -- System animations (boot/idle) from the 'anim' flash partition
+// ==========================================================================
+#ifndef SYS_ANIM_H
+#define SYS_ANIM_H
+
+#include "gif_types.h"
+
+// Find and memory-map the 'anim' data partition (see partitions.csv) and
+// parse its table of contents.  Returns true if at least one animation was
+// found.  Call once before sysAnimBoot()/sysAnimIdle().
+bool sysAnimInit();
+
+// Boot animation, or nullptr if the partition is missing/invalid (builds
+// with -DQBIT_SYS_ANIM_EMBEDDED fall back to the compiled-in PROGMEM copy).
+const AnimatedGIF *sysAnimBoot();
+
+// Idle animation, same fallback rules as sysAnimBoot().
+const AnimatedGIF *sysAnimIdle();
+
+#endif // SYS_ANIM_H
@@ -6,8 +6,11 @@
 #include <WiFi.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include <Preferences.h>
 #include <cstring>
 #include <time.h>
+#include <sys/time.h>
+#include <esp_sntp.h>
 
 // ==========================================================================
 //  IANA → POSIX TZ lookup (common timezones)
@@ -59,11 +62,68 @@ static const char* ianaToPosix(const String &iana) {
     return nullptr;
 }
 
+// ==========================================================================
+//  Warm-boot time persistence
+// ==========================================================================
+// After a reboot the clock used to read 1970 until SNTP came back -- many
+// seconds with WiFi up, forever without.  The last-known epoch is written
+// to NVS on a slow cadence and restored via settimeofday() before SNTP
+// starts, so the clock screen and poke timestamps are immediately close
+// (off by at most the persist interval plus the downtime); SNTP then
+// refines silently.  The same namespace remembers which SSID the ip-api
+// geo lookup succeeded under, so the blocking lookup reruns only when the
+// network actually changed.
+
+#define TIME_PERSIST_NS        "qbit-time"
+#define TIME_PERSIST_INTERVAL_MS (10UL * 60UL * 1000UL)
+#define TIME_EPOCH_SANE        1735689600UL  // 2025-01-01; reject garbage
+
+static Preferences _timePrefs;
+static unsigned long _lastPersistMs    = 0;
+static volatile bool _sntpSyncedFlag   = false;  // set from SNTP callback
+static bool          _persistedRefined = false;  // wrote a post-sync epoch
+
+static void timePersistEpoch() {
+    time_t now = time(nullptr);
+    if ((unsigned long)now < TIME_EPOCH_SANE) return;
+    _timePrefs.putULong64("epoch", (uint64_t)now);
+}
+
+void timeManagerPersistTick() {
+    // One immediate write when SNTP first refines the restored clock,
+    // then a slow cadence (NVS wear: ~150 writes/day worst case).
+    if (_sntpSyncedFlag && !_persistedRefined) {
+        _persistedRefined = true;
+        timePersistEpoch();
+        _lastPersistMs = millis();
+        return;
+    }
+    if (millis() - _lastPersistMs >= TIME_PERSIST_INTERVAL_MS) {
+        _lastPersistMs = millis();
+        timePersistEpoch();
+    }
+}
+
 // ==========================================================================
 //  Implementation
 // ==========================================================================
 
 void timeManagerInit() {
+    _timePrefs.begin(TIME_PERSIST_NS, false);
+
+    // Restore the last-known time before SNTP starts so the clock is
+    // approximately right from the first frame.
+    uint64_t saved = _timePrefs.getULong64("epoch", 0);
+    if (saved >= TIME_EPOCH_SANE && time(nullptr) < (time_t)TIME_EPOCH_SANE) {
+        struct timeval tv = { (time_t)saved, 0 };
+        settimeofday(&tv, nullptr);
+        Serial.printf("[Time] Restored last-known epoch %llu (SNTP will refine)\n",
+                      (unsigned long long)saved);
+    }
+
+    sntp_set_time_sync_notification_cb([](struct timeval *) {
+        _sntpSyncedFlag = true;
+    });
     configTime(0, 0, "time.google.com", "time.cloudflare.com");
 
     // Apply stored timezone if available
@@ -99,8 +159,14 @@ void timeManagerDetectTimezone() {
         return;
     }
 
-    const bool wantTz      = (getTimezoneIANA().length() == 0);
-    const bool wantWeather = !getWeatherManual();
+    const bool wantTz = (getTimezoneIANA().length() == 0);
+    bool wantWeather  = !getWeatherManual();
+    if (wantWeather && getWeatherCity().length() > 0 &&
+        _timePrefs.getString("detSsid", "") == WiFi.SSID()) {
+        // Geo already resolved on this network -- reuse the stored location
+        // instead of re-running the blocking ip-api lookup every boot.
+        wantWeather = false;
+    }
     if (!wantTz && !wantWeather) {
         return;
     }
@@ -156,6 +222,7 @@ void timeManagerDetectTimezone() {
 
                 if (changed) {
                     saveSettings();
+                    _timePrefs.putString("detSsid", WiFi.SSID());
                     http.end();
                     return;
                 }
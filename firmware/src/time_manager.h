@@ -12,6 +12,11 @@ void timeManagerInit();
 // Returns true if NTP time has been synchronized.
 bool timeManagerSynced();
 
+// Persist the current epoch to NVS on a slow cadence (plus once right
+// after the first SNTP sync) so the next boot can restore a near-correct
+// clock before SNTP finishes.  Call from the network task loop.
+void timeManagerPersistTick();
+
 // Set POSIX TZ string and apply it. Also saves IANA name to NVS.
 void timeManagerSetTimezone(const String &ianaTz);
 
@@ -77,9 +77,27 @@ void timerUiDrawSet() {
     u8g2.drawStr((128 - u8g2.getStrWidth(hint)) / 2, 62, hint);
 
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
+// --------------------------------------------------------------------------
+//  Running screen with cached digit cells
+// --------------------------------------------------------------------------
+// The countdown redraws once per second but only one or two digits actually
+// change.  A pre-rotation copy of the composed screen is kept here; steady
+// updates blit just the changed digit cells into it (display_helpers digit
+// cache) and copy the frame back, so u8g2 renders the logisoso28 glyphs only
+// on the first draw.  The 180 deg rotate stays at draw time (flip mode can
+// change) and displayFlushDirty() still suppresses unchanged pages.
+
+#define TIMER_RUN_BASELINE 48
+
+static uint8_t _runFrame[1024];          // pre-rotation composed screen
+static bool    _runFrameValid = false;
+static bool    _runFrameStarted = false; // hint text the frame was built with
+static char    _runShown[9] = "";        // digits currently in _runFrame
+static int16_t _runCellX[8];             // column of each HH:MM:SS cell
+
 void timerUiDrawRunning(uint32_t remainSec, bool started) {
     uint8_t h = (uint8_t)(remainSec / 3600);
     uint8_t m = (uint8_t)((remainSec % 3600) / 60);
@@ -88,6 +106,23 @@ void timerUiDrawRunning(uint32_t remainSec, bool started) {
     char buf[9];
     snprintf(buf, sizeof(buf), "%02d:%02d:%02d", h, m, s);
 
+    digitCellsPrepare(TIMER_RUN_BASELINE);  // no-op once built (trashes buffer on rebuild)
+
+    if (_runFrameValid && _runFrameStarted == started) {
+        // Steady state: patch only the digit cells that changed.
+        char one[2] = { '\0', '\0' };
+        for (uint8_t i = 0; i < 8; i++) {
+            if (buf[i] == _runShown[i]) continue;
+            one[0] = buf[i];
+            digitCellsBlit(TIMER_RUN_BASELINE, _runFrame, one, _runCellX[i]);
+        }
+        memcpy(_runShown, buf, sizeof(_runShown));
+        memcpy(u8g2.getBufferPtr(), _runFrame, sizeof(_runFrame));
+        rotateBuffer180();
+        displayFlushDirty();
+        return;
+    }
+
     u8g2.clearBuffer();
 
     u8g2.setFont(u8g2_font_6x13_tr);
@@ -96,14 +131,27 @@ void timerUiDrawRunning(uint32_t remainSec, bool started) {
 
     u8g2.setFont(u8g2_font_logisoso28_tn);
     uint8_t tw = u8g2.getStrWidth(buf);
-    u8g2.drawStr((128 - tw) / 2, 48, buf);
+    int16_t tx = (128 - tw) / 2;
+    u8g2.drawStr(tx, TIMER_RUN_BASELINE, buf);
+
+    // Record the cell columns for the partial-update path above.
+    int16_t x = tx;
+    for (uint8_t i = 0; i < 8; i++) {
+        _runCellX[i] = x;
+        x += digitCellsCharWidth(TIMER_RUN_BASELINE, buf[i]);
+    }
 
     u8g2.setFont(u8g2_font_6x13_tr);
     const char *hint = started ? "TAP to cancel" : "TAP to start";
     u8g2.drawStr((128 - u8g2.getStrWidth(hint)) / 2, 62, hint);
 
+    memcpy(_runFrame, u8g2.getBufferPtr(), sizeof(_runFrame));
+    memcpy(_runShown, buf, sizeof(_runShown));
+    _runFrameStarted = started;
+    _runFrameValid   = true;
+
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
 }
 
 TimerAction timerUiOnGestureSet(TimerGestureType g) {
@@ -181,3 +229,12 @@ bool     timerUiGetDone()      { return _done; }
 
 void timerUiSetStarted(bool started) { _started = started; }
 void timerUiSetLastTickMs(unsigned long ms) { _lastTickMs = ms; }
+
+void timerUiRestoreRunning(uint32_t remainSec, unsigned long nowMs) {
+    _remainSec      = remainSec;
+    _lastTickMs     = nowMs;
+    _lastDisplaySec = UINT32_MAX;
+    _started        = true;
+    _done           = false;
+    _runFrameValid  = false;  // first draw recomposes the screen
+}
@@ -52,4 +52,7 @@ bool     timerUiGetDone();
 void timerUiSetStarted(bool started);
 void timerUiSetLastTickMs(unsigned long ms);
 
+// Re-arm a running countdown after a reboot (session snapshot restore).
+void timerUiRestoreRunning(uint32_t remainSec, unsigned long nowMs);
+
 #endif // TIMER_UI_H
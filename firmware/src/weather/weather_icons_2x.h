@@ -0,0 +1,246 @@
+// ==========================================================================
+//  QBIT -- Pre-scaled 2x weather icons (U8G2 XBM format, LSB-first)
+//
+//  GENERATED by tools/scale_weather_icons.py from weather_icons.h --
+//  do not edit by hand; edit the 1x arrays and rerun the tool.
+//
+//  Height is always 32. Usage: u8g2.drawXBM(x, y, ico.width, 32, ico.bits)
+// ==========================================================================
+#ifndef WEATHER_ICONS_2X_H
+#define WEATHER_ICONS_2X_H
+
+#include "weather_icons.h"
+
+// Clear (30×32)
+static const uint8_t WEATHER_ICON_CLEAR_2X[] PROGMEM = {
+    0x00,0xC0,0x00,0x00,  // row 0
+    0x00,0xC0,0x00,0x00,  // row 1
+    0x30,0xC0,0x00,0x03,  // row 2
+    0x30,0xC0,0x00,0x03,  // row 3
+    0xC0,0x00,0xC0,0x00,  // row 4
+    0xC0,0x00,0xC0,0x00,  // row 5
+    0x00,0xF0,0x03,0x00,  // row 6
+    0x00,0xF0,0x03,0x00,  // row 7
+    0x03,0x0F,0x3C,0x30,  // row 8
+    0x03,0x0F,0x3C,0x30,  // row 9
+    0x0C,0x03,0x30,0x0C,  // row 10
+    0x0C,0x03,0x30,0x0C,  // row 11
+    0xC0,0x00,0xC0,0x00,  // row 12
+    0xC0,0x00,0xC0,0x00,  // row 13
+    0xC0,0x00,0xC0,0x00,  // row 14
+    0xC0,0x00,0xC0,0x00,  // row 15
+    0xC0,0x00,0xC0,0x00,  // row 16
+    0xC0,0x00,0xC0,0x00,  // row 17
+    0x0C,0x03,0x30,0x0C,  // row 18
+    0x0C,0x03,0x30,0x0C,  // row 19
+    0x03,0x0F,0x3C,0x30,  // row 20
+    0x03,0x0F,0x3C,0x30,  // row 21
+    0x00,0xF0,0x03,0x00,  // row 22
+    0x00,0xF0,0x03,0x00,  // row 23
+    0xC0,0x00,0xC0,0x00,  // row 24
+    0xC0,0x00,0xC0,0x00,  // row 25
+    0x30,0xC0,0x00,0x03,  // row 26
+    0x30,0xC0,0x00,0x03,  // row 27
+    0x00,0xC0,0x00,0x00,  // row 28
+    0x00,0xC0,0x00,0x00,  // row 29
+    0x00,0x00,0x00,0x00,  // row 30
+    0x00,0x00,0x00,0x00,  // row 31
+};
+
+// Clouds (34×32)
+static const uint8_t WEATHER_ICON_CLOUDS_2X[] PROGMEM = {
+    0x00,0x00,0x30,0x00,0x00,  // row 0
+    0x00,0x00,0x30,0x00,0x00,  // row 1
+    0x00,0x30,0x00,0x30,0x00,  // row 2
+    0x00,0x30,0x00,0x30,0x00,  // row 3
+    0x00,0x00,0xFC,0x00,0x00,  // row 4
+    0x00,0x00,0xFC,0x00,0x00,  // row 5
+    0x00,0xC0,0x03,0x0F,0x00,  // row 6
+    0x00,0xC0,0x03,0x0F,0x00,  // row 7
+    0x00,0xC3,0x00,0x0C,0x03,  // row 8
+    0x00,0xC3,0x00,0x0C,0x03,  // row 9
+    0x00,0x30,0x00,0x30,0x00,  // row 10
+    0x00,0x30,0x00,0x30,0x00,  // row 11
+    0x00,0x30,0x00,0x30,0x00,  // row 12
+    0x00,0x30,0x00,0x30,0x00,  // row 13
+    0x00,0xFC,0x03,0x30,0x00,  // row 14
+    0x00,0xFC,0x03,0x30,0x00,  // row 15
+    0x00,0x03,0x0C,0x0C,0x03,  // row 16
+    0x00,0x03,0x0C,0x0C,0x03,  // row 17
+    0xC0,0x00,0x30,0x0F,0x00,  // row 18
+    0xC0,0x00,0x30,0x0F,0x00,  // row 19
+    0xF0,0x00,0xF0,0x00,0x00,  // row 20
+    0xF0,0x00,0xF0,0x00,0x00,  // row 21
+    0x3C,0x00,0xC0,0x3F,0x00,  // row 22
+    0x3C,0x00,0xC0,0x3F,0x00,  // row 23
+    0x03,0x00,0x00,0xF0,0x00,  // row 24
+    0x03,0x00,0x00,0xF0,0x00,  // row 25
+    0x03,0x00,0x00,0xC0,0x00,  // row 26
+    0x03,0x00,0x00,0xC0,0x00,  // row 27
+    0x03,0x00,0x00,0xC0,0x00,  // row 28
+    0x03,0x00,0x00,0xC0,0x00,  // row 29
+    0xFC,0xFF,0xFF,0x3F,0x00,  // row 30
+    0xFC,0xFF,0xFF,0x3F,0x00,  // row 31
+};
+
+// Rain (34×32)
+static const uint8_t WEATHER_ICON_RAIN_2X[] PROGMEM = {
+    0x00,0x00,0x00,0x00,0x00,  // row 0
+    0x00,0x00,0x00,0x00,0x00,  // row 1
+    0x00,0xFC,0x0F,0x00,0x00,  // row 2
+    0x00,0xFC,0x0F,0x00,0x00,  // row 3
+    0x00,0x03,0x30,0x00,0x00,  // row 4
+    0x00,0x03,0x30,0x00,0x00,  // row 5
+    0xC0,0x00,0xC0,0x00,0x00,  // row 6
+    0xC0,0x00,0xC0,0x00,0x00,  // row 7
+    0xF0,0x00,0x00,0x03,0x00,  // row 8
+    0xF0,0x00,0x00,0x03,0x00,  // row 9
+    0x0C,0x00,0x00,0x3F,0x00,  // row 10
+    0x0C,0x00,0x00,0x3F,0x00,  // row 11
+    0x03,0x00,0x00,0xC0,0x00,  // row 12
+    0x03,0x00,0x00,0xC0,0x00,  // row 13
+    0x03,0x00,0x00,0x00,0x03,  // row 14
+    0x03,0x00,0x00,0x00,0x03,  // row 15
+    0x0C,0x00,0x00,0x00,0x03,  // row 16
+    0x0C,0x00,0x00,0x00,0x03,  // row 17
+    0xF0,0xFF,0xFF,0xFF,0x00,  // row 18
+    0xF0,0xFF,0xFF,0xFF,0x00,  // row 19
+    0x00,0xC0,0xC0,0x00,0x00,  // row 20
+    0x00,0xC0,0xC0,0x00,0x00,  // row 21
+    0x30,0x30,0x30,0x30,0x00,  // row 22
+    0x30,0x30,0x30,0x30,0x00,  // row 23
+    0x0C,0x0C,0x03,0x0C,0x00,  // row 24
+    0x0C,0x0C,0x03,0x0C,0x00,  // row 25
+    0xC3,0xC0,0x30,0x03,0x00,  // row 26
+    0xC3,0xC0,0x30,0x03,0x00,  // row 27
+    0x30,0x30,0x0C,0x00,0x00,  // row 28
+    0x30,0x30,0x0C,0x00,0x00,  // row 29
+    0x00,0x00,0x03,0x00,0x00,  // row 30
+    0x00,0x00,0x03,0x00,0x00,  // row 31
+};
+
+// Storm (34×32)
+static const uint8_t WEATHER_ICON_STORM_2X[] PROGMEM = {
+    0x00,0x00,0x00,0x00,0x00,  // row 0
+    0x00,0x00,0x00,0x00,0x00,  // row 1
+    0x00,0xFC,0x0F,0x00,0x00,  // row 2
+    0x00,0xFC,0x0F,0x00,0x00,  // row 3
+    0x00,0x03,0x30,0x00,0x00,  // row 4
+    0x00,0x03,0x30,0x00,0x00,  // row 5
+    0xC0,0x00,0xC0,0x00,0x00,  // row 6
+    0xC0,0x00,0xC0,0x00,0x00,  // row 7
+    0xF0,0x00,0x00,0x03,0x00,  // row 8
+    0xF0,0x00,0x00,0x03,0x00,  // row 9
+    0x0C,0x00,0x00,0x3F,0x00,  // row 10
+    0x0C,0x00,0x00,0x3F,0x00,  // row 11
+    0x03,0x00,0x03,0xC0,0x00,  // row 12
+    0x03,0x00,0x03,0xC0,0x00,  // row 13
+    0x03,0xC0,0x00,0x00,0x03,  // row 14
+    0x03,0xC0,0x00,0x00,0x03,  // row 15
+    0x0C,0xF0,0x00,0x00,0x03,  // row 16
+    0x0C,0xF0,0x00,0x00,0x03,  // row 17
+    0x30,0x3C,0xF0,0xFF,0x00,  // row 18
+    0x30,0x3C,0xF0,0xFF,0x00,  // row 19
+    0x00,0xFF,0x03,0x00,0x00,  // row 20
+    0x00,0xFF,0x03,0x00,0x00,  // row 21
+    0x00,0xC0,0x03,0x00,0x00,  // row 22
+    0x00,0xC0,0x03,0x00,0x00,  // row 23
+    0x00,0xF0,0x00,0x00,0x00,  // row 24
+    0x00,0xF0,0x00,0x00,0x00,  // row 25
+    0x00,0x30,0x00,0x00,0x00,  // row 26
+    0x00,0x30,0x00,0x00,0x00,  // row 27
+    0x00,0x0C,0x00,0x00,0x00,  // row 28
+    0x00,0x0C,0x00,0x00,0x00,  // row 29
+    0x00,0x00,0x00,0x00,0x00,  // row 30
+    0x00,0x00,0x00,0x00,0x00,  // row 31
+};
+
+// Mist (30×32)
+static const uint8_t WEATHER_ICON_MIST_2X[] PROGMEM = {
+    0x00,0x00,0x00,0x00,  // row 0
+    0x00,0x00,0x00,0x00,  // row 1
+    0x00,0x00,0x00,0x00,  // row 2
+    0x00,0x00,0x00,0x00,  // row 3
+    0x00,0x00,0xF0,0x00,  // row 4
+    0x00,0x00,0xF0,0x00,  // row 5
+    0x00,0xF0,0x03,0x03,  // row 6
+    0x00,0xF0,0x03,0x03,  // row 7
+    0x00,0x0C,0x0C,0x0C,  // row 8
+    0x00,0x0C,0x0C,0x0C,  // row 9
+    0x00,0x0C,0x0C,0x0C,  // row 10
+    0x00,0x0C,0x0C,0x0C,  // row 11
+    0x00,0x00,0x0C,0x0C,  // row 12
+    0x00,0x00,0x0C,0x0C,  // row 13
+    0x00,0x00,0x03,0x03,  // row 14
+    0x00,0x00,0x03,0x03,  // row 15
+    0xFF,0xFF,0xF0,0x30,  // row 16
+    0xFF,0xFF,0xF0,0x30,  // row 17
+    0x00,0x00,0x00,0x00,  // row 18
+    0x00,0x00,0x00,0x00,  // row 19
+    0x33,0xCF,0x03,0x30,  // row 20
+    0x33,0xCF,0x03,0x30,  // row 21
+    0x00,0x00,0x3C,0x00,  // row 22
+    0x00,0x00,0x3C,0x00,  // row 23
+    0x00,0x00,0xC0,0x00,  // row 24
+    0x00,0x00,0xC0,0x00,  // row 25
+    0x00,0x00,0xC0,0x00,  // row 26
+    0x00,0x00,0xC0,0x00,  // row 27
+    0x00,0xC0,0x30,0x00,  // row 28
+    0x00,0xC0,0x30,0x00,  // row 29
+    0x00,0x00,0x0F,0x00,  // row 30
+    0x00,0x00,0x0F,0x00,  // row 31
+};
+
+// Snow (32×32)
+static const uint8_t WEATHER_ICON_SNOW_2X[] PROGMEM = {
+    0x00,0x00,0x00,0x00,  // row 0
+    0x00,0x00,0x00,0x00,  // row 1
+    0x00,0x00,0x00,0x00,  // row 2
+    0x00,0x00,0x00,0x00,  // row 3
+    0x00,0xC0,0xFF,0x00,  // row 4
+    0x00,0xC0,0xFF,0x00,  // row 5
+    0x00,0x00,0x00,0x03,  // row 6
+    0x00,0x00,0x00,0x03,  // row 7
+    0x00,0xFC,0x0F,0x3F,  // row 8
+    0x00,0xFC,0x0F,0x3F,  // row 9
+    0x00,0x03,0x30,0xF0,  // row 10
+    0x00,0x03,0x30,0xF0,  // row 11
+    0x00,0x03,0xF0,0xC3,  // row 12
+    0x00,0x03,0xF0,0xC3,  // row 13
+    0xF0,0x00,0x00,0xCF,  // row 14
+    0xF0,0x00,0x00,0xCF,  // row 15
+    0x0C,0x00,0x00,0xFC,  // row 16
+    0x0C,0x00,0x00,0xFC,  // row 17
+    0x0C,0x00,0x00,0x3C,  // row 18
+    0x0C,0x00,0x00,0x3C,  // row 19
+    0x0C,0x00,0x00,0x0F,  // row 20
+    0x0C,0x00,0x00,0x0F,  // row 21
+    0x3C,0x00,0xC0,0x03,  // row 22
+    0x3C,0x00,0xC0,0x03,  // row 23
+    0xF0,0xFF,0xFF,0x00,  // row 24
+    0xF0,0xFF,0xFF,0x00,  // row 25
+    0x00,0x00,0x00,0x00,  // row 26
+    0x00,0x00,0x00,0x00,  // row 27
+    0x00,0x00,0x00,0x00,  // row 28
+    0x00,0x00,0x00,0x00,  // row 29
+    0x00,0x00,0x00,0x00,  // row 30
+    0x00,0x00,0x00,0x00,  // row 31
+};
+
+// --------------------------------------------------------------------------
+//  Map WMO weather code → 2x icon + width (same mapping as getWeatherIcon)
+// --------------------------------------------------------------------------
+inline WeatherIconInfo getWeatherIcon2x(uint8_t wmoCode) {
+    if (wmoCode <= 1)                           return { WEATHER_ICON_CLEAR_2X,  30 };
+    if (wmoCode <= 3)                           return { WEATHER_ICON_CLOUDS_2X, 34 };
+    if (wmoCode == 45 || wmoCode == 48)         return { WEATHER_ICON_MIST_2X,   30 };
+    if ((wmoCode >= 51 && wmoCode <= 67) ||
+        (wmoCode >= 80 && wmoCode <= 82))       return { WEATHER_ICON_RAIN_2X,   34 };
+    if ((wmoCode >= 71 && wmoCode <= 77) ||
+        wmoCode == 85 || wmoCode == 86)         return { WEATHER_ICON_SNOW_2X,   32 };
+    if (wmoCode == 95 || wmoCode == 96 ||
+        wmoCode == 99)                          return { WEATHER_ICON_STORM_2X,  34 };
+    return { WEATHER_ICON_CLOUDS_2X, 34 };
+}
+
+#endif // WEATHER_ICONS_2X_H
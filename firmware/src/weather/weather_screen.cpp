@@ -16,6 +16,7 @@
 // ==========================================================================
 #include "weather_screen.h"
 #include "weather_icons.h"
+#include "weather_icons_2x.h"
 #include "../settings.h"
 #include "../display_helpers.h"
 #include "../app_state.h"
@@ -39,30 +40,27 @@ extern void rotateBuffer180();
 // After a stale fetch fails, wait before retrying (avoids hammering APIs / Wi-Fi).
 #define WEATHER_RETRY_INTERVAL_MS  (60UL * 1000UL)        // 1 minute
 #define WEATHER_HTTP_TIMEOUT       8000                   // 8 s per request
+// Background prefetch (network task) refreshes this long before nominal expiry,
+// so entering WEATHER_SCREEN only ever reads warm cached values.
+#define WEATHER_PREFETCH_LEAD_MS   (5UL * 60UL * 1000UL)  // 5 minutes
 
 // ==========================================================================
 //  Cached weather data
 // ==========================================================================
 static unsigned long _lastFetchMs     = 0;
 static bool          _hasData         = false;
+// Set while a refresh is running. The persistent HTTPClients above are not
+// re-entrant, and both the display task (enter/idle tick) and the network task
+// (background prefetch) can trigger a refresh -- the second caller skips.
+static volatile bool _fetchBusy       = false;
 
 static float    _temperature          = 0.0f;
 static uint8_t  _humidity             = 0;
 static uint8_t  _wmoCode              = 0;
 static int16_t  _aqi                  = -1;   // European AQI; -1 = unavailable
-
-static void drawXbm2x(int x, int y, uint8_t w, uint8_t h, const uint8_t *bits) {
-    uint8_t bytesPerRow = (w + 7) >> 3;
-    for (uint8_t py = 0; py < h; py++) {
-        for (uint8_t px = 0; px < w; px++) {
-            uint16_t idx = (uint16_t)py * bytesPerRow + (px >> 3);
-            uint8_t b = pgm_read_byte(bits + idx);
-            if (b & (1U << (px & 7))) {
-                u8g2.drawBox(x + (px * 2), y + (py * 2), 2, 2);
-            }
-        }
-    }
-}
+// Set when a refresh lands values different from what is on screen; lets the
+// hourly idle-tick refresh skip the repaint when nothing actually changed.
+static bool     _dataDirty            = false;
 
 // Map European AQI score to 1..5 quality level (5 = worst).
 static uint8_t getAqiLevel(int16_t aqi) {
@@ -117,70 +115,125 @@ static void drawAqiIcon(int x, int y, int16_t aqi) {
 // ==========================================================================
 //  HTTP GET helper (returns body string or empty on error)
 // ==========================================================================
-static String httpGet(const char *url) {
-    HTTPClient http;
+// Clients are persistent so keep-alive (setReuse) can hold the TCP socket
+// open between the paired weather/AQI fetches and across hourly refreshes;
+// HTTPClient reconnects transparently when the server has dropped it.
+static HTTPClient _weatherHttp;
+static HTTPClient _aqiHttp;
+
+static String httpGet(HTTPClient &http, const char *url) {
     http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
     http.setTimeout(WEATHER_HTTP_TIMEOUT);
-    http.begin(url);
+    http.setReuse(true);
+    if (!http.begin(url)) return String();
     int code = http.GET();
     String body;
     if (code >= 200 && code < 300) {
         body = http.getString();
     }
-    http.end();
+    http.end();   // with reuse on, this keeps the socket for the next call
     return body;
 }
 
 // ==========================================================================
 //  Fetch fresh weather + AQI from Open-Meteo
 // ==========================================================================
-static bool fetchWeatherData() {
-    float lat = getWeatherLat();
-    float lon = getWeatherLon();
+//  The two requests go to different hosts, so on a cold cache the old
+//  sequential code blocked WEATHER_SCREEN entry for up to two full
+//  timeouts.  The AQI request now runs on a short-lived helper task while
+//  the display task does the weather request, and both are joined before
+//  returning -- worst case is one timeout, typical case is one RTT.
+//  Deserialization uses a filter so only the rendered fields are parsed.
 
-    // --- Weather API ---
-    char weatherUrl[256];
-    snprintf(weatherUrl, sizeof(weatherUrl),
-        "http://api.open-meteo.com/v1/forecast"
-        "?latitude=%.4f&longitude=%.4f"
-        "&current=temperature_2m,relative_humidity_2m,weather_code"
-        "&forecast_days=1",
-        lat, lon);
-
-    String weatherBody = httpGet(weatherUrl);
-    if (weatherBody.length() == 0) return false;
-
-    {
-        JsonDocument doc;
-        DeserializationError err = deserializeJson(doc, weatherBody);
-        if (err) return false;
-        JsonObject cur = doc["current"];
-        if (cur.isNull()) return false;
-        _temperature = cur["temperature_2m"].as<float>();
-        _humidity    = (uint8_t)cur["relative_humidity_2m"].as<int>();
-        _wmoCode     = (uint8_t)cur["weather_code"].as<int>();
-    }
+static SemaphoreHandle_t _aqiDoneSem  = nullptr;
+static volatile bool     _aqiInFlight = false;
 
+static void fetchAqi() {
     _aqi = -1;
     char aqiUrl[256];
     snprintf(aqiUrl, sizeof(aqiUrl),
         "http://air-quality-api.open-meteo.com/v1/air-quality"
         "?latitude=%.4f&longitude=%.4f"
         "&current=european_aqi",
-        lat, lon);
+        getWeatherLat(), getWeatherLon());
 
-    String aqiBody = httpGet(aqiUrl);
+    String aqiBody = httpGet(_aqiHttp, aqiUrl);
     if (aqiBody.length() > 0) {
+        JsonDocument filter;
+        filter["current"]["european_aqi"] = true;
         JsonDocument doc;
-        if (!deserializeJson(doc, aqiBody)) {
+        if (!deserializeJson(doc, aqiBody, DeserializationOption::Filter(filter))) {
             JsonObject cur = doc["current"];
             if (!cur.isNull() && cur["european_aqi"].is<int>()) {
                 _aqi = (int16_t)cur["european_aqi"].as<int>();
             }
         }
     }
+}
+
+static void aqiFetchTask(void *param) {
+    (void)param;
+    fetchAqi();
+    _aqiInFlight = false;
+    xSemaphoreGive(_aqiDoneSem);
+    vTaskDelete(nullptr);
+}
+
+static bool fetchWeatherData() {
+    float lat = getWeatherLat();
+    float lon = getWeatherLon();
+
+    // Kick the AQI request off in parallel (skip if a previous attempt is
+    // somehow still in flight -- _aqiHttp is not re-entrant).
+    if (!_aqiDoneSem) _aqiDoneSem = xSemaphoreCreateBinary();
+    bool aqiParallel = false;
+    if (!_aqiInFlight) {
+        xSemaphoreTake(_aqiDoneSem, 0);   // clear a stale give
+        _aqiInFlight = true;
+        aqiParallel = xTaskCreate(aqiFetchTask, "aqiFetch", 4096,
+                                  nullptr, 1, nullptr) == pdPASS;
+        if (!aqiParallel) {
+            _aqiInFlight = false;
+            fetchAqi();   // no task slot: fall back to sequential
+        }
+    }
+
+    // --- Weather API (on the calling task, concurrent with AQI) ---
+    char weatherUrl[256];
+    snprintf(weatherUrl, sizeof(weatherUrl),
+        "http://api.open-meteo.com/v1/forecast"
+        "?latitude=%.4f&longitude=%.4f"
+        "&current=temperature_2m,relative_humidity_2m,weather_code"
+        "&forecast_days=1",
+        lat, lon);
+
+    bool ok = false;
+    String weatherBody = httpGet(_weatherHttp, weatherUrl);
+    if (weatherBody.length() > 0) {
+        JsonDocument filter;
+        filter["current"]["temperature_2m"]       = true;
+        filter["current"]["relative_humidity_2m"] = true;
+        filter["current"]["weather_code"]         = true;
+        JsonDocument doc;
+        DeserializationError err =
+            deserializeJson(doc, weatherBody, DeserializationOption::Filter(filter));
+        if (!err) {
+            JsonObject cur = doc["current"];
+            if (!cur.isNull()) {
+                _temperature = cur["temperature_2m"].as<float>();
+                _humidity    = (uint8_t)cur["relative_humidity_2m"].as<int>();
+                _wmoCode     = (uint8_t)cur["weather_code"].as<int>();
+                ok = true;
+            }
+        }
+    }
+
+    // Join the AQI task before touching/reporting the cache
+    if (aqiParallel) {
+        xSemaphoreTake(_aqiDoneSem, pdMS_TO_TICKS(WEATHER_HTTP_TIMEOUT + 2000));
+    }
 
-    return true;
+    return ok;
 }
 
 // ==========================================================================
@@ -235,12 +288,11 @@ void weatherScreenDraw() {
     u8g2.drawStr((128 - locW) / 2, 10, title.c_str());
 
     // --- Condition icon ---
-    WeatherIconInfo ico = getWeatherIcon(_wmoCode);
-
-    // Left column: enlarged condition icon
-    uint8_t iconW = ico.width * 2;
-    uint8_t liX = (leftW - iconW) / 2;
-    drawXbm2x(liX, yIconMain, ico.width, 16, ico.bits);
+    // Left column: pre-scaled 2x condition icon (straight XBM blit; the old
+    // per-pixel drawBox scaler cost ~500 drawBox calls per repaint).
+    WeatherIconInfo ico = getWeatherIcon2x(_wmoCode);
+    uint8_t liX = (leftW - ico.width) / 2;
+    u8g2.drawXBM(liX, yIconMain, ico.width, 32, ico.bits);
 
     // --- Right column (AQI + Humidity) ---
     drawAqiIcon(rightIconX, yAqiIcon, _aqi);
@@ -288,18 +340,47 @@ void weatherScreenDraw() {
     u8g2.setBitmapMode(0);
 
     rotateBuffer180();
-    u8g2.sendBuffer();
+    displayFlushDirty();
+    _dataDirty = false;
 }
 
 bool weatherScreenRefreshNow() {
+    if (_fetchBusy)
+        return false;  // another task is already refreshing
+    _fetchBusy = true;
+    float   prevTemp = _temperature;
+    uint8_t prevHum  = _humidity;
+    uint8_t prevWmo  = _wmoCode;
+    int16_t prevAqi  = _aqi;
+    bool    prevHad  = _hasData;
     bool ok = fetchWeatherData();
     if (ok) {
         _hasData = true;
         _lastFetchMs = millis();
+        if (!prevHad || prevTemp != _temperature || prevHum != _humidity ||
+            prevWmo != _wmoCode || prevAqi != _aqi) {
+            _dataDirty = true;
+        }
     }
+    _fetchBusy = false;
     return ok;
 }
 
+// ==========================================================================
+//  Background prefetch (called from the network task)
+// ==========================================================================
+bool weatherScreenPrefetchIfDue() {
+    if (WiFi.status() != WL_CONNECTED)
+        return false;
+
+    unsigned long now = millis();
+    if (_hasData &&
+        (unsigned long)(now - _lastFetchMs) < WEATHER_CACHE_MS - WEATHER_PREFETCH_LEAD_MS) {
+        return false;  // still fresh enough
+    }
+    return weatherScreenRefreshNow();
+}
+
 // ==========================================================================
 //  While on WEATHER_SCREEN: hourly background refresh (no full-screen "Loading")
 // ==========================================================================
@@ -320,7 +401,9 @@ void weatherScreenIdleTick() {
     }
     s_lastAttemptMs = now;
 
-    if (weatherScreenRefreshNow())
+    // Repaint only when the refresh actually changed a rendered value --
+    // hourly fetches usually return the same rounded temperature/AQI.
+    if (weatherScreenRefreshNow() && _dataDirty)
         weatherScreenDraw();
 }
 
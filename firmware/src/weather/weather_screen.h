@@ -22,6 +22,12 @@ void weatherScreenDraw();
 // Returns true if fresh data was fetched successfully.
 bool weatherScreenRefreshNow();
 
+// Call periodically from the network task: refreshes the cache in the
+// background shortly before it expires, so WEATHER_SCREEN entry always reads
+// warm values. No-op while WiFi is down or the cache is still fresh.
+// Returns true if a fetch ran and succeeded.
+bool weatherScreenPrefetchIfDue();
+
 // Drop cached readings (e.g. after setWeatherLocation from NVS).
 void weatherScreenInvalidateCache();
 
@@ -0,0 +1,272 @@
+// ==========================================================================
+//  QBIT -- render core host tests + benchmarks (pio test -e native)
+// ==========================================================================
+// Exercises include/render_core.h (frame transpose, 180 deg rotate, v2 RLE
+// decode) against naive per-pixel reference implementations, then reports
+// ns/frame and heap bytes allocated for each hot path so render-path
+// optimizations are regression-tested instead of anecdotal.
+
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <new>
+
+#include "render_core.h"
+
+// ---------------------------------------------------------------------------
+// Heap accounting -- the render core must never allocate
+// ---------------------------------------------------------------------------
+
+static size_t g_bytesAllocated = 0;
+
+void *operator new(size_t sz) {
+  g_bytesAllocated += sz;
+  return malloc(sz);
+}
+void *operator new[](size_t sz) {
+  g_bytesAllocated += sz;
+  return malloc(sz);
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// ---------------------------------------------------------------------------
+// Reference pixel accessors (naive, obviously-correct layouts)
+// ---------------------------------------------------------------------------
+
+// qgif: row-major, MSB-first
+static int qgifPixel(const uint8_t *frame, int x, int y) {
+  return (frame[y * 16 + x / 8] >> (7 - (x & 7))) & 1;
+}
+
+// SSD1306: page-major
+static int pagePixel(const uint8_t *buf, int x, int y) {
+  return (buf[(y / 8) * 128 + x] >> (y & 7)) & 1;
+}
+
+// Deterministic pseudo-random fill (xorshift32)
+static void fillRandom(uint8_t *buf, size_t len, uint32_t seed) {
+  uint32_t s = seed ? seed : 1;
+  for (size_t i = 0; i < len; i++) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    buf[i] = (uint8_t)s;
+  }
+}
+
+static uint8_t g_frame[QGIF_FRAME_SIZE];
+static uint8_t g_pages[QGIF_FRAME_SIZE];
+static uint8_t g_ref[QGIF_FRAME_SIZE];
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Frame transpose
+// ---------------------------------------------------------------------------
+
+static void test_transpose_matches_reference(void) {
+  fillRandom(g_frame, sizeof(g_frame), 0xC0FFEE);
+  renderCoreFrameToPages(g_frame, g_pages, 0xFF, false);
+  for (int y = 0; y < QGIF_FRAME_HEIGHT; y++)
+    for (int x = 0; x < QGIF_FRAME_WIDTH; x++)
+      // inv=0xFF: qgif 0=lit becomes a set page bit
+      TEST_ASSERT_EQUAL_INT(!qgifPixel(g_frame, x, y), pagePixel(g_pages, x, y));
+}
+
+static void test_transpose_negative_polarity(void) {
+  fillRandom(g_frame, sizeof(g_frame), 0xBEEF);
+  renderCoreFrameToPages(g_frame, g_pages, 0x00, false);
+  for (int y = 0; y < QGIF_FRAME_HEIGHT; y++)
+    for (int x = 0; x < QGIF_FRAME_WIDTH; x++)
+      TEST_ASSERT_EQUAL_INT(qgifPixel(g_frame, x, y), pagePixel(g_pages, x, y));
+}
+
+static void test_transpose_flip(void) {
+  fillRandom(g_frame, sizeof(g_frame), 0xF00D);
+  renderCoreFrameToPages(g_frame, g_ref, 0xFF, false);
+  renderCoreFrameToPages(g_frame, g_pages, 0xFF, true);
+  for (int y = 0; y < QGIF_FRAME_HEIGHT; y++)
+    for (int x = 0; x < QGIF_FRAME_WIDTH; x++)
+      TEST_ASSERT_EQUAL_INT(pagePixel(g_ref, x, y),
+                            pagePixel(g_pages, 127 - x, 63 - y));
+}
+
+// ---------------------------------------------------------------------------
+// 180 deg rotate
+// ---------------------------------------------------------------------------
+
+static void test_rotate180_matches_reference(void) {
+  fillRandom(g_pages, sizeof(g_pages), 0xDEAD);
+  memcpy(g_ref, g_pages, sizeof(g_ref));
+  renderCoreRotate180(g_pages, QGIF_FRAME_SIZE);
+  for (int y = 0; y < QGIF_FRAME_HEIGHT; y++)
+    for (int x = 0; x < QGIF_FRAME_WIDTH; x++)
+      TEST_ASSERT_EQUAL_INT(pagePixel(g_ref, x, y),
+                            pagePixel(g_pages, 127 - x, 63 - y));
+}
+
+static void test_rotate180_involution(void) {
+  fillRandom(g_pages, sizeof(g_pages), 0xCAFE);
+  memcpy(g_ref, g_pages, sizeof(g_ref));
+  renderCoreRotate180(g_pages, QGIF_FRAME_SIZE);
+  renderCoreRotate180(g_pages, QGIF_FRAME_SIZE);
+  TEST_ASSERT_EQUAL_MEMORY(g_ref, g_pages, QGIF_FRAME_SIZE);
+}
+
+// ---------------------------------------------------------------------------
+// v2 RLE decode
+// ---------------------------------------------------------------------------
+
+// Build an RLE payload for a frame filled with 'value' (7x129 + 1x121 runs)
+static uint16_t buildFillPayload(uint8_t *payload, uint8_t value) {
+  uint16_t p = 0;
+  for (int i = 0; i < 7; i++) {  // 7 x 129 bytes
+    payload[p++] = 0xFF;         // (0x7F)+2 = 129 repeats
+    payload[p++] = value;
+  }
+  payload[p++] = 0x80 | (121 - 2);  // remaining 121 bytes
+  payload[p++] = value;
+  return p;
+}
+
+static void test_rle_keyframe_fill(void) {
+  uint8_t payload[64];
+  uint16_t plen = buildFillPayload(payload, 0xAA);
+
+  QgifRleState st;
+  qgifRleInit(&st);
+  TEST_ASSERT_TRUE(qgifRleChunk(&st, payload, plen, g_frame, false));
+  TEST_ASSERT_TRUE(qgifRleComplete(&st));
+  memset(g_ref, 0xAA, sizeof(g_ref));
+  TEST_ASSERT_EQUAL_MEMORY(g_ref, g_frame, QGIF_FRAME_SIZE);
+}
+
+static void test_rle_delta_xor(void) {
+  uint8_t payload[64];
+  uint16_t plen = buildFillPayload(payload, 0xAA);
+
+  memset(g_frame, 0x55, sizeof(g_frame));  // previous frame
+  QgifRleState st;
+  qgifRleInit(&st);
+  TEST_ASSERT_TRUE(qgifRleChunk(&st, payload, plen, g_frame, true));
+  TEST_ASSERT_TRUE(qgifRleComplete(&st));
+  memset(g_ref, 0xFF, sizeof(g_ref));  // 0x55 ^ 0xAA
+  TEST_ASSERT_EQUAL_MEMORY(g_ref, g_frame, QGIF_FRAME_SIZE);
+}
+
+static void test_rle_byte_at_a_time(void) {
+  // Same payload fed one byte per chunk must decode identically
+  uint8_t payload[64];
+  uint16_t plen = buildFillPayload(payload, 0x3C);
+
+  QgifRleState st;
+  qgifRleInit(&st);
+  for (uint16_t i = 0; i < plen; i++)
+    TEST_ASSERT_TRUE(qgifRleChunk(&st, payload + i, 1, g_frame, false));
+  TEST_ASSERT_TRUE(qgifRleComplete(&st));
+  memset(g_ref, 0x3C, sizeof(g_ref));
+  TEST_ASSERT_EQUAL_MEMORY(g_ref, g_frame, QGIF_FRAME_SIZE);
+}
+
+static void test_rle_literals_and_overrun(void) {
+  // 4 literal bytes
+  const uint8_t lit[] = { 0x03, 0x11, 0x22, 0x33, 0x44 };
+  QgifRleState st;
+  qgifRleInit(&st);
+  TEST_ASSERT_TRUE(qgifRleChunk(&st, lit, sizeof(lit), g_frame, false));
+  TEST_ASSERT_FALSE(qgifRleComplete(&st));  // only 4 of 1024 bytes produced
+  TEST_ASSERT_EQUAL_UINT8(0x11, g_frame[0]);
+  TEST_ASSERT_EQUAL_UINT8(0x44, g_frame[3]);
+
+  // A stream producing more than one frame must be rejected
+  uint8_t payload[64];
+  uint16_t plen = buildFillPayload(payload, 0xAA);
+  qgifRleInit(&st);
+  TEST_ASSERT_TRUE(qgifRleChunk(&st, payload, plen, g_frame, false));
+  TEST_ASSERT_FALSE(qgifRleChunk(&st, payload, plen, g_frame, false));
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks -- ns per operation + heap bytes allocated
+// ---------------------------------------------------------------------------
+
+static uint64_t nowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static volatile uint8_t g_sink;  // defeat dead-code elimination
+
+static void test_benchmark_report(void) {
+  const int iters = 20000;
+  char msg[128];
+
+  fillRandom(g_frame, sizeof(g_frame), 0xB16B00B5);
+
+  size_t   allocBefore = g_bytesAllocated;
+  uint64_t t0 = nowNs();
+  for (int i = 0; i < iters; i++) {
+    renderCoreFrameToPages(g_frame, g_pages, 0xFF, (i & 1) != 0);
+    g_sink = g_pages[i & 1023];
+  }
+  uint64_t transposeNs = (nowNs() - t0) / iters;
+
+  t0 = nowNs();
+  for (int i = 0; i < iters; i++) {
+    renderCoreRotate180(g_pages, QGIF_FRAME_SIZE);
+    g_sink = g_pages[i & 1023];
+  }
+  uint64_t rotateNs = (nowNs() - t0) / iters;
+
+  uint8_t payload[64];
+  uint16_t plen = buildFillPayload(payload, 0xAA);
+  t0 = nowNs();
+  for (int i = 0; i < iters; i++) {
+    QgifRleState st;
+    qgifRleInit(&st);
+    qgifRleChunk(&st, payload, plen, g_frame, (i & 1) != 0);
+    g_sink = g_frame[i & 1023];
+  }
+  uint64_t rleNs = (nowNs() - t0) / iters;
+  size_t allocated = g_bytesAllocated - allocBefore;
+
+  snprintf(msg, sizeof(msg), "transpose %llu ns/frame",
+           (unsigned long long)transposeNs);
+  TEST_MESSAGE(msg);
+  snprintf(msg, sizeof(msg), "rotate180 %llu ns/frame",
+           (unsigned long long)rotateNs);
+  TEST_MESSAGE(msg);
+  snprintf(msg, sizeof(msg), "rle decode %llu ns/frame",
+           (unsigned long long)rleNs);
+  TEST_MESSAGE(msg);
+  snprintf(msg, sizeof(msg), "heap allocated %zu bytes", allocated);
+  TEST_MESSAGE(msg);
+
+  // The render core is allocation-free by design; fail loudly if that changes
+  TEST_ASSERT_EQUAL_UINT(0, (unsigned)allocated);
+}
+
+int main(int argc, char **argv) {
+  (void)argc;
+  (void)argv;
+  UNITY_BEGIN();
+  RUN_TEST(test_transpose_matches_reference);
+  RUN_TEST(test_transpose_negative_polarity);
+  RUN_TEST(test_transpose_flip);
+  RUN_TEST(test_rotate180_matches_reference);
+  RUN_TEST(test_rotate180_involution);
+  RUN_TEST(test_rle_keyframe_fill);
+  RUN_TEST(test_rle_delta_xor);
+  RUN_TEST(test_rle_byte_at_a_time);
+  RUN_TEST(test_rle_literals_and_overrun);
+  RUN_TEST(test_benchmark_report);
+  return UNITY_END();
+}
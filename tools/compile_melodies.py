@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""
+Compile the RTTTL melody strings in firmware/src/melodies.h into packed
+(frequency, duration) note arrays, written to firmware/src/melodies_compiled.h.
+
+The firmware's melody player (firmware/src/melody_player.cpp) indexes the
+compiled arrays directly, so note transitions at play time are O(1) with no
+string parsing -- RTTTL stays the human-editable source of truth here.
+
+Run after editing melodies.h and commit the regenerated header:
+  python3 tools/compile_melodies.py
+"""
+
+import os
+import re
+import sys
+
+NOTE_SEMITONE = {
+    "c": 0, "c#": 1, "d": 2, "d#": 3, "e": 4, "f": 5,
+    "f#": 6, "g": 7, "g#": 8, "a": 9, "a#": 10, "b": 11,
+}
+
+
+def note_freq(name, octave):
+    """Equal-temperament frequency, rounded to whole Hz (a4 = 440)."""
+    midi = (octave + 1) * 12 + NOTE_SEMITONE[name]
+    return round(440.0 * 2.0 ** ((midi - 69) / 12.0))
+
+
+def parse_rtttl(text):
+    """Return list of (freq_hz, duration_ms); freq 0 is a rest."""
+    name, defaults, notes = text.split(":")
+    d, o, b = 4, 6, 63
+    for part in defaults.split(","):
+        k, v = part.split("=")
+        if k.strip() == "d":
+            d = int(v)
+        elif k.strip() == "o":
+            o = int(v)
+        elif k.strip() == "b":
+            b = int(v)
+    whole_ms = 4 * 60000.0 / b  # a whole note spans four beats
+
+    out = []
+    for tok in notes.split(","):
+        m = re.fullmatch(r"(\d*)([a-gp]#?)(\.?)(\d*)(\.?)", tok.strip().lower())
+        if not m:
+            raise ValueError("bad RTTTL note %r in %s" % (tok, name))
+        dur = int(m.group(1)) if m.group(1) else d
+        ms = whole_ms / dur
+        if m.group(3) or m.group(5):  # dotted (either position is seen in the wild)
+            ms *= 1.5
+        octave = int(m.group(4)) if m.group(4) else o
+        freq = 0 if m.group(2) == "p" else note_freq(m.group(2), octave)
+        out.append((freq, round(ms)))
+    return out
+
+
+def extract_melodies(header_text):
+    """Yield (identifier, rtttl_string) from melodies.h, in file order."""
+    pat = re.compile(
+        r"static const char (\w+)\[\]\s*=\s*((?:\"[^\"]*\"\s*)+);", re.S)
+    for m in pat.finditer(header_text):
+        literal = "".join(re.findall(r"\"([^\"]*)\"", m.group(2)))
+        yield m.group(1), literal
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    src = os.path.join(root, "firmware", "src", "melodies.h")
+    dst = os.path.join(root, "firmware", "src", "melodies_compiled.h")
+
+    with open(src) as f:
+        melodies = list(extract_melodies(f.read()))
+    if not melodies:
+        sys.exit("no melodies found in %s" % src)
+
+    lines = [
+        "// ==========================================================================",
+        "//  QBIT -- Precompiled melodies (generated -- do not edit)",
+        "// ==========================================================================",
+        "// Generated from the RTTTL strings in melodies.h by",
+        "// tools/compile_melodies.py.  Edit melodies.h and re-run the script.",
+        "#ifndef MELODIES_COMPILED_H",
+        "#define MELODIES_COMPILED_H",
+        "",
+        "#include \"melody_player.h\"",
+        "",
+    ]
+    for ident, rtttl in melodies:
+        notes = parse_rtttl(rtttl)
+        lines.append("// %s" % rtttl.split(":")[0])
+        lines.append("static const MelodyNote %s_NOTES[] PROGMEM = {" % ident)
+        lines.append("    " + " ".join("{%u, %u}," % n for n in notes))
+        lines.append("};")
+        lines.append("static const Melody %s = {%s_NOTES, %u};"
+                     % (ident, ident, len(notes)))
+        lines.append("")
+    lines.append("#endif // MELODIES_COMPILED_H")
+
+    with open(dst, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print("wrote %s (%d melodies)" % (dst, len(melodies)))
+
+
+if __name__ == "__main__":
+    main()
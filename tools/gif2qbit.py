@@ -2,19 +2,31 @@
 """
 gif2qbit.py -- Convert GIF animations to QBIT .qgif binary format.
 
-Binary format (.qgif):
+Binary format (.qgif v1):
   [0]       uint8   frame_count
   [1..2]    uint16  width   (little-endian)
   [3..4]    uint16  height  (little-endian)
   [5..]     uint16  delays[frame_count]  (LE, milliseconds)
   [..]      uint8   frames[frame_count][1024]  (128x64 monochrome bitmap)
 
+Binary format (.qgif v2, --v2):
+  [0..1]    magic   'Q','2'
+  [2]       uint8   frame_count
+  [3..4]    uint16  width   (LE)
+  [5..6]    uint16  height  (LE)
+  [..]      uint16  delays[frame_count]  (LE, milliseconds)
+  then per frame:
+  [0]       uint8   flags  (bit0: XOR delta vs previous frame, bit1: raw)
+  [1..2]    uint16  payload_len  (LE)
+  [3..]     payload (PackBits-like RLE, or raw 1024 bytes when bit1 set)
+
 Usage:
   python gif2qbit.py input.gif
   python gif2qbit.py input.gif -o output.qgif
   python gif2qbit.py *.gif
   python gif2qbit.py /path/to/gifs/
   python gif2qbit.py input.gif --threshold 100 --invert --scale stretch
+  python gif2qbit.py input.gif --v2
 """
 
 import argparse
@@ -91,8 +103,59 @@ def resize_frame(img, scale="fit"):
     return canvas
 
 
+QGIF2_FLAG_DELTA = 0x01
+QGIF2_FLAG_RAW   = 0x02
+
+
+def rle_encode(data):
+    """PackBits-like RLE matching the firmware decoder:
+    control 0x00-0x7F: copy the next c+1 bytes literally,
+    control 0x80-0xFF: repeat the next byte (c & 0x7F) + 2 times."""
+    out = bytearray()
+    i = 0
+    n = len(data)
+    lit_start = 0
+
+    def flush_literals(end):
+        s = lit_start
+        while s < end:
+            chunk = min(128, end - s)
+            out.append(chunk - 1)
+            out.extend(data[s:s + chunk])
+            s += chunk
+
+    while i < n:
+        run = 1
+        while i + run < n and data[i + run] == data[i] and run < 129:
+            run += 1
+        if run >= 3:  # runs of 2 rarely beat literals once control bytes count
+            flush_literals(i)
+            out.append(0x80 | (run - 2))
+            out.append(data[i])
+            i += run
+            lit_start = i
+        else:
+            i += run
+    flush_literals(i)
+    return bytes(out)
+
+
+def encode_frame_v2(bitmap, prev_bitmap):
+    """Encode one frame for the v2 container.  Picks the smallest of
+    keyframe-RLE / delta-RLE, falling back to a raw keyframe when RLE
+    would expand.  Returns (flags, payload)."""
+    candidates = [(0, rle_encode(bitmap))]
+    if prev_bitmap is not None:
+        delta = bytes(a ^ b for a, b in zip(bitmap, prev_bitmap))
+        candidates.append((QGIF2_FLAG_DELTA, rle_encode(delta)))
+    flags, payload = min(candidates, key=lambda c: len(c[1]))
+    if len(payload) >= FRAME_SIZE:
+        return QGIF2_FLAG_RAW, bitmap
+    return flags, payload
+
+
 def convert_gif(input_path, output_path=None, threshold=128,
-                invert=False, scale="fit"):
+                invert=False, scale="fit", v2=False):
     """Convert a GIF file to .qgif binary.  Returns True on success."""
     input_path = Path(input_path)
     if output_path is None:
@@ -137,17 +200,33 @@ def convert_gif(input_path, output_path=None, threshold=128,
 
     # --- Write .qgif binary ---
     with open(output_path, "wb") as f:
-        f.write(struct.pack("<B", frame_count))
-        f.write(struct.pack("<H", DISPLAY_WIDTH))
-        f.write(struct.pack("<H", DISPLAY_HEIGHT))
-        for d in delays:
-            f.write(struct.pack("<H", d))
-        for bitmap in frames:
-            f.write(bitmap)
-
-    total_kb = (5 + frame_count * 2 + frame_count * FRAME_SIZE) / 1024
+        if v2:
+            f.write(b"Q2")
+            f.write(struct.pack("<B", frame_count))
+            f.write(struct.pack("<H", DISPLAY_WIDTH))
+            f.write(struct.pack("<H", DISPLAY_HEIGHT))
+            for d in delays:
+                f.write(struct.pack("<H", d))
+            prev = None
+            for bitmap in frames:
+                flags, payload = encode_frame_v2(bitmap, prev)
+                f.write(struct.pack("<BH", flags, len(payload)))
+                f.write(payload)
+                prev = bitmap
+        else:
+            f.write(struct.pack("<B", frame_count))
+            f.write(struct.pack("<H", DISPLAY_WIDTH))
+            f.write(struct.pack("<H", DISPLAY_HEIGHT))
+            for d in delays:
+                f.write(struct.pack("<H", d))
+            for bitmap in frames:
+                f.write(bitmap)
+
+    raw_kb   = (5 + frame_count * 2 + frame_count * FRAME_SIZE) / 1024
+    total_kb = output_path.stat().st_size / 1024
+    ratio    = f", {raw_kb / total_kb:.1f}x" if v2 and total_kb > 0 else ""
     print(f"  {input_path.name}  ->  {output_path.name}  "
-          f"({frame_count} frames, {total_kb:.1f} KB)")
+          f"({frame_count} frames, {total_kb:.1f} KB{ratio})")
     return True
 
 
@@ -166,6 +245,9 @@ def main():
                         choices=["fit", "stretch", "fit_width", "fit_height"],
                         default="fit",
                         help="Scale mode (default: fit)")
+    parser.add_argument("--v2", action="store_true",
+                        help="Write compressed v2 container "
+                             "(XOR-delta + RLE frames)")
     args = parser.parse_args()
 
     # Collect input files
@@ -189,7 +271,8 @@ def main():
 
     print(f"Converting {len(files)} file(s)...\n")
     ok = sum(
-        convert_gif(f, args.output, args.threshold, args.invert, args.scale)
+        convert_gif(f, args.output, args.threshold, args.invert, args.scale,
+                    args.v2)
         for f in files
     )
     print(f"\nDone: {ok}/{len(files)} converted successfully.")
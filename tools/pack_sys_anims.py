@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""
+Pack system animations (plain v1 .qgif files) into a flash image for the
+'anim' data partition (see firmware/partitions.csv).
+
+Image layout:
+  [0..3]   magic 'QANM'
+  [4]      version (1)
+  [5]      entry count
+  then per entry (24 bytes):
+  [0..15]  name, NUL-padded
+  [16..19] uint32 blob offset from partition start (LE)
+  [20..23] uint32 blob length (LE)
+  followed by the concatenated .qgif blobs.
+
+The device memory-maps the partition and plays frames in place, so blobs
+must be uncompressed v1 .qgif (gif2qbit.py without --v2).
+
+Usage: python3 pack_sys_anims.py <out.bin> <name=file.qgif> [...]
+Example:
+  python3 pack_sys_anims.py anim.bin boot=sys_scx.qgif idle=sys_idle.qgif
+  esptool.py write_flash 0x2F0000 anim.bin
+"""
+
+import struct
+import sys
+
+MAGIC = b"QANM"
+VERSION = 1
+NAME_LEN = 16
+ENTRY_SIZE = NAME_LEN + 8
+PARTITION_SIZE = 0x60000  # keep in sync with firmware/partitions.csv
+
+
+def validate_qgif(name, path, data):
+    if len(data) >= 2 and data[0:2] == b"Q2":
+        print(f"Error: {path} is a compressed v2 .qgif; the device maps frames "
+              "in place and needs plain v1 (gif2qbit.py without --v2)")
+        sys.exit(1)
+    if len(data) < 5:
+        print(f"Error: {path} is too short to be a .qgif")
+        sys.exit(1)
+    frame_count = data[0]
+    width = struct.unpack_from("<H", data, 1)[0]
+    height = struct.unpack_from("<H", data, 3)[0]
+    expected = 5 + frame_count * 2 + frame_count * (width // 8) * height
+    if frame_count == 0 or width != 128 or height != 64 or len(data) < expected:
+        print(f"Error: {path} has a bad v1 header "
+              f"(fc={frame_count}, {width}x{height}, {len(data)} bytes)")
+        sys.exit(1)
+    print(f"  {name}: {frame_count} frames, {len(data)} bytes")
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(f"Usage: {sys.argv[0]} <out.bin> <name=file.qgif> [...]")
+        sys.exit(1)
+
+    outfile = sys.argv[1]
+    entries = []
+    for arg in sys.argv[2:]:
+        if "=" not in arg:
+            print(f"Error: expected name=file.qgif, got '{arg}'")
+            sys.exit(1)
+        name, path = arg.split("=", 1)
+        if not name or len(name) > NAME_LEN:
+            print(f"Error: name '{name}' must be 1..{NAME_LEN} chars")
+            sys.exit(1)
+        with open(path, "rb") as f:
+            data = f.read()
+        validate_qgif(name, path, data)
+        entries.append((name, data))
+
+    offset = 6 + len(entries) * ENTRY_SIZE
+    toc = MAGIC + struct.pack("BB", VERSION, len(entries))
+    blobs = b""
+    for name, data in entries:
+        toc += name.encode("ascii").ljust(NAME_LEN, b"\0")
+        toc += struct.pack("<II", offset, len(data))
+        blobs += data
+        offset += len(data)
+
+    image = toc + blobs
+    if len(image) > PARTITION_SIZE:
+        print(f"Error: image is {len(image)} bytes but the anim partition "
+              f"holds only {PARTITION_SIZE}")
+        sys.exit(1)
+
+    with open(outfile, "wb") as f:
+        f.write(image)
+    print(f"Wrote {outfile}: {len(entries)} animations, {len(image)} bytes "
+          f"({PARTITION_SIZE - len(image)} free)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""
+QBIT -- Pre-scale weather condition icons to 2x.
+
+Reads the 1x XBM arrays in firmware/src/weather/weather_icons.h (LSB-first,
+height 16) and writes firmware/src/weather/weather_icons_2x.h with each
+condition icon doubled in both axes, so the weather screen draws the big
+left-column icon with a plain u8g2.drawXBM() instead of a per-pixel
+nearest-neighbour loop at render time.
+
+The 1x arrays in weather_icons.h stay the editable source of truth; rerun
+this after touching them:
+
+    python3 tools/scale_weather_icons.py
+
+The humidity drop and AQI face are drawn at 1x and are not scaled.
+"""
+
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC = os.path.join(HERE, "..", "firmware", "src", "weather", "weather_icons.h")
+DST = os.path.join(HERE, "..", "firmware", "src", "weather", "weather_icons_2x.h")
+
+# Condition icons only (name -> width); height is always 16 at 1x.
+ICONS = {
+    "WEATHER_ICON_CLEAR":  15,
+    "WEATHER_ICON_CLOUDS": 17,
+    "WEATHER_ICON_RAIN":   17,
+    "WEATHER_ICON_STORM":  17,
+    "WEATHER_ICON_MIST":   15,
+    "WEATHER_ICON_SNOW":   16,
+}
+
+HEIGHT = 16
+
+ARRAY_RE = r"static const uint8_t %s\[\] PROGMEM = \{(.*?)\};"
+
+
+def parse_bytes(src, name):
+    m = re.search(ARRAY_RE % re.escape(name), src, re.DOTALL)
+    if not m:
+        raise SystemExit(f"array {name} not found in weather_icons.h")
+    return [int(tok, 0) for tok in re.findall(r"0[xX][0-9a-fA-F]+", m.group(1))]
+
+
+def scale2x(data, width):
+    """Double an LSB-first XBM bitmap in both axes."""
+    bpr = (width + 7) // 8
+    width2 = width * 2
+    bpr2 = (width2 + 7) // 8
+    out_rows = []
+    for y in range(HEIGHT):
+        row = [0] * bpr2
+        for px in range(width):
+            if (data[y * bpr + (px >> 3)] >> (px & 7)) & 1:
+                for dx in (px * 2, px * 2 + 1):
+                    row[dx >> 3] |= 1 << (dx & 7)
+        out_rows.append(row)
+        out_rows.append(list(row))  # doubled vertically
+    return out_rows, width2, bpr2
+
+
+def main():
+    src = open(SRC).read()
+
+    lines = []
+    lines.append("// ==========================================================================")
+    lines.append("//  QBIT -- Pre-scaled 2x weather icons (U8G2 XBM format, LSB-first)")
+    lines.append("//")
+    lines.append("//  GENERATED by tools/scale_weather_icons.py from weather_icons.h --")
+    lines.append("//  do not edit by hand; edit the 1x arrays and rerun the tool.")
+    lines.append("//")
+    lines.append("//  Height is always 32. Usage: u8g2.drawXBM(x, y, ico.width, 32, ico.bits)")
+    lines.append("// ==========================================================================")
+    lines.append("#ifndef WEATHER_ICONS_2X_H")
+    lines.append("#define WEATHER_ICONS_2X_H")
+    lines.append("")
+    lines.append('#include "weather_icons.h"')
+    lines.append("")
+
+    widths2 = {}
+    for name, width in ICONS.items():
+        data = parse_bytes(src, name)
+        if len(data) != ((width + 7) // 8) * HEIGHT:
+            raise SystemExit(f"{name}: unexpected byte count {len(data)}")
+        rows, width2, bpr2 = scale2x(data, width)
+        widths2[name] = width2
+        lines.append(f"// {name.split('WEATHER_ICON_')[1].title()} ({width2}×32)")
+        lines.append(f"static const uint8_t {name}_2X[] PROGMEM = {{")
+        for i, row in enumerate(rows):
+            body = ",".join(f"0x{b:02X}" for b in row)
+            lines.append(f"    {body},  // row {i}")
+        lines.append("};")
+        lines.append("")
+
+    lines.append("// --------------------------------------------------------------------------")
+    lines.append("//  Map WMO weather code → 2x icon + width (same mapping as getWeatherIcon)")
+    lines.append("// --------------------------------------------------------------------------")
+    lines.append("inline WeatherIconInfo getWeatherIcon2x(uint8_t wmoCode) {")
+    lines.append(f"    if (wmoCode <= 1)                           return {{ WEATHER_ICON_CLEAR_2X,  {widths2['WEATHER_ICON_CLEAR']} }};")
+    lines.append(f"    if (wmoCode <= 3)                           return {{ WEATHER_ICON_CLOUDS_2X, {widths2['WEATHER_ICON_CLOUDS']} }};")
+    lines.append(f"    if (wmoCode == 45 || wmoCode == 48)         return {{ WEATHER_ICON_MIST_2X,   {widths2['WEATHER_ICON_MIST']} }};")
+    lines.append(f"    if ((wmoCode >= 51 && wmoCode <= 67) ||")
+    lines.append(f"        (wmoCode >= 80 && wmoCode <= 82))       return {{ WEATHER_ICON_RAIN_2X,   {widths2['WEATHER_ICON_RAIN']} }};")
+    lines.append(f"    if ((wmoCode >= 71 && wmoCode <= 77) ||")
+    lines.append(f"        wmoCode == 85 || wmoCode == 86)         return {{ WEATHER_ICON_SNOW_2X,   {widths2['WEATHER_ICON_SNOW']} }};")
+    lines.append(f"    if (wmoCode == 95 || wmoCode == 96 ||")
+    lines.append(f"        wmoCode == 99)                          return {{ WEATHER_ICON_STORM_2X,  {widths2['WEATHER_ICON_STORM']} }};")
+    lines.append(f"    return {{ WEATHER_ICON_CLOUDS_2X, {widths2['WEATHER_ICON_CLOUDS']} }};")
+    lines.append("}")
+    lines.append("")
+    lines.append("#endif // WEATHER_ICONS_2X_H")
+    lines.append("")
+
+    with open(DST, "w") as f:
+        f.write("\n".join(lines))
+    print(f"wrote {os.path.relpath(DST, os.path.join(HERE, '..'))}")
+
+
+if __name__ == "__main__":
+    sys.exit(main())
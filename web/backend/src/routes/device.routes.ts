@@ -35,11 +35,15 @@ router.post('/poke', requireNotBanned, validate(pokeSchema), (req, res) => {
   const { targetId, text, senderBitmap, senderBitmapWidth, textBitmap, textBitmapWidth } = req.body;
 
   const device = deviceService.getDeviceByPokeToken(targetId);
-  if (!device) {
+  // A device mid-reconnect keeps a short grace window; its poke gets buffered
+  // and replayed when the same session re-registers instead of bouncing.
+  const graceDeviceId = device ? undefined : deviceService.getGraceDeviceId(targetId);
+  if (!device && !graceDeviceId) {
     return res.status(404).json({ error: 'Device not found or offline' });
   }
+  const targetDeviceId = device ? device.id : graceDeviceId!;
 
-  const claim = claimService.getClaimByDevice(device.id);
+  const claim = claimService.getClaimByDevice(targetDeviceId);
   if (claim && friendService.getOnlyFriendsCanPoke(claim.userId)) {
     if (!friendService.areFriends(claim.userId, user.id)) {
       return res.status(403).json({ error: 'Only friends can poke this QBIT' });
@@ -61,11 +65,15 @@ router.post('/poke', requireNotBanned, validate(pokeSchema), (req, res) => {
     pokePayload.textBitmapWidth = textBitmapWidth;
   }
 
-  device.ws.send(JSON.stringify(pokePayload));
+  if (device) {
+    deviceService.sendPokePayload(device, pokePayload);
+  } else {
+    deviceService.queuePokeForOffline(targetId, pokePayload);
+  }
   const io = socketService.getIo();
   if (io) io.emit('poke:highlight', { deviceToken: targetId });
-  logger.info({ sender: user.displayName, target: device.name }, 'Poke sent');
-  res.json({ ok: true });
+  logger.info({ sender: user.displayName, target: device ? device.name : targetDeviceId, queued: !device }, 'Poke sent');
+  res.json({ ok: true, queued: !device });
 });
 
 // POST /api/poke/user -- poke another web user (target by publicUserId)
@@ -34,6 +34,35 @@ const devices = new Map<string, DeviceState>();
 const pendingClaims = new Map<string, PendingClaim>();
 const pendingFriendRequests = new Map<string, PendingFriendRequest>();
 
+// Reconnect grace: a device whose socket drops keeps a replay slot for a
+// short window. Pokes sent while it is away are buffered (bounded) and
+// flushed when the device re-registers with the same per-boot session token;
+// a fresh boot presents a new token, so nothing stale is replayed.
+const REPLAY_GRACE_MS = 60 * 1000;
+const REPLAY_MAX_PENDING = 5;
+
+interface ReplaySlot {
+  deviceId: string;
+  session: string;
+  pokeToken: string;
+  pending: Record<string, unknown>[];
+  expiresAt: number;
+}
+
+const replaySlots = new Map<string, ReplaySlot>(); // keyed by deviceId
+
+function replaySlotByPokeToken(token: string): ReplaySlot | undefined {
+  const now = Date.now();
+  for (const [id, slot] of replaySlots) {
+    if (slot.expiresAt <= now) {
+      replaySlots.delete(id);
+      continue;
+    }
+    if (slot.pokeToken === token) return slot;
+  }
+  return undefined;
+}
+
 // Throttle ban-rejection log to avoid log flood
 const bannedDeviceLogLast = new Map<string, number>();
 const BANNED_LOG_INTERVAL_MS = 5 * 60 * 1000;
@@ -133,13 +162,68 @@ export function broadcastDevices(): void {
   broadcastCallback?.();
 }
 
+// ---------------------------------------------------------------------------
+//  Binary poke frames (firmware binProto >= 1)
+// ---------------------------------------------------------------------------
+// Layout matches wsHandleBinary() in the firmware's network_task.cpp:
+//   [0] type, [1] senderLen, [2] textLen, [3] titleLen,
+//   [4..5] senderBmpWidth LE, [6..7] senderBmpLen LE,
+//   [8..9] textBmpWidth LE, [10..11] textBmpLen LE,
+//   then sender / text / title / senderBmp / textBmp packed in order.
+// Bitmap bytes travel raw, so the device skips the base64 decode step.
+
+const BIN_POKE = 1;
+const BIN_BROADCAST = 2;
+
+/** Encode a poke/broadcast payload as a binary frame, or null when the
+ *  payload carries no bitmaps (text-only pokes stay JSON -- they are tiny). */
+export function encodeBinaryPoke(payload: Record<string, unknown>): Buffer | null {
+  const senderBmp64 = payload.senderBitmap as string | undefined;
+  const textBmp64 = payload.textBitmap as string | undefined;
+  const senderW = payload.senderBitmapWidth as number | undefined;
+  const textW = payload.textBitmapWidth as number | undefined;
+  if (!senderBmp64 || !textBmp64 || !senderW || !textW) return null;
+
+  const sender = Buffer.from(String(payload.sender ?? ''), 'utf8').subarray(0, 32);
+  const text = Buffer.from(String(payload.text ?? ''), 'utf8').subarray(0, 64);
+  const title = Buffer.from(String(payload.title ?? ''), 'utf8').subarray(0, 20);
+  const sBmp = Buffer.from(senderBmp64, 'base64');
+  const tBmp = Buffer.from(textBmp64, 'base64');
+  if (sBmp.length === 0 || tBmp.length === 0 || sBmp.length > 0xffff || tBmp.length > 0xffff) {
+    return null;
+  }
+
+  const hdr = Buffer.alloc(12);
+  hdr[0] = payload.type === 'broadcast' ? BIN_BROADCAST : BIN_POKE;
+  hdr[1] = sender.length;
+  hdr[2] = text.length;
+  hdr[3] = title.length;
+  hdr.writeUInt16LE(senderW, 4);
+  hdr.writeUInt16LE(sBmp.length, 6);
+  hdr.writeUInt16LE(textW, 8);
+  hdr.writeUInt16LE(tBmp.length, 10);
+  return Buffer.concat([hdr, sender, text, title, sBmp, tBmp]);
+}
+
+/** Send a poke/broadcast payload to one device, using the binary frame when
+ *  the device negotiated binProto at register time, JSON otherwise. */
+export function sendPokePayload(dev: DeviceState, payload: Record<string, unknown>): void {
+  if ((dev.binProto ?? 0) >= 1) {
+    const bin = encodeBinaryPoke(payload);
+    if (bin) {
+      dev.ws.send(bin);
+      return;
+    }
+  }
+  dev.ws.send(JSON.stringify(payload));
+}
+
 /** Send a JSON payload to all connected QBIT devices (e.g. broadcast message like poke). */
 export function broadcastToAllDevices(payload: Record<string, unknown>): void {
-  const data = JSON.stringify(payload);
   for (const [, dev] of devices) {
     if (dev.ws.readyState === 1) {
       try {
-        dev.ws.send(data);
+        sendPokePayload(dev, payload);
       } catch {
         // ignore per-device send errors
       }
@@ -166,6 +250,24 @@ export function getDeviceByPokeToken(token: string): DeviceState | undefined {
   return undefined;
 }
 
+/** Device id behind a poke token whose socket is inside its reconnect grace
+ *  window, or undefined when the token maps to nothing recent. */
+export function getGraceDeviceId(token: string): string | undefined {
+  return replaySlotByPokeToken(token)?.deviceId;
+}
+
+/** Buffer a poke for a device in its grace window; oldest entries are dropped
+ *  beyond REPLAY_MAX_PENDING. Returns false when no slot exists. */
+export function queuePokeForOffline(token: string, payload: Record<string, unknown>): boolean {
+  const slot = replaySlotByPokeToken(token);
+  if (!slot) return false;
+  if (slot.pending.length >= REPLAY_MAX_PENDING) {
+    slot.pending.shift();
+  }
+  slot.pending.push(payload);
+  return true;
+}
+
 export function disconnectDevice(deviceId: string): void {
   const dev = devices.get(deviceId);
   if (dev) {
@@ -362,7 +464,10 @@ export function setupWebSocketServer(httpServer: HttpServer): WebSocketServer {
           const name = msg.name || msg.id;
           const version = msg.version || '1.0.0';
           const ip = msg.ip || '';
-          devices.set(msg.id, {
+          const session = typeof msg.session === 'string' ? msg.session : undefined;
+          const slot = replaySlots.get(msg.id);
+          if (slot) replaySlots.delete(msg.id);
+          const dev: DeviceState = {
             id: msg.id,
             name,
             ip,
@@ -370,13 +475,28 @@ export function setupWebSocketServer(httpServer: HttpServer): WebSocketServer {
             version,
             ws,
             connectedAt,
-            pokeToken: existing?.pokeToken ?? crypto.randomBytes(12).toString('hex'),
-          });
+            // Keep the poke token stable across a brief disconnect too, so
+            // dashboard poke links held open during the gap stay valid.
+            pokeToken: existing?.pokeToken ?? slot?.pokeToken ?? crypto.randomBytes(12).toString('hex'),
+            binProto: typeof msg.binProto === 'number' ? msg.binProto : 0,
+            session,
+          };
+          devices.set(msg.id, dev);
           const lastSeen = connectedAt.toISOString();
           stmtRecordUpsert.run(msg.id, name, ip, publicIp, version, lastSeen, 'online');
 
           broadcastDevices();
           logger.info({ deviceId: msg.id, name: msg.name, localIp: msg.ip, publicIp }, 'Device online');
+
+          // Same session back within the grace window: flush buffered pokes.
+          if (slot && session && slot.session === session && slot.expiresAt > Date.now()) {
+            for (const payload of slot.pending) {
+              sendPokePayload(dev, payload);
+            }
+            if (slot.pending.length > 0) {
+              logger.info({ deviceId: msg.id, count: slot.pending.length }, 'Replayed pokes buffered during disconnect');
+            }
+          }
         }
 
         // Handle claim confirmation from device
@@ -456,6 +576,15 @@ export function setupWebSocketServer(httpServer: HttpServer): WebSocketServer {
         if (registered && registered.ws === ws) {
           const now = new Date().toISOString();
           stmtRecordUpdateOffline.run('offline', now, deviceId);
+          if (registered.session) {
+            replaySlots.set(deviceId, {
+              deviceId,
+              session: registered.session,
+              pokeToken: registered.pokeToken,
+              pending: [],
+              expiresAt: Date.now() + REPLAY_GRACE_MS,
+            });
+          }
           devices.delete(deviceId);
           broadcastDevices();
           logger.info({ deviceId }, 'Device offline');
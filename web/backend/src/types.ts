@@ -22,6 +22,10 @@ export interface DeviceState {
   ws: WebSocket;
   connectedAt: Date;
   pokeToken: string;
+  /** Binary poke protocol version advertised in device.register (0 = JSON only). */
+  binProto?: number;
+  /** Per-boot resume token from device.register; enables poke replay after a brief disconnect. */
+  session?: string;
 }
 
 // ---- Claims ----